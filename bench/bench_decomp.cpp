@@ -0,0 +1,472 @@
+// Benchmarks the phases of the decomposition pipeline on generated polygon families.
+// For each family and size, it reports the wall time of removeHoles, the triangulation,
+// hertelMehlhorn and the full decompose call, the number of polygons, the throughput in vertices
+// per second, and the scaling exponent relative to the previous size of the same family.
+// With --triangulator monotone or delaunay, the triangulation is monotoneTriangulation or
+// constrainedDelaunay, which take the holes directly, so removeHoles is not measured.
+// With --tier, every phase runs the way decompose does in the given tier, and the
+// hertelMehlhorn column includes the edgeFlip pass unless the tier skips it.
+//
+// ./bench_decomp [--family star|spiral|comb|holes|coastline] [--min N] [--max N] [--repeat K]
+//                [--triangulator ear|monotone|delaunay] [--tier fast|balanced|quality] [--csv]
+
+#include <decomp/convex_decomposition.hpp>
+#include <decomp/delaunay.hpp>
+#include <decomp/monotone.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace decomp;
+
+namespace
+{
+
+double const pi = 3.14159265358979323846;
+
+// Generated with 32-bit indices, and narrowed to 16 bits by run if all points fit
+template <class Index> struct BasicWorkload
+{
+    PointList pointList;
+    BasicIndexList<Index> outer;
+    std::vector<BasicIndexList<Index>> holes;
+};
+
+using Workload = BasicWorkload<std::uint32_t>;
+
+struct Family
+{
+    char const* name;
+    std::function<Workload(int)> generate;
+};
+
+// Deterministic pseudo-random numbers in [0, 1), so runs are comparable
+class Random
+{
+public:
+    explicit Random(std::uint32_t seed)
+    : mState(seed)
+    {
+    }
+
+    double next()
+    {
+        mState = mState * 1664525u + 1013904223u;
+        return (mState >> 8) / double(1u << 24);
+    }
+
+private:
+    std::uint32_t mState;
+};
+
+IndexList32 appendRing(PointList& pointList, PointList const& ring)
+{
+    IndexList32 indices;
+    for (auto const& point : ring)
+    {
+        indices.push_back(static_cast<std::uint32_t>(pointList.size()));
+        pointList.push_back(point);
+    }
+    return indices;
+}
+
+// Star polygon with alternating inner and outer radius
+Workload makeStar(int size)
+{
+    int const N = std::max(size & ~1, 6);
+    PointList ring;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 2.0 * pi * i / N;
+        double radius = (i % 2 == 0) ? 100.0 : 60.0;
+        ring.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    Workload result;
+    result.outer = appendRing(result.pointList, ring);
+    return result;
+}
+
+// Thick archimedean spiral: the outer side winds outwards, the inner side back in
+Workload makeSpiral(int size)
+{
+    int const samples = std::max(size / 2, 8);
+    double const turns = 8.0;
+    double const width = 3.0;
+
+    PointList outerSide, innerSide;
+    for (int i = 0; i < samples; ++i)
+    {
+        double theta = 2.0 * pi * turns * i / (samples - 1);
+        double radius = 5.0 + theta;
+        Point direction(std::cos(theta), std::sin(theta));
+        outerSide.emplace_back((radius + width * 0.5) * direction.x(), (radius + width * 0.5) * direction.y());
+        innerSide.emplace_back((radius - width * 0.5) * direction.x(), (radius - width * 0.5) * direction.y());
+    }
+
+    PointList ring(outerSide);
+    ring.insert(ring.end(), innerSide.rbegin(), innerSide.rend());
+
+    Workload result;
+    result.outer = appendRing(result.pointList, ring);
+    return result;
+}
+
+// A base bar with many long, thin teeth
+Workload makeComb(int size)
+{
+    int const teeth = std::max(size / 4, 2);
+    double const length = 50.0;
+    int const right = 2 * teeth - 1;
+
+    PointList ring = { { 0.0, 0.0 }, { double(right), 0.0 } };
+    for (int i = teeth - 1; i >= 0; --i)
+    {
+        ring.emplace_back(2.0 * i + 1.0, length);
+        ring.emplace_back(2.0 * i, length);
+        if (i > 0)
+        {
+            ring.emplace_back(2.0 * i, 1.0);
+            ring.emplace_back(2.0 * i - 1.0, 1.0);
+        }
+    }
+
+    Workload result;
+    result.outer = appendRing(result.pointList, ring);
+    return result;
+}
+
+// Subdivided square with a grid of small clockwise diamond holes
+Workload makeHoles(int size)
+{
+    int const holeCount = std::max(size / 8, 1);
+    int const perSide = std::max(size / 8, 1);
+    int const columns = static_cast<int>(std::ceil(std::sqrt(double(holeCount))));
+    double const extent = 10.0 * columns;
+
+    PointList ring;
+    for (int side = 0; side < 4; ++side)
+    {
+        for (int i = 0; i < perSide; ++i)
+        {
+            double t = extent * i / perSide;
+            switch (side)
+            {
+            case 0:
+                ring.emplace_back(t, 0.0);
+                break;
+            case 1:
+                ring.emplace_back(extent, t);
+                break;
+            case 2:
+                ring.emplace_back(extent - t, extent);
+                break;
+            default:
+                ring.emplace_back(0.0, extent - t);
+                break;
+            }
+        }
+    }
+
+    Workload result;
+    result.outer = appendRing(result.pointList, ring);
+
+    Random random(holeCount);
+    for (int i = 0; i < holeCount; ++i)
+    {
+        double cx = 10.0 * (i % columns) + 5.0 + random.next() - 0.5;
+        double cy = 10.0 * (i / columns) + 5.0 + random.next() - 0.5;
+        PointList hole = { { cx, cy + 2.0 }, { cx + 2.0, cy }, { cx, cy - 2.0 }, { cx - 2.0, cy } };
+        result.holes.push_back(appendRing(result.pointList, hole));
+    }
+    return result;
+}
+
+// Long chain of almost collinear points closed by a gently curved backside
+Workload makeCoastline(int size)
+{
+    int const half = std::max(size / 2, 4);
+    Random random(half);
+
+    PointList ring;
+    for (int i = 0; i < half; ++i)
+        ring.emplace_back(double(i), 1e-7 * random.next());
+    for (int i = half - 1; i >= 0; --i)
+        ring.emplace_back(double(i), 20.0 + 2.0 * std::sin(double(i) * 0.05));
+
+    Workload result;
+    result.outer = appendRing(result.pointList, ring);
+    return result;
+}
+
+std::vector<Family> const& families()
+{
+    static std::vector<Family> const list = {
+        { "star", makeStar }, { "spiral", makeSpiral }, { "comb", makeComb },
+        { "holes", makeHoles }, { "coastline", makeCoastline },
+    };
+    return list;
+}
+
+template <class F> double measureSeconds(int repeat, F f)
+{
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < repeat; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+    return best;
+}
+
+struct Options
+{
+    std::string family;
+    int minSize = 256;
+    int maxSize = 4096;
+    int repeat = 3;
+    DecomposeOptions decomposeOptions;
+    bool csv = false;
+};
+
+struct Measurement
+{
+    std::size_t vertexCount;
+    std::size_t holeCount;
+    double removeHoles;
+    double triangulate;
+    double hertelMehlhorn;
+    double decompose;
+    std::size_t polygonCount;
+};
+
+template <class Index>
+Measurement run(BasicWorkload<Index> const& workload, int repeat, DecomposeOptions const& options)
+{
+    Measurement result;
+    result.vertexCount = workload.pointList.size();
+    result.holeCount = workload.holes.size();
+
+    BasicIndexList<Index> triangleList;
+    switch (options.triangulator)
+    {
+    case Triangulator::EarClipping:
+    {
+        BasicIndexList<Index> simple;
+        result.removeHoles = measureSeconds(
+            repeat, [&] { simple = removeHoles(workload.pointList, workload.outer, workload.holes); });
+        result.triangulate = measureSeconds(repeat, [&] {
+            earClipping(workload.pointList, simple, triangleList, newDeleteResource());
+        });
+        break;
+    }
+    case Triangulator::Monotone:
+        result.removeHoles = 0.0;
+        result.triangulate = measureSeconds(
+            repeat, [&] { triangleList = monotoneTriangulation(workload.pointList, workload.outer, workload.holes); });
+        break;
+    case Triangulator::ConstrainedDelaunay:
+        result.removeHoles = 0.0;
+        result.triangulate = measureSeconds(
+            repeat, [&] { triangleList = constrainedDelaunay(workload.pointList, workload.outer, workload.holes); });
+        break;
+    }
+
+    std::size_t polygonCount = 0;
+    result.hertelMehlhorn = measureSeconds(repeat, [&] {
+        auto mesh = buildHalfEdgeGraph(triangleList, {});
+        if (options.triangulator != Triangulator::ConstrainedDelaunay && options.tier != Tier::Fast)
+            edgeFlip(workload.pointList, mesh);
+
+        std::vector<BasicIndexList<Index>> polygonList;
+        hertelMehlhorn(workload.pointList, mesh, polygonList, newDeleteResource(), mergeOrder(options.tier));
+        polygonCount = polygonList.size();
+    });
+
+    result.decompose = measureSeconds(repeat, [&] {
+        polygonCount = decompose(workload.pointList, workload.outer, workload.holes, {}, options).size();
+    });
+
+    if (polygonCount == 0)
+        throw std::runtime_error("Decomposition produced no polygons");
+
+    result.polygonCount = polygonCount;
+    return result;
+}
+
+IndexList narrow(IndexList32 const& indices)
+{
+    return IndexList(indices.begin(), indices.end());
+}
+
+// Sizes beyond what 16-bit indices can address run with 32-bit indices
+Measurement run(Workload const& workload, int repeat, DecomposeOptions const& options)
+{
+    if (workload.pointList.size() > std::numeric_limits<std::uint16_t>::max())
+        return run<std::uint32_t>(workload, repeat, options);
+
+    BasicWorkload<std::uint16_t> narrowed;
+    narrowed.pointList = workload.pointList;
+    narrowed.outer = narrow(workload.outer);
+    for (auto const& hole : workload.holes)
+        narrowed.holes.push_back(narrow(hole));
+    return run(narrowed, repeat, options);
+}
+
+void printHeader(Options const& options)
+{
+    if (options.csv)
+    {
+        std::cout << "family,vertices,holes,remove_holes_ms,triangulate_ms,hertel_mehlhorn_ms,decompose_ms,"
+                     "polygons,vertices_per_second,scaling_exponent\n";
+        return;
+    }
+
+    std::cout << std::left << std::setw(10) << "family" << std::right << std::setw(8) << "N" << std::setw(7)
+              << "holes" << std::setw(13) << "removeHoles" << std::setw(13) << "triangulate" << std::setw(13)
+              << "hertelM." << std::setw(13) << "decompose" << std::setw(9) << "polygons" << std::setw(13)
+              << "vertices/s" << std::setw(9) << "scaling" << "\n";
+}
+
+void printRow(Options const& options, char const* family, Measurement const& m, double exponent)
+{
+    double const verticesPerSecond = m.vertexCount / m.decompose;
+    if (options.csv)
+    {
+        std::cout << family << "," << m.vertexCount << "," << m.holeCount << "," << m.removeHoles * 1e3 << ","
+                  << m.triangulate * 1e3 << "," << m.hertelMehlhorn * 1e3 << "," << m.decompose * 1e3 << ","
+                  << m.polygonCount << "," << verticesPerSecond << ",";
+        if (!std::isnan(exponent))
+            std::cout << exponent;
+        std::cout << "\n";
+        return;
+    }
+
+    std::cout << std::left << std::setw(10) << family << std::right << std::setw(8) << m.vertexCount
+              << std::setw(7) << m.holeCount << std::fixed << std::setprecision(3) << std::setw(13)
+              << m.removeHoles * 1e3 << std::setw(13) << m.triangulate * 1e3 << std::setw(13)
+              << m.hertelMehlhorn * 1e3 << std::setw(13) << m.decompose * 1e3 << std::setw(9) << m.polygonCount
+              << std::setprecision(0) << std::setw(13) << verticesPerSecond << std::setprecision(2) << std::setw(9);
+    if (std::isnan(exponent))
+        std::cout << "-";
+    else
+        std::cout << exponent;
+    std::cout << std::defaultfloat << "\n";
+}
+
+int parseInt(char const* text)
+{
+    return static_cast<int>(std::strtol(text, nullptr, 10));
+}
+
+[[noreturn]] void exitWithUsage(char const* program)
+{
+    std::cerr << "usage: " << program
+              << " [--family star|spiral|comb|holes|coastline] [--min N] [--max N] [--repeat K]"
+                 " [--triangulator ear|monotone|delaunay] [--tier fast|balanced|quality] [--csv]\n";
+    std::exit(EXIT_FAILURE);
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+        if (!std::strcmp(argv[i], "--family") && hasValue)
+        {
+            options.family = argv[++i];
+            auto const& list = families();
+            auto isKnown = [&](Family const& family) { return options.family == family.name; };
+            if (std::none_of(list.begin(), list.end(), isKnown))
+                exitWithUsage(argv[0]);
+        }
+        else if (!std::strcmp(argv[i], "--min") && hasValue)
+            options.minSize = parseInt(argv[++i]);
+        else if (!std::strcmp(argv[i], "--max") && hasValue)
+            options.maxSize = parseInt(argv[++i]);
+        else if (!std::strcmp(argv[i], "--repeat") && hasValue)
+            options.repeat = parseInt(argv[++i]);
+        else if (!std::strcmp(argv[i], "--triangulator") && hasValue)
+        {
+            std::string name = argv[++i];
+            if (name == "ear")
+                options.decomposeOptions.triangulator = Triangulator::EarClipping;
+            else if (name == "monotone")
+                options.decomposeOptions.triangulator = Triangulator::Monotone;
+            else if (name == "delaunay")
+                options.decomposeOptions.triangulator = Triangulator::ConstrainedDelaunay;
+            else
+                exitWithUsage(argv[0]);
+        }
+        else if (!std::strcmp(argv[i], "--tier") && hasValue)
+        {
+            std::string name = argv[++i];
+            if (name == "fast")
+                options.decomposeOptions.tier = Tier::Fast;
+            else if (name == "balanced")
+                options.decomposeOptions.tier = Tier::Balanced;
+            else if (name == "quality")
+                options.decomposeOptions.tier = Tier::Quality;
+            else
+                exitWithUsage(argv[0]);
+        }
+        else if (!std::strcmp(argv[i], "--csv"))
+            options.csv = true;
+        else
+            exitWithUsage(argv[0]);
+    }
+
+    options.maxSize = std::max(options.maxSize, 8);
+    options.minSize = std::min(std::max(options.minSize, 8), options.maxSize);
+    options.repeat = std::max(options.repeat, 1);
+    return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    auto options = parseOptions(argc, argv);
+    printHeader(options);
+
+    for (auto const& family : families())
+    {
+        if (!options.family.empty() && options.family != family.name)
+            continue;
+
+        double previousSize = 0.0, previousTime = 0.0;
+        for (int size = options.minSize;; size = std::min(size * 2, options.maxSize))
+        {
+            auto measurement = run(family.generate(size), options.repeat, options.decomposeOptions);
+
+            double exponent = std::numeric_limits<double>::quiet_NaN();
+            if (previousSize > 0.0)
+                exponent = std::log(measurement.decompose / previousTime) /
+                           std::log(measurement.vertexCount / previousSize);
+
+            printRow(options, family.name, measurement, exponent);
+
+            previousSize = double(measurement.vertexCount);
+            previousTime = measurement.decompose;
+
+            if (size >= options.maxSize)
+                break;
+        }
+    }
+
+    return 0;
+}
@@ -17,7 +17,7 @@ class DecompConan(ConanFile):
     default_options = {
         "shared": False,
         "fPIC": True}
-    exports_sources = "source/*", "test/*", "demo/*", "include/*", "CMakeLists.txt",
+    exports_sources = "source/*", "test/*", "demo/*", "bench/*", "include/*", "CMakeLists.txt",
     test_requires = "catch2/2.13.10",
 
     def config_options(self):
@@ -54,3 +54,5 @@ class DecompConan(ConanFile):
 
     def package_info(self):
         self.cpp_info.libs = ["decomp"]
+        if self.settings.os in ("Linux", "FreeBSD"):
+            self.cpp_info.system_libs = ["pthread"]
@@ -0,0 +1,176 @@
+#include "batch.hpp"
+#include "decomposer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+using namespace decomp;
+
+namespace
+{
+
+// The triangulation dominates. Ear clipping grows roughly quadratically with the vertex count,
+// while the sweep-line triangulators usually grow with n log n.
+template <class Index> double estimateCost(BasicDecompositionJob<Index> const& job)
+{
+    auto vertexCount = static_cast<double>(job.simplePolygon.size());
+    for (auto const& hole : job.holeList)
+        vertexCount += hole.size() + 2;
+
+    if (job.options.triangulator == Triangulator::EarClipping)
+        return vertexCount * vertexCount;
+    return vertexCount * std::log2(vertexCount + 1.0);
+}
+
+// Job indices of one worker. The owner takes from the front, thieves take from the back.
+class WorkQueue
+{
+public:
+    void push(std::size_t job)
+    {
+        mJobList.push_back(job);
+    }
+
+    bool pop(std::size_t& job)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mJobList.empty())
+            return false;
+
+        job = mJobList.front();
+        mJobList.pop_front();
+        return true;
+    }
+
+    bool steal(std::size_t& job)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (mJobList.empty())
+            return false;
+
+        job = mJobList.back();
+        mJobList.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mMutex;
+    std::deque<std::size_t> mJobList;
+};
+
+template <class Index> class BatchRunner
+{
+public:
+    using Job = BasicDecompositionJob<Index>;
+    using Result = std::vector<BasicIndexList<Index>>;
+
+    BatchRunner(std::vector<Job> const& jobList, std::size_t workerCount)
+    : mJobList(jobList)
+    , mQueueList(workerCount)
+    , mResultList(jobList.size())
+    , mErrorList(jobList.size())
+    {
+        // Deal the jobs out round robin, most expensive first, so every worker starts with a similar load
+        std::vector<std::pair<double, std::size_t>> order;
+        order.reserve(jobList.size());
+        for (std::size_t i = 0; i < jobList.size(); ++i)
+            order.emplace_back(-estimateCost(jobList[i]), i);
+        std::sort(order.begin(), order.end());
+
+        for (std::size_t i = 0; i < order.size(); ++i)
+            mQueueList[i % workerCount].push(order[i].second);
+    }
+
+    void run(std::size_t worker)
+    {
+        BasicDecomposer<Index> decomposer;
+        std::size_t job;
+        while (next(worker, job))
+        {
+            auto const& each = mJobList[job];
+            try
+            {
+                decomposer.decompose(*each.pointList, each.simplePolygon, each.holeList, each.fixedEdges,
+                                     mResultList[job], each.options);
+            }
+            catch (...)
+            {
+                mErrorList[job] = std::current_exception();
+            }
+        }
+    }
+
+    std::vector<Result> finish()
+    {
+        for (auto const& error : mErrorList)
+        {
+            if (error)
+                std::rethrow_exception(error);
+        }
+        return std::move(mResultList);
+    }
+
+private:
+    bool next(std::size_t worker, std::size_t& job)
+    {
+        if (mQueueList[worker].pop(job))
+            return true;
+
+        // Jobs are never added, so once all queues were seen empty, there is nothing left to do
+        auto const N = mQueueList.size();
+        for (std::size_t i = 1; i < N; ++i)
+        {
+            if (mQueueList[(worker + i) % N].steal(job))
+                return true;
+        }
+        return false;
+    }
+
+    std::vector<Job> const& mJobList;
+    std::vector<WorkQueue> mQueueList;
+    std::vector<Result> mResultList;
+    std::vector<std::exception_ptr> mErrorList;
+};
+
+} // namespace
+
+template <class Index>
+std::vector<std::vector<BasicIndexList<Index>>> decomp::decomposeBatch(
+    std::vector<BasicDecompositionJob<Index>> const& jobList, unsigned threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+
+    auto workerCount = std::max<std::size_t>(std::min<std::size_t>(threadCount, jobList.size()), 1);
+    BatchRunner<Index> runner(jobList, workerCount);
+
+    // The calling thread is a worker too. If a thread cannot be started,
+    // its jobs are stolen by the others.
+    std::vector<std::thread> threadList;
+    for (std::size_t worker = 1; worker < workerCount; ++worker)
+    {
+        try
+        {
+            threadList.emplace_back([&runner, worker] { runner.run(worker); });
+        }
+        catch (std::system_error const&)
+        {
+            break;
+        }
+    }
+
+    runner.run(0);
+
+    for (auto& thread : threadList)
+        thread.join();
+
+    return runner.finish();
+}
+
+template std::vector<std::vector<IndexList>> decomp::decomposeBatch(std::vector<DecompositionJob> const&, unsigned);
+template std::vector<std::vector<IndexList32>> decomp::decomposeBatch(std::vector<DecompositionJob32> const&,
+                                                                      unsigned);
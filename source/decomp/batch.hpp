@@ -0,0 +1,39 @@
+#ifndef LIB_DECOMP_BATCH
+#define LIB_DECOMP_BATCH
+
+#include "convex_decomposition.hpp"
+
+namespace decomp
+{
+
+/** Input for one decomposition in a batch. The point list is not owned, so jobs can share it.
+ */
+template <class Index> struct BasicDecompositionJob
+{
+    PointList const* pointList;
+    BasicIndexList<Index> simplePolygon;
+    std::vector<BasicIndexList<Index>> holeList;
+    std::vector<BasicEdgeID<Index>> fixedEdges;
+
+    /** Options the job is decomposed with, so each job can pick its own triangulator and tier.
+     */
+    DecomposeOptions options;
+};
+
+using DecompositionJob = BasicDecompositionJob<std::uint16_t>;
+using DecompositionJob32 = BasicDecompositionJob<std::uint32_t>;
+
+/** Decompose many independent polygons on a pool of threads.
+    Jobs are started in order of their estimated cost, most expensive first, and idle threads steal
+    work from busy ones. Each thread reuses its own Decomposer. The result for each job is stored at
+    its index in the returned list, so it is the same as calling decompose on each job in turn.
+    If jobs throw, the exception of the first failing job in the list is rethrown after all threads finished.
+    A threadCount of 0 uses one thread per hardware thread.
+ */
+template <class Index>
+std::vector<std::vector<BasicIndexList<Index>>> decomposeBatch(std::vector<BasicDecompositionJob<Index>> const& jobList,
+                                                               unsigned threadCount = 0);
+
+} // namespace decomp
+
+#endif
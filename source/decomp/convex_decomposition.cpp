@@ -1,10 +1,11 @@
 #include "convex_decomposition.hpp"
+#include "decomposer.hpp"
+#include "indexed_heap.hpp"
+#include "predicates.hpp"
 #include <algorithm>
 #include <cassert>
-#include <map>
-#include <set>
+#include <limits>
 #include <stdexcept>
-#include <unordered_map>
 #include <utility>
 
 using namespace decomp;
@@ -12,428 +13,1195 @@ using namespace decomp;
 namespace
 {
 
+using EdgeIndex = std::uint32_t;
 
-EdgeID getEdgeID(std::uint16_t a, std::uint16_t b)
+template <class Index> BasicEdgeID<Index> getEdgeID(Index a, Index b)
 {
     return (b < a) ? std::make_pair(b, a) : std::make_pair(a, b);
 }
 
-EdgeID getEdgeID(HalfEdge* edge)
-{
-    return getEdgeID(edge->vertex, edge->next->vertex);
-}
-
+// Removable edges by the smallest angle they would leave, keyed by the representative half-edge
 class EdgePriorityQueue
 {
 public:
-    EdgePriorityQueue() = default;
+    EdgePriorityQueue(std::size_t edgeCount, MemoryResource& resource)
+    : mHeap(edgeCount, resource)
+    {
+    }
 
-    bool empty()
+    bool empty() const
     {
-        return mQueue.empty();
+        return mHeap.empty();
     }
 
-    HalfEdge* extract()
+    EdgeIndex extract()
     {
-        auto edge = mQueue.begin()->second;
-        mQueue.erase(mQueue.begin());
-        mReverse.erase(edge);
-        return edge;
+        return mHeap.pop();
     }
 
-    void insert(HalfEdge* edge, double priority)
+    void insert(EdgeIndex edge, double priority)
     {
-        auto inserted = mReverse.insert({ edge, mQueue.insert({ priority, edge }) });
-        assert(inserted.second);
+        mHeap.push(edge, priority);
     }
 
-    void update(HalfEdge* edge, double priority)
+    void update(EdgeIndex edge, double priority)
     {
-        auto where(mReverse.find(edge));
-        assert(where != mReverse.end());
-        mQueue.erase(where->second);
-        where->second = mQueue.insert({ priority, edge });
+        mHeap.update(edge, priority);
     }
 
-    void erase(HalfEdge* edge)
+    void erase(EdgeIndex edge)
     {
-        auto where(mReverse.find(edge));
-        assert(where != mReverse.end());
-        mQueue.erase(where->second);
-        mReverse.erase(where);
+        mHeap.erase(edge);
     }
 
-    bool contains(HalfEdge* edge) const
+    bool contains(EdgeIndex edge) const
     {
-        return mReverse.find(edge) != mReverse.end();
+        return mHeap.contains(edge);
     }
 
 private:
-    EdgePriorityQueue(EdgePriorityQueue const& rhs) = default;
-
-    using MapType = std::multimap<double, HalfEdge*>;
-    MapType mQueue;
-    std::unordered_map<HalfEdge*, MapType::iterator> mReverse;
+    IndexedHeap<double> mHeap;
 };
 
 // Internal angle is 180deg or smaller
-bool isInternallyConvex(Point const& a, Point const& b, Point const& c)
+template <class P> bool isInternallyConvex(P const& a, P const& b, P const& c)
 {
-    auto left = c - a;
-    auto right = b - a;
-
-    // This is the same as determinant >= 0
-    return right[0] * left[1] >= right[1] * left[0];
+    return orient2d(a, b, c) >= 0;
 }
 
-bool isEdgeRemoveable(PointList const& pointList, decomp::HalfEdge* edge)
+template <class Points, class Index>
+bool isEdgeRemoveable(Points const& pointList, BasicHalfEdgeMesh<Index> const& mesh, EdgeIndex edge)
 {
-    if (edge->fixed)
+    if (mesh[edge].fixed)
         return false;
 
-    if (!edge->partner)
+    auto partner = mesh[edge].partner;
+    if (partner == mesh.none)
         return false;
 
-    // This is the same as determinant >= 0
-    return isInternallyConvex(pointList[edge->vertex], pointList[edge->partner->next->next->vertex],
-                              pointList[edge->next->next->vertex]) &&
-           isInternallyConvex(pointList[edge->partner->vertex], pointList[edge->next->next->vertex],
-                              pointList[edge->partner->next->next->vertex]);
+    auto opposite = mesh[mesh.prev(edge)].vertex;
+    auto partnerOpposite = mesh[mesh.prev(partner)].vertex;
+
+    auto start = exactPoint(pointList, mesh[edge].vertex);
+    auto end = exactPoint(pointList, mesh[partner].vertex);
+    auto oppositePoint = exactPoint(pointList, opposite);
+    auto partnerOppositePoint = exactPoint(pointList, partnerOpposite);
+    return isInternallyConvex(start, partnerOppositePoint, oppositePoint) &&
+           isInternallyConvex(end, oppositePoint, partnerOppositePoint);
+}
+
+// Undirected edge packed into a single integer, smaller vertex in the high half
+template <class Index> inline std::uint64_t getEdgeKey(Index a, Index b)
+{
+    auto id = getEdgeID(a, b);
+    return (std::uint64_t(id.first) << 32) | id.second;
 }
 
-template <class T> inline bool contains(std::set<T> const& c, T const& e)
+// Per half-edge flags, e.g. whether the edge is deleted
+using FlagList = ScratchVector<bool>;
+
+struct KeyedEdge
+{
+    std::uint64_t key;
+    EdgeIndex edge;
+};
+
+// Stable LSD radix sort on the key bytes. Passes where all keys share the same byte
+// are skipped, so small index types only pay for the bytes they actually use.
+void radixSort(ScratchVector<KeyedEdge>& list, ScratchVector<KeyedEdge>& scratch)
 {
-    return c.find(e) != c.end();
+    std::size_t const N = list.size();
+    std::size_t histogram[8][256] = {};
+
+    for (auto const& each : list)
+    {
+        for (int digit = 0; digit < 8; ++digit)
+            ++histogram[digit][(each.key >> (8 * digit)) & 0xff];
+    }
+
+    scratch.resize(N);
+    for (int digit = 0; digit < 8; ++digit)
+    {
+        auto& count = histogram[digit];
+        if (N == 0 || count[(list.front().key >> (8 * digit)) & 0xff] == N)
+            continue;
+
+        std::size_t offset = 0;
+        for (auto& bucket : count)
+        {
+            auto size = bucket;
+            bucket = offset;
+            offset += size;
+        }
+
+        for (auto const& each : list)
+            scratch[count[(each.key >> (8 * digit)) & 0xff]++] = each;
+
+        list.swap(scratch);
+    }
 }
 
-inline HalfEdge* representative(HalfEdge* e)
+template <class Index> inline EdgeIndex representative(BasicHalfEdgeMesh<Index> const& mesh, EdgeIndex e)
 {
-    if (e->partner && e->vertex > e->partner->vertex)
-        return e->partner;
+    auto partner = mesh[e].partner;
+    if (partner != mesh.none && mesh[e].vertex > mesh[partner].vertex)
+        return partner;
     else
         return e;
 }
 
-void flip(HalfEdge* e)
+// Flip the diagonal of the quad formed by the two triangles adjacent to e.
+// Both e and its partner stay in place as the new diagonal, while the other
+// four half-edges move to the slot where they are needed in the new triangles.
+template <class Index> void flip(BasicHalfEdgeMesh<Index>& mesh, EdgeIndex e)
 {
-    auto f = e->partner;
+    auto f = mesh[e].partner;
+
+    EdgeIndex const slot[4] = { mesh.next(e), mesh.prev(e), mesh.next(f), mesh.prev(f) };
+    EdgeIndex const target[4] = { slot[3], slot[0], slot[1], slot[2] };
 
-    auto a = e->next;
-    auto b = a->next;
-    auto c = f->next;
-    auto d = c->next;
+    typename BasicHalfEdgeMesh<Index>::HalfEdge moved[4];
+    for (int i = 0; i < 4; ++i)
+        moved[i] = mesh[slot[i]];
 
-    e->next = b;
-    b->next = c;
-    c->next = e;
-    e->vertex = d->vertex;
+    mesh[e].vertex = moved[3].vertex;
+    mesh[f].vertex = moved[1].vertex;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        auto& edge = mesh[target[i]];
+        edge = moved[i];
 
-    f->next = d;
-    d->next = a;
-    a->next = f;
-    f->vertex = b->vertex;
+        if (edge.partner == mesh.none)
+            continue;
+
+        // Partners can also be among the moved half-edges in degenerate meshes
+        auto where = std::find(slot, slot + 4, edge.partner);
+        if (where != slot + 4)
+            edge.partner = target[where - slot];
+        else
+            mesh[edge.partner].partner = target[i];
+    }
 }
 
-bool flipImprovesAngle(PointList const& pointList, HalfEdge* edge)
+template <class Points, class Index>
+bool flipImprovesAngle(Points const& pointList, BasicHalfEdgeMesh<Index> const& mesh, EdgeIndex edge)
 {
-    auto a = pointList[edge->next->vertex];
-    auto b = pointList[edge->next->next->vertex];
-    auto c = pointList[edge->vertex];
-    auto d = pointList[edge->partner->next->next->vertex];
+    auto a = exactPoint(pointList, mesh[mesh.next(edge)].vertex);
+    auto b = exactPoint(pointList, mesh[mesh.prev(edge)].vertex);
+    auto c = exactPoint(pointList, mesh[edge].vertex);
+    auto d = exactPoint(pointList, mesh[mesh.prev(mesh[edge].partner)].vertex);
 
-    auto oldAngle = std::max(minimumInteriorAngle(a, b, c), minimumInteriorAngle(a, c, d));
-    auto newAngle = std::max(minimumInteriorAngle(a, b, d), minimumInteriorAngle(b, c, d));
+    auto oldAngle = std::max(minimumAngleKey(a, b, c), minimumAngleKey(a, c, d));
+    auto newAngle = std::max(minimumAngleKey(a, b, d), minimumAngleKey(b, c, d));
 
     return oldAngle > newAngle;
 }
 
-HalfEdge* getUndeletedLeft(std::set<EdgeID> const& deletedEdgeSet, HalfEdge* edge)
+// Whether the edge is not locally Delaunay, and flipping it gives two valid triangles.
+// Degenerate triangles are flipped away whenever possible.
+template <class Points, class Index>
+bool violatesDelaunay(Points const& pointList, BasicHalfEdgeMesh<Index> const& mesh, EdgeIndex edge)
+{
+    auto a = exactPoint(pointList, mesh[mesh.next(edge)].vertex);
+    auto b = exactPoint(pointList, mesh[mesh.prev(edge)].vertex);
+    auto c = exactPoint(pointList, mesh[edge].vertex);
+    auto d = exactPoint(pointList, mesh[mesh.prev(mesh[edge].partner)].vertex);
+
+    if (orient2d(b, c, d) <= 0 || orient2d(d, a, b) <= 0)
+        return false;
+
+    if (orient2d(c, a, b) <= 0 || orient2d(a, c, d) <= 0)
+        return true;
+
+    return incircle(c, a, b, d) > 0;
+}
+
+template <class Index>
+EdgeIndex getUndeletedLeft(BasicHalfEdgeMesh<Index> const& mesh,
+                           FlagList const& deletedList,
+                           EdgeIndex edge)
 {
     auto edge_right = edge;
-    auto edge_left = edge->next->next;
+    auto edge_left = mesh.prev(edge);
 
-    while (contains(deletedEdgeSet, getEdgeID(edge_left->vertex, edge_right->vertex)))
+    while (deletedList[edge_left])
     {
-        assert(edge_left->partner != nullptr);
-        edge_right = edge_left->partner;
-        edge_left = edge_right->next->next;
+        assert(mesh[edge_left].partner != mesh.none);
+        edge_right = mesh[edge_left].partner;
+        edge_left = mesh.prev(edge_right);
     }
 
     return edge_left;
 }
 
-HalfEdge* getUndeletedRight(std::set<EdgeID> const& deletedEdgeSet, HalfEdge* edge)
+template <class Index>
+EdgeIndex getUndeletedRight(BasicHalfEdgeMesh<Index> const& mesh,
+                            FlagList const& deletedList,
+                            EdgeIndex edge)
 {
     do
     {
-        edge = edge->partner->next;
+        edge = mesh.next(mesh[edge].partner);
 
-    } while (contains(deletedEdgeSet, getEdgeID(edge->vertex, edge->next->vertex)));
+    } while (deletedList[edge]);
 
     return edge;
 }
 
-double getSmallestAdjacentAngleOnHalfEdge(Point centerPoint, Point forwardPoint, Point leftPoint, Point rightPoint)
+template <class P>
+double getSmallestAdjacentAngleOnHalfEdge(P const& centerPoint,
+                                          P const& forwardPoint,
+                                          P const& leftPoint,
+                                          P const& rightPoint)
 {
-    auto forwardDirection = normalize(forwardPoint - centerPoint);
-
-    return std::max(dot(normalize(leftPoint - centerPoint), forwardDirection),
-                    dot(normalize(rightPoint - centerPoint), forwardDirection));
+    return std::max(angleKey(centerPoint, leftPoint, forwardPoint), angleKey(centerPoint, rightPoint, forwardPoint));
 }
 
-double getSmallestAdjacentAngleOnHalfEdge(HalfEdge* edge,
-                                          std::set<EdgeID> const& deletedEdgeSet,
-                                          std::vector<Point> const& pointList)
+template <class Points, class Index>
+double getSmallestAdjacentAngleOnHalfEdge(BasicHalfEdgeMesh<Index> const& mesh,
+                                          EdgeIndex edge,
+                                          FlagList const& deletedList,
+                                          Points const& pointList)
 {
-    auto leftEdge = getUndeletedLeft(deletedEdgeSet, edge);
-    auto rightEdge = getUndeletedRight(deletedEdgeSet, edge);
+    auto leftEdge = getUndeletedLeft(mesh, deletedList, edge);
+    auto rightEdge = getUndeletedRight(mesh, deletedList, edge);
 
-    auto centerPoint = pointList[edge->vertex];
-    auto forwardPoint = pointList[edge->next->vertex];
-    auto leftPoint = pointList[leftEdge->vertex];
-    auto rightPoint = pointList[rightEdge->next->vertex];
+    auto centerPoint = exactPoint(pointList, mesh[edge].vertex);
+    auto forwardPoint = exactPoint(pointList, mesh[mesh.next(edge)].vertex);
+    auto leftPoint = exactPoint(pointList, mesh[leftEdge].vertex);
+    auto rightPoint = exactPoint(pointList, mesh[mesh.next(rightEdge)].vertex);
 
     return getSmallestAdjacentAngleOnHalfEdge(centerPoint, forwardPoint, leftPoint, rightPoint);
 }
 
-double getSmallestAdjacentAngleOnEdge(HalfEdge* edge,
-                                      std::set<EdgeID> const& deletedEdgeSet,
-                                      std::vector<Point> const& pointList)
+template <class Points, class Index>
+double getSmallestAdjacentAngleOnEdge(BasicHalfEdgeMesh<Index> const& mesh,
+                                      EdgeIndex edge,
+                                      FlagList const& deletedList,
+                                      Points const& pointList)
 {
-    return std::max(getSmallestAdjacentAngleOnHalfEdge(edge, deletedEdgeSet, pointList),
-                    getSmallestAdjacentAngleOnHalfEdge(edge->partner, deletedEdgeSet, pointList));
+    return std::max(getSmallestAdjacentAngleOnHalfEdge(mesh, edge, deletedList, pointList),
+                    getSmallestAdjacentAngleOnHalfEdge(mesh, mesh[edge].partner, deletedList, pointList));
 }
 
-void updateEdge(HalfEdge* edgeToRemove,
+template <class Points, class Index>
+void updateEdge(BasicHalfEdgeMesh<Index> const& mesh,
+                EdgeIndex edgeToRemove,
                 EdgePriorityQueue& priorityQueue,
-                std::set<EdgeID> const& deletedEdgeSet,
-                std::vector<Point> const& pointList)
+                FlagList const& deletedList,
+                Points const& pointList)
 {
-    auto left = getUndeletedLeft(deletedEdgeSet, edgeToRemove);
-    auto right = getUndeletedRight(deletedEdgeSet, edgeToRemove);
+    auto left = getUndeletedLeft(mesh, deletedList, edgeToRemove);
+    auto right = getUndeletedRight(mesh, deletedList, edgeToRemove);
 
-    if (priorityQueue.contains(representative(left)))
+    if (priorityQueue.contains(representative(mesh, left)))
     {
         // Check if this is still removable
-        auto leftOfLeft = getUndeletedLeft(deletedEdgeSet, left->partner);
+        auto leftOfLeft = getUndeletedLeft(mesh, deletedList, mesh[left].partner);
 
-        if (leftOfLeft->partner == right || leftOfLeft->partner == edgeToRemove ||
-            !isInternallyConvex(pointList[edgeToRemove->vertex], pointList[right->next->vertex],
-                                pointList[leftOfLeft->vertex]))
+        if (mesh[leftOfLeft].partner == right || mesh[leftOfLeft].partner == edgeToRemove ||
+            !isInternallyConvex(exactPoint(pointList, mesh[edgeToRemove].vertex),
+                                exactPoint(pointList, mesh[mesh.next(right)].vertex),
+                                exactPoint(pointList, mesh[leftOfLeft].vertex)))
         {
-            priorityQueue.erase(representative(left));
+            priorityQueue.erase(representative(mesh, left));
         }
         else
         {
             // Need to update the priority
-            priorityQueue.update(representative(left), getSmallestAdjacentAngleOnEdge(left, deletedEdgeSet, pointList));
+            priorityQueue.update(representative(mesh, left),
+                                 getSmallestAdjacentAngleOnEdge(mesh, left, deletedList, pointList));
         }
     }
 
-    if (priorityQueue.contains(representative(right)))
+    if (priorityQueue.contains(representative(mesh, right)))
     {
-        auto rightOfRight = getUndeletedRight(deletedEdgeSet, right);
-        if (rightOfRight->partner == left || rightOfRight == edgeToRemove ||
-            !isInternallyConvex(pointList[edgeToRemove->vertex], pointList[rightOfRight->next->vertex],
-                                pointList[left->vertex]))
+        auto rightOfRight = getUndeletedRight(mesh, deletedList, right);
+        if (mesh[rightOfRight].partner == left || rightOfRight == edgeToRemove ||
+            !isInternallyConvex(exactPoint(pointList, mesh[edgeToRemove].vertex),
+                                exactPoint(pointList, mesh[mesh.next(rightOfRight)].vertex),
+                                exactPoint(pointList, mesh[left].vertex)))
         {
-            priorityQueue.erase(representative(right));
+            priorityQueue.erase(representative(mesh, right));
         }
         else
         {
-            priorityQueue.update(representative(right),
-                                 getSmallestAdjacentAngleOnEdge(right, deletedEdgeSet, pointList));
+            priorityQueue.update(representative(mesh, right),
+                                 getSmallestAdjacentAngleOnEdge(mesh, right, deletedList, pointList));
         }
     }
 }
 
+template <class Points, class Index>
 void getRemovableEdgeQueue(EdgePriorityQueue& priorityQueue,
-                           std::vector<Point> const& pointList,
-                           std::vector<std::unique_ptr<HalfEdge>> const& graph)
+                           Points const& pointList,
+                           BasicHalfEdgeMesh<Index> const& mesh,
+                           FlagList const& deletedList)
 {
-    for (auto&& edge : graph)
+    auto const N = static_cast<EdgeIndex>(mesh.size());
+    for (EdgeIndex edge = 0; edge < N; ++edge)
     {
-        if (edge->vertex > edge->next->vertex)
+        if (mesh[edge].vertex > mesh[mesh.next(edge)].vertex)
             continue;
 
-        if (isEdgeRemoveable(pointList, edge.get()))
+        if (isEdgeRemoveable(pointList, mesh, edge))
         {
-            priorityQueue.insert(edge.get(), getSmallestAdjacentAngleOnEdge(edge.get(), {}, pointList));
+            priorityQueue.insert(edge, getSmallestAdjacentAngleOnEdge(mesh, edge, deletedList, pointList));
         }
     }
 }
 
-std::vector<std::vector<std::uint16_t>> extractPolygonList(std::vector<std::unique_ptr<HalfEdge>> const& graph,
-                                                           std::set<EdgeID> const& deletedEdgeSet)
+// Writes the extracted polygons into a list of polygons, reusing the ones already in it
+template <class Index> class PolygonListOutput
+{
+public:
+    explicit PolygonListOutput(std::vector<BasicIndexList<Index>>& resultList)
+    : mResultList(resultList)
+    {
+    }
+
+    void begin()
+    {
+        if (mCount == mResultList.size())
+            mResultList.emplace_back();
+
+        mResultList[mCount].clear();
+    }
+
+    void push(Index vertex)
+    {
+        mResultList[mCount].push_back(vertex);
+    }
+
+    void end()
+    {
+        ++mCount;
+    }
+
+    void finish()
+    {
+        mResultList.resize(mCount);
+    }
+
+private:
+    std::vector<BasicIndexList<Index>>& mResultList;
+    std::size_t mCount = 0;
+};
+
+// Passes the extracted polygons on to a sink, one at a time
+template <class Index> class SinkOutput
+{
+public:
+    SinkOutput(BasicPolygonSink<Index>& sink, MemoryResource& resource)
+    : mSink(sink)
+    , mPolygon(resource)
+    {
+    }
+
+    void begin()
+    {
+        mPolygon.clear();
+    }
+
+    void push(Index vertex)
+    {
+        mPolygon.push_back(vertex);
+    }
+
+    void end()
+    {
+        mSink.polygon(mPolygon.data(), mPolygon.size());
+    }
+
+    void finish()
+    {
+    }
+
+private:
+    BasicPolygonSink<Index>& mSink;
+    ScratchVector<Index> mPolygon;
+};
+
+// Walk the undeleted half-edges around each polygon. If an adjacency is given, the side of each
+// half-edge is recorded as well, so its partner gives the neighbor without any further search.
+template <class Index, class Output>
+void extractPolygonList(BasicHalfEdgeMesh<Index> const& mesh,
+                        FlagList const& deletedList,
+                        Output& output,
+                        MemoryResource& resource,
+                        PolygonAdjacency* adjacency)
 {
-    std::vector<std::vector<std::uint16_t>> resultList;
-    std::set<HalfEdge*> visited;
+    std::uint32_t count = 0;
+    FlagList visitedList(mesh.size(), false, resource);
 
-    for (auto&& edge : graph)
+    // Polygon and side of each undeleted half-edge, and the half-edge of each side
+    ScratchVector<std::uint32_t> polygonOfEdge(resource), sideOfEdge(resource);
+    ScratchVector<EdgeIndex> edgeOfSide(resource);
+    if (adjacency)
+    {
+        polygonOfEdge.resize(mesh.size());
+        sideOfEdge.resize(mesh.size());
+        edgeOfSide.reserve(mesh.size());
+        adjacency->offsetList.assign(1, 0);
+    }
+
+    auto const N = static_cast<EdgeIndex>(mesh.size());
+    for (EdgeIndex edge = 0; edge < N; ++edge)
     {
         // Don't extract twice
-        if (contains(visited, edge.get()))
+        if (visitedList[edge])
             continue;
 
         // Don't extract deleted
-        if (contains(deletedEdgeSet, getEdgeID(edge.get())))
+        if (deletedList[edge])
             continue;
 
-        std::vector<std::uint16_t> polygon;
-        auto current = edge.get();
+        output.begin();
+        std::uint32_t side = 0;
+        auto current = edge;
         do
         {
-            visited.insert(current);
-            polygon.push_back(current->vertex);
+            visitedList[current] = true;
+            if (adjacency)
+            {
+                polygonOfEdge[current] = count;
+                sideOfEdge[current] = side;
+                edgeOfSide.push_back(current);
+            }
+            output.push(mesh[current].vertex);
+            ++side;
 
-            current = current->next;
-            while (contains(deletedEdgeSet, getEdgeID(current)))
-                current = current->partner->next;
+            current = mesh.next(current);
+            while (deletedList[current])
+                current = mesh.next(mesh[current].partner);
 
-        } while (current != edge.get());
+        } while (current != edge);
 
-        resultList.push_back(std::move(polygon));
+        output.end();
+        ++count;
+
+        if (adjacency)
+            adjacency->offsetList.push_back(static_cast<std::uint32_t>(edgeOfSide.size()));
     }
 
-    return resultList;
+    output.finish();
+
+    if (!adjacency)
+        return;
+
+    // Partners of undeleted half-edges are never deleted, so each inner side has its partner's polygon as neighbor
+    auto const sideCount = edgeOfSide.size();
+    adjacency->neighborList.resize(sideCount);
+    adjacency->neighborSideList.resize(sideCount);
+    for (std::size_t side = 0; side < sideCount; ++side)
+    {
+        auto partner = mesh[edgeOfSide[side]].partner;
+        if (partner == mesh.none)
+        {
+            adjacency->neighborList[side] = PolygonAdjacency::none;
+            adjacency->neighborSideList[side] = PolygonAdjacency::none;
+            continue;
+        }
+
+        assert(!deletedList[partner]);
+        adjacency->neighborList[side] = polygonOfEdge[partner];
+        adjacency->neighborSideList[side] = sideOfEdge[partner];
+    }
 }
 
-std::set<EdgeID> deleteEdges(EdgePriorityQueue& priorityQueue, std::vector<Point> const& pointList)
+template <class Points, class Index>
+void deleteEdges(BasicHalfEdgeMesh<Index> const& mesh,
+                 EdgePriorityQueue& priorityQueue,
+                 FlagList& deletedList,
+                 Points const& pointList)
 {
-    std::set<EdgeID> deletedEdgeSet;
-
     while (!priorityQueue.empty())
     {
         auto edgeToRemove = priorityQueue.extract();
 
-        deletedEdgeSet.insert(getEdgeID(edgeToRemove->vertex, edgeToRemove->next->vertex));
+        deletedList[edgeToRemove] = true;
+        deletedList[mesh[edgeToRemove].partner] = true;
 
-        updateEdge(edgeToRemove, priorityQueue, deletedEdgeSet, pointList);
-        updateEdge(edgeToRemove->partner, priorityQueue, deletedEdgeSet, pointList);
+        updateEdge(mesh, edgeToRemove, priorityQueue, deletedList, pointList);
+        updateEdge(mesh, mesh[edgeToRemove].partner, priorityQueue, deletedList, pointList);
     }
-
-    return deletedEdgeSet;
 }
-} // namespace
-
-void decomp::edgeFlip(PointList const& pointList, std::vector<std::unique_ptr<HalfEdge>> const& edges)
+// Flip inner edges as long as shouldFlip says so, but at most flipLimit times per edge
+template <class Index, class ShouldFlip>
+std::size_t
+flipEdges(BasicHalfEdgeMesh<Index>& mesh, unsigned flipLimit, MemoryResource& resource, ShouldFlip shouldFlip)
 {
-    std::vector<HalfEdge*> eligible;
-    for (auto const& edge : edges)
-    {
-        if (!edge->partner)
-            continue;
+    auto const N = static_cast<EdgeIndex>(mesh.size());
 
-        if (edge.get() != representative(edge.get()))
-            continue;
-        eligible.push_back(edge.get());
-    }
+    // Worklist of inner edges to check, processed in rounds. Flips only move half-edges between
+    // the six slots of the two triangles involved, and those are queued again, so stale entries are harmless.
+    ScratchVector<EdgeIndex> worklist(resource), nextWorklist(resource);
+    FlagList queuedList(N, false, resource);
+    ScratchVector<unsigned> flipCountList(N, 0, resource);
+
+    auto enqueue = [&](EdgeIndex edge) {
+        if (mesh[edge].partner == mesh.none || queuedList[edge] || queuedList[mesh[edge].partner])
+            return;
+
+        queuedList[edge] = true;
+        nextWorklist.push_back(edge);
+    };
+
+    nextWorklist.reserve(N / 2);
+    for (EdgeIndex edge = 0; edge < N; ++edge)
+        enqueue(edge);
 
-    for (std::size_t i = 0; i < edges.size(); ++i)
+    std::size_t flipCount = 0;
+    while (!nextWorklist.empty())
     {
-        bool flipped = false;
-        for (auto edge : eligible)
+        worklist.swap(nextWorklist);
+        nextWorklist.clear();
+
+        for (auto edge : worklist)
         {
-            if (!isEdgeRemoveable(pointList, edge))
+            queuedList[edge] = false;
+
+            auto partner = mesh[edge].partner;
+            if (partner == mesh.none)
                 continue;
 
-            if (!flipImprovesAngle(pointList, edge))
+            auto& edgeFlipCount = flipCountList[std::min(edge, partner)];
+            if (edgeFlipCount >= flipLimit)
                 continue;
 
-            flip(edge);
-            flipped = true;
+            if (!shouldFlip(edge))
+                continue;
+
+            flip(mesh, edge);
+            ++edgeFlipCount;
+            ++flipCount;
+
+            enqueue(mesh.next(edge));
+            enqueue(mesh.prev(edge));
+            enqueue(mesh.next(partner));
+            enqueue(mesh.prev(partner));
         }
-        if (!flipped)
-            break;
     }
+
+    return flipCount;
+}
+
+template <class Points, class Index>
+std::size_t
+edgeFlipImpl(Points const& pointList, BasicHalfEdgeMesh<Index>& mesh, unsigned flipLimit, MemoryResource& resource)
+{
+    return flipEdges(mesh, flipLimit, resource, [&](EdgeIndex edge) {
+        return isEdgeRemoveable(pointList, mesh, edge) && flipImprovesAngle(pointList, mesh, edge);
+    });
+}
+
+template <class Points, class Index>
+std::size_t delaunayFlipImpl(Points const& pointList, BasicHalfEdgeMesh<Index>& mesh, MemoryResource& resource)
+{
+    // Every flip either removes a degenerate triangle without adding one, or lowers the sum of the lifted
+    // volumes of the triangles, so this terminates without a flip limit
+    return flipEdges(mesh, std::numeric_limits<unsigned>::max(), resource, [&](EdgeIndex edge) {
+        return !mesh[edge].fixed && violatesDelaunay(pointList, mesh, edge);
+    });
+}
+
+template <class Points, class Index, class Output>
+void prioritizedHertelMehlhornImpl(Points const& pointList,
+                                   BasicHalfEdgeMesh<Index> const& mesh,
+                                   Output& output,
+                                   MemoryResource& resource,
+                                   PolygonAdjacency* adjacency)
+{
+    // Find out which edges are removable in general, i.e. which can be removed
+    // without creating non-convex corners in a first step.
+    // Both half-edges of a removed edge are flagged as deleted.
+    FlagList deletedList(mesh.size(), false, resource);
+    EdgePriorityQueue priorityQueue(mesh.size(), resource);
+    getRemovableEdgeQueue(priorityQueue, pointList, mesh, deletedList);
+
+    // Figure out which edges to actually remove
+    deleteEdges(mesh, priorityQueue, deletedList, pointList);
+
+    // Extract a list of polygons an return it
+    extractPolygonList(mesh, deletedList, output, resource, adjacency);
+}
+
+template <class Points, class Index, class Output>
+void linearHertelMehlhornImpl(Points const& pointList,
+                              BasicHalfEdgeMesh<Index> const& mesh,
+                              Output& output,
+                              MemoryResource& resource,
+                              PolygonAdjacency* adjacency)
+{
+    auto const N = static_cast<EdgeIndex>(mesh.size());
+
+    // Boundary of the merged polygon each undeleted half-edge is on, as a doubly linked list.
+    // Initially, these are just the triangles.
+    ScratchVector<EdgeIndex> nextList(N, 0, resource), prevList(N, 0, resource);
+    for (EdgeIndex edge = 0; edge < N; ++edge)
+    {
+        nextList[edge] = mesh.next(edge);
+        prevList[edge] = mesh.prev(edge);
+    }
+
+    FlagList deletedList(N, false, resource);
+    for (EdgeIndex edge = 0; edge < N; ++edge)
+    {
+        auto partner = mesh[edge].partner;
+        if (partner == mesh.none || partner < edge || mesh[edge].fixed)
+            continue;
+
+        // Both half-edges on the same polygon already, so removing them would leave a dangling edge
+        if (prevList[edge] == partner || nextList[edge] == partner)
+            continue;
+
+        // The corners at both ends of the edge after merging the two polygons. Half-edges keep their
+        // triangle slots, so the end of each one is still the vertex of the next one in its triangle.
+        auto start = exactPoint(pointList, mesh[edge].vertex);
+        auto end = exactPoint(pointList, mesh[partner].vertex);
+        auto beforeStart = exactPoint(pointList, mesh[prevList[edge]].vertex);
+        auto afterStart = exactPoint(pointList, mesh[mesh.next(nextList[partner])].vertex);
+        auto beforeEnd = exactPoint(pointList, mesh[prevList[partner]].vertex);
+        auto afterEnd = exactPoint(pointList, mesh[mesh.next(nextList[edge])].vertex);
+        if (!isInternallyConvex(beforeStart, start, afterStart) || !isInternallyConvex(beforeEnd, end, afterEnd))
+            continue;
+
+        deletedList[edge] = true;
+        deletedList[partner] = true;
+
+        nextList[prevList[edge]] = nextList[partner];
+        prevList[nextList[partner]] = prevList[edge];
+        nextList[prevList[partner]] = nextList[edge];
+        prevList[nextList[edge]] = prevList[partner];
+    }
+
+    extractPolygonList(mesh, deletedList, output, resource, adjacency);
 }
 
-std::vector<std::unique_ptr<HalfEdge>> decomp::buildHalfEdgeGraph(IndexList const& triangleList,
-                                                                  std::vector<EdgeID> const& fixedEdges)
+template <class Points, class Index, class Output>
+void hertelMehlhornImpl(Points const& pointList,
+                        BasicHalfEdgeMesh<Index> const& mesh,
+                        Output& output,
+                        MemoryResource& resource,
+                        MergeOrder order,
+                        PolygonAdjacency* adjacency)
+{
+    if (order == MergeOrder::Linear)
+        linearHertelMehlhornImpl(pointList, mesh, output, resource, adjacency);
+    else
+        prioritizedHertelMehlhornImpl(pointList, mesh, output, resource, adjacency);
+}
+} // namespace
+
+template <class Index>
+std::size_t decomp::edgeFlip(PointList const& pointList, BasicHalfEdgeMesh<Index>& mesh, unsigned flipLimit)
+{
+    return edgeFlip(pointList, mesh, flipLimit, newDeleteResource());
+}
+
+template <class Points, class Index>
+std::size_t decomp::edgeFlip(Points const& pointList,
+                             BasicHalfEdgeMesh<Index>& mesh,
+                             unsigned flipLimit,
+                             MemoryResource& resource)
+{
+    return edgeFlipImpl(pointList, mesh, flipLimit, resource);
+}
+
+template <class Index>
+BasicHalfEdgeMesh<Index> decomp::buildHalfEdgeGraph(BasicIndexList<Index> const& triangleList,
+                                                    std::vector<BasicEdgeID<Index>> const& fixedEdges)
+{
+    BasicHalfEdgeMesh<Index> mesh;
+    buildHalfEdgeGraph(triangleList, fixedEdges, mesh, newDeleteResource());
+    return mesh;
+}
+
+template <class Index>
+void decomp::buildHalfEdgeGraph(BasicIndexList<Index> const& triangleList,
+                                std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                BasicHalfEdgeMesh<Index>& mesh,
+                                MemoryResource& resource)
 {
     if (triangleList.size() % 3 != 0)
     {
         throw std::runtime_error("Given triangle list does not have size divisible by 3");
     }
 
-    std::set<EdgeID> fixed;
-    for (auto const& each : fixedEdges)
-        fixed.insert(getEdgeID(each.first, each.second));
+    mesh.reset(triangleList.size() / 3);
+    auto const N = static_cast<EdgeIndex>(triangleList.size());
 
-    using OpenEdgeMap = std::map<EdgeID, HalfEdge*>;
-    std::vector<std::unique_ptr<decomp::HalfEdge>> halfEdgeList;
-    OpenEdgeMap openEdgeList;
-    halfEdgeList.resize(triangleList.size());
+    // Sort all half-edges by their undirected edge, so partners end up next to each other
+    ScratchVector<KeyedEdge> edgeList(N, KeyedEdge(), resource), scratch(resource);
+    for (EdgeIndex a = 0; a < N; ++a)
+    {
+        mesh[a].vertex = triangleList[a];
+        mesh[a].partner = mesh.none;
+        mesh[a].fixed = false;
+        edgeList[a] = { getEdgeKey(triangleList[a], triangleList[mesh.next(a)]), a };
+    }
+    radixSort(edgeList, scratch);
+
+    // Join them pairwise. The sort is stable, so in case more than two half-edges share
+    // an edge, each one is joined with the next one after it in the triangle list.
+    for (EdgeIndex i = 0; i + 1 < N; ++i)
+    {
+        if (edgeList[i].key != edgeList[i + 1].key)
+            continue;
 
-    int const N = static_cast<int>(triangleList.size());
+        auto a = edgeList[i].edge;
+        auto b = edgeList[i + 1].edge;
+        mesh[a].partner = b;
+        mesh[b].partner = a;
+        ++i;
+    }
 
-    for (int i = 0; i < N; ++i)
-        halfEdgeList[i].reset(new HalfEdge);    
+    // Mark fixed edges by merging with the sorted edge keys
+    ScratchVector<std::uint64_t> fixedKeyList(resource);
+    fixedKeyList.reserve(fixedEdges.size());
+    for (auto const& each : fixedEdges)
+        fixedKeyList.push_back(getEdgeKey(each.first, each.second));
+    std::sort(fixedKeyList.begin(), fixedKeyList.end());
 
-    for (int i = 0; (i + 2) < N; i += 3)
+    auto fixedKey = fixedKeyList.begin();
+    for (auto const& each : edgeList)
     {
-        for (int j = 0; j < 3; ++j)
-        {
-            // Indices of the current/next edge/vertex in this triangle
-            auto a = i + j;
-            auto b = i + (j + 1) % 3;
+        while (fixedKey != fixedKeyList.end() && *fixedKey < each.key)
+            ++fixedKey;
 
-            halfEdgeList[a]->vertex = triangleList[a];
-            halfEdgeList[a]->next = halfEdgeList[b].get();
+        if (fixedKey == fixedKeyList.end())
+            break;
 
-            // Check if we have an open partner for this edge
-            auto edgeID = getEdgeID(triangleList[a], triangleList[b]);
+        mesh[each.edge].fixed = (*fixedKey == each.key);
+    }
+}
 
-            halfEdgeList[a]->fixed = contains(fixed, edgeID);
+template <class Index>
+std::size_t decomp::delaunayFlip(PointList const& pointList, BasicHalfEdgeMesh<Index>& mesh)
+{
+    return delaunayFlip(pointList, mesh, newDeleteResource());
+}
 
-            auto inserted = openEdgeList.insert({ edgeID, halfEdgeList[a].get() });
-            if (!inserted.second)
-            {
-                // We do! - Join them and erase from the open edges
-                inserted.first->second->partner = halfEdgeList[a].get();
-                halfEdgeList[a]->partner = inserted.first->second;
-                openEdgeList.erase(inserted.first);
-            }
-            else
-            {
-                halfEdgeList[a]->partner = nullptr;
-            }
-        }
-    }
+template <class Points, class Index>
+std::size_t decomp::delaunayFlip(Points const& pointList, BasicHalfEdgeMesh<Index>& mesh, MemoryResource& resource)
+{
+    return delaunayFlipImpl(pointList, mesh, resource);
+}
 
-    return halfEdgeList;
+template <class Index>
+std::vector<BasicIndexList<Index>> decomp::hertelMehlhorn(PointList const& pointList,
+                                                          BasicHalfEdgeMesh<Index> const& mesh)
+{
+    std::vector<BasicIndexList<Index>> result;
+    hertelMehlhorn(pointList, mesh, result, newDeleteResource());
+    return result;
 }
 
-std::vector<IndexList> decomp::hertelMehlhorn(PointList const& pointList,
-                                              IndexList const& triangleList,
-                                              std::vector<EdgeID> const& fixedEdges)
+template <class Points, class Index>
+void decomp::hertelMehlhorn(Points const& pointList,
+                            BasicHalfEdgeMesh<Index> const& mesh,
+                            std::vector<BasicIndexList<Index>>& result,
+                            MemoryResource& resource,
+                            MergeOrder order)
 {
-    // Extract connectivity information
-    auto graph = buildHalfEdgeGraph(triangleList, fixedEdges);
+    PolygonListOutput<Index> output(result);
+    hertelMehlhornImpl(pointList, mesh, output, resource, order, nullptr);
+}
 
-    // Refine the triangulation by flipping edges to increase the minimum interior angle
-    edgeFlip(pointList, graph);
+template <class Points, class Index>
+void decomp::hertelMehlhorn(Points const& pointList,
+                            BasicHalfEdgeMesh<Index> const& mesh,
+                            std::vector<BasicIndexList<Index>>& result,
+                            PolygonAdjacency& adjacency,
+                            MemoryResource& resource,
+                            MergeOrder order)
+{
+    PolygonListOutput<Index> output(result);
+    hertelMehlhornImpl(pointList, mesh, output, resource, order, &adjacency);
+}
 
-    // Find out which edges are removable in general, i.e. which can be removed
-    // without creating non-convex corners in a first step.
-    EdgePriorityQueue priorityQueue;
-    getRemovableEdgeQueue(priorityQueue, pointList, graph);
+template <class Points, class Index>
+void decomp::hertelMehlhorn(Points const& pointList,
+                            BasicHalfEdgeMesh<Index> const& mesh,
+                            BasicPolygonSink<Index>& sink,
+                            MemoryResource& resource,
+                            MergeOrder order)
+{
+    SinkOutput<Index> output(sink, resource);
+    hertelMehlhornImpl(pointList, mesh, output, resource, order, nullptr);
+}
 
-    // Figure out which edges to actually remove
-    auto deletedEdgeSet = deleteEdges(priorityQueue, pointList);
+template <class Points, class Index>
+void decomp::hertelMehlhorn(Points const& pointList,
+                            BasicHalfEdgeMesh<Index> const& mesh,
+                            BasicPolygonSink<Index>& sink,
+                            PolygonAdjacency& adjacency,
+                            MemoryResource& resource,
+                            MergeOrder order)
+{
+    SinkOutput<Index> output(sink, resource);
+    hertelMehlhornImpl(pointList, mesh, output, resource, order, &adjacency);
+}
 
-    // Extract a list of polygons an return it
-    return extractPolygonList(graph, deletedEdgeSet);
+template <class Index>
+std::vector<BasicIndexList<Index>> decomp::hertelMehlhorn(PointList const& pointList,
+                                                          BasicIndexList<Index> const& triangleList,
+                                                          std::vector<BasicEdgeID<Index>> const& fixedEdges)
+{
+    // Extract connectivity information
+    auto mesh = buildHalfEdgeGraph(triangleList, fixedEdges);
+
+    // Refine the triangulation by flipping edges to increase the minimum interior angle
+    edgeFlip(pointList, mesh);
+
+    return hertelMehlhorn(pointList, mesh);
 }
 
-std::vector<IndexList> decomp::decompose(PointList const& pointList,
-                                         IndexList simplePolygon,
-                                         std::vector<IndexList> holeList,
-                                         std::vector<EdgeID> const& fixedEdges)
+template <class Points, class Index>
+std::vector<BasicIndexList<Index>> decomp::decompose(Points const& pointList,
+                                                     BasicIndexList<Index> const& simplePolygon,
+                                                     std::vector<BasicIndexList<Index>> const& holeList,
+                                                     std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                                     DecomposeOptions const& options)
 {
-    auto simpleWithoutHoles = removeHoles(pointList, std::move(simplePolygon), std::move(holeList));
+    std::vector<BasicIndexList<Index>> result;
+    BasicDecomposer<Index>().decompose(pointList, simplePolygon, holeList, fixedEdges, result, options);
+    return result;
+}
 
-    auto triangleList = earClipping(pointList, simpleWithoutHoles);
+template <class Points, class Index>
+std::vector<BasicIndexList<Index>> decomp::decompose(Points const& pointList,
+                                                     BasicIndexList<Index> const& simplePolygon,
+                                                     std::vector<BasicIndexList<Index>> const& holeList,
+                                                     std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                                     PolygonAdjacency& adjacency,
+                                                     DecomposeOptions const& options)
+{
+    std::vector<BasicIndexList<Index>> result;
+    BasicDecomposer<Index>().decompose(pointList, simplePolygon, holeList, fixedEdges, result, adjacency, options);
+    return result;
+}
 
-    return hertelMehlhorn(pointList, triangleList, fixedEdges);
+template <class Points, class Index>
+void decomp::decompose(Points const& pointList,
+                       BasicIndexList<Index> const& simplePolygon,
+                       std::vector<BasicIndexList<Index>> const& holeList,
+                       std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                       BasicPolygonSink<Index>& sink,
+                       DecomposeOptions const& options)
+{
+    BasicDecomposer<Index>().decompose(pointList, simplePolygon, holeList, fixedEdges, sink, options);
 }
+
+std::uint32_t const decomp::PolygonAdjacency::none;
+
+template HalfEdgeMesh decomp::buildHalfEdgeGraph(IndexList const&, std::vector<EdgeID> const&);
+template HalfEdgeMesh32 decomp::buildHalfEdgeGraph(IndexList32 const&, std::vector<EdgeID32> const&);
+template std::size_t decomp::edgeFlip(PointList const&, HalfEdgeMesh&, unsigned);
+template std::size_t decomp::edgeFlip(PointList const&, HalfEdgeMesh32&, unsigned);
+template void decomp::buildHalfEdgeGraph(IndexList const&, std::vector<EdgeID> const&, HalfEdgeMesh&, MemoryResource&);
+template void
+decomp::buildHalfEdgeGraph(IndexList32 const&, std::vector<EdgeID32> const&, HalfEdgeMesh32&, MemoryResource&);
+template std::size_t decomp::edgeFlip(PointList const&, HalfEdgeMesh&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(PointList const&, HalfEdgeMesh32&, unsigned, MemoryResource&);
+template std::size_t decomp::delaunayFlip(PointList const&, HalfEdgeMesh&);
+template std::size_t decomp::delaunayFlip(PointList const&, HalfEdgeMesh32&);
+template std::size_t decomp::delaunayFlip(PointList const&, HalfEdgeMesh&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(PointList const&, HalfEdgeMesh32&, MemoryResource&);
+template std::vector<IndexList> decomp::hertelMehlhorn(PointList const&, HalfEdgeMesh const&);
+template std::vector<IndexList32> decomp::hertelMehlhorn(PointList const&, HalfEdgeMesh32 const&);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh const&, std::vector<IndexList>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, MemoryResource&, MergeOrder);
+template std::vector<IndexList>
+decomp::hertelMehlhorn(PointList const&, IndexList const&, std::vector<EdgeID> const&);
+template std::vector<IndexList32>
+decomp::hertelMehlhorn(PointList const&, IndexList32 const&, std::vector<EdgeID32> const&);
+template std::vector<IndexList> decomp::decompose(PointList const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(PointList const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh const&, std::vector<IndexList>&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template std::vector<IndexList> decomp::decompose(PointList const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  PolygonAdjacency&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(PointList const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    PolygonAdjacency&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(PointList const&, HalfEdgeMesh const&, PolygonSink&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh32 const&, PolygonSink32&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh const&, PolygonSink&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointList const&, HalfEdgeMesh32 const&, PolygonSink32&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::decompose(PointList const&,
+                                IndexList const&,
+                                std::vector<IndexList> const&,
+                                std::vector<EdgeID> const&,
+                                PolygonSink&,
+                                DecomposeOptions const&);
+template void decomp::decompose(PointList const&,
+                                IndexList32 const&,
+                                std::vector<IndexList32> const&,
+                                std::vector<EdgeID32> const&,
+                                PolygonSink32&,
+                                DecomposeOptions const&);
+
+template std::size_t decomp::edgeFlip(FloatPointView const&, HalfEdgeMesh&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(FloatPointView const&, HalfEdgeMesh32&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(PointView const&, HalfEdgeMesh&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(PointView const&, HalfEdgeMesh32&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(FixedPointView const&, HalfEdgeMesh&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(FixedPointView const&, HalfEdgeMesh32&, unsigned, MemoryResource&);
+template std::size_t decomp::delaunayFlip(FloatPointView const&, HalfEdgeMesh&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(FloatPointView const&, HalfEdgeMesh32&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(PointView const&, HalfEdgeMesh&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(PointView const&, HalfEdgeMesh32&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(FixedPointView const&, HalfEdgeMesh&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(FixedPointView const&, HalfEdgeMesh32&, MemoryResource&);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh const&, std::vector<IndexList>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh const&, std::vector<IndexList>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh const&, std::vector<IndexList>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, MemoryResource&, MergeOrder);
+template std::vector<IndexList> decomp::decompose(FloatPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(FloatPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    DecomposeOptions const&);
+template std::vector<IndexList> decomp::decompose(PointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(PointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    DecomposeOptions const&);
+template std::vector<IndexList> decomp::decompose(FixedPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(FixedPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(FloatPointView const&,
+                                     HalfEdgeMesh const&,
+                                     std::vector<IndexList>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template void decomp::hertelMehlhorn(FloatPointView const&,
+                                     HalfEdgeMesh32 const&,
+                                     std::vector<IndexList32>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh const&, std::vector<IndexList>&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(FixedPointView const&,
+                                     HalfEdgeMesh const&,
+                                     std::vector<IndexList>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template void decomp::hertelMehlhorn(FixedPointView const&,
+                                     HalfEdgeMesh32 const&,
+                                     std::vector<IndexList32>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template std::vector<IndexList> decomp::decompose(FloatPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  PolygonAdjacency&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(FloatPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    PolygonAdjacency&,
+                                                    DecomposeOptions const&);
+template std::vector<IndexList> decomp::decompose(PointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  PolygonAdjacency&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(PointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    PolygonAdjacency&,
+                                                    DecomposeOptions const&);
+template std::vector<IndexList> decomp::decompose(FixedPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  PolygonAdjacency&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(FixedPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    PolygonAdjacency&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh const&, PolygonSink&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh const&, PolygonSink&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FloatPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::decompose(FloatPointView const&,
+                                IndexList const&,
+                                std::vector<IndexList> const&,
+                                std::vector<EdgeID> const&,
+                                PolygonSink&,
+                                DecomposeOptions const&);
+template void decomp::decompose(FloatPointView const&,
+                                IndexList32 const&,
+                                std::vector<IndexList32> const&,
+                                std::vector<EdgeID32> const&,
+                                PolygonSink32&,
+                                DecomposeOptions const&);
+template void decomp::hertelMehlhorn(PointView const&, HalfEdgeMesh const&, PolygonSink&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh32 const&, PolygonSink32&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh const&, PolygonSink&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    PointView const&, HalfEdgeMesh32 const&, PolygonSink32&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::decompose(PointView const&,
+                                IndexList const&,
+                                std::vector<IndexList> const&,
+                                std::vector<EdgeID> const&,
+                                PolygonSink&,
+                                DecomposeOptions const&);
+template void decomp::decompose(PointView const&,
+                                IndexList32 const&,
+                                std::vector<IndexList32> const&,
+                                std::vector<EdgeID32> const&,
+                                PolygonSink32&,
+                                DecomposeOptions const&);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh const&, PolygonSink&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh const&, PolygonSink&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    FixedPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::decompose(FixedPointView const&,
+                                IndexList const&,
+                                std::vector<IndexList> const&,
+                                std::vector<EdgeID> const&,
+                                PolygonSink&,
+                                DecomposeOptions const&);
+template void decomp::decompose(FixedPointView const&,
+                                IndexList32 const&,
+                                std::vector<IndexList32> const&,
+                                std::vector<EdgeID32> const&,
+                                PolygonSink32&,
+                                DecomposeOptions const&);
+
+template std::size_t decomp::edgeFlip(IntegerPointView const&, HalfEdgeMesh&, unsigned, MemoryResource&);
+template std::size_t decomp::edgeFlip(IntegerPointView const&, HalfEdgeMesh32&, unsigned, MemoryResource&);
+template std::size_t decomp::delaunayFlip(IntegerPointView const&, HalfEdgeMesh&, MemoryResource&);
+template std::size_t decomp::delaunayFlip(IntegerPointView const&, HalfEdgeMesh32&, MemoryResource&);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh const&, std::vector<IndexList>&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh32 const&, std::vector<IndexList32>&, MemoryResource&, MergeOrder);
+template std::vector<IndexList> decomp::decompose(IntegerPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(IntegerPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(IntegerPointView const&,
+                                     HalfEdgeMesh const&,
+                                     std::vector<IndexList>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template void decomp::hertelMehlhorn(IntegerPointView const&,
+                                     HalfEdgeMesh32 const&,
+                                     std::vector<IndexList32>&,
+                                     PolygonAdjacency&,
+                                     MemoryResource&,
+                                     MergeOrder);
+template std::vector<IndexList> decomp::decompose(IntegerPointView const&,
+                                                  IndexList const&,
+                                                  std::vector<IndexList> const&,
+                                                  std::vector<EdgeID> const&,
+                                                  PolygonAdjacency&,
+                                                  DecomposeOptions const&);
+template std::vector<IndexList32> decomp::decompose(IntegerPointView const&,
+                                                    IndexList32 const&,
+                                                    std::vector<IndexList32> const&,
+                                                    std::vector<EdgeID32> const&,
+                                                    PolygonAdjacency&,
+                                                    DecomposeOptions const&);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh const&, PolygonSink&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh const&, PolygonSink&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::hertelMehlhorn(
+    IntegerPointView const&, HalfEdgeMesh32 const&, PolygonSink32&, PolygonAdjacency&, MemoryResource&, MergeOrder);
+template void decomp::decompose(IntegerPointView const&,
+                                IndexList const&,
+                                std::vector<IndexList> const&,
+                                std::vector<EdgeID> const&,
+                                PolygonSink&,
+                                DecomposeOptions const&);
+template void decomp::decompose(IntegerPointView const&,
+                                IndexList32 const&,
+                                std::vector<IndexList32> const&,
+                                std::vector<EdgeID32> const&,
+                                PolygonSink32&,
+                                DecomposeOptions const&);
@@ -1,33 +1,376 @@
 #ifndef LIB_DECOMP_CONVEX_DECOMPOSITION
 #define LIB_DECOMP_CONVEX_DECOMPOSITION
 
+#include "polygon_sink.hpp"
 #include "triangulation.hpp"
-#include <memory>
 
 namespace decomp
 {
 
-struct HalfEdge
+template <class Index> using BasicEdgeID = std::pair<Index, Index>;
+using EdgeID = BasicEdgeID<std::uint16_t>;
+using EdgeID32 = BasicEdgeID<std::uint32_t>;
+
+/** Connectivity of a triangle mesh, with all half-edges stored in one contiguous array.
+    The half-edges of triangle t are stored at 3t, 3t+1 and 3t+2 in counter-clockwise order,
+    so the next half-edge in a triangle is implicit. Half-edge e starts at vertex e and ends
+    at the vertex of next(e).
+ */
+template <class Index> class BasicHalfEdgeMesh
+{
+public:
+    using EdgeIndex = std::uint32_t;
+
+    /** Partner of half-edges on the boundary.
+     */
+    static EdgeIndex const none = ~EdgeIndex(0);
+
+    struct HalfEdge
+    {
+        Index vertex;
+        EdgeIndex partner;
+        bool fixed;
+    };
+
+    BasicHalfEdgeMesh() = default;
+
+    explicit BasicHalfEdgeMesh(std::size_t triangleCount)
+    : mHalfEdgeList(triangleCount * 3)
+    {
+    }
+
+    static EdgeIndex next(EdgeIndex e)
+    {
+        return (e % 3 == 2) ? e - 2 : e + 1;
+    }
+
+    static EdgeIndex prev(EdgeIndex e)
+    {
+        return (e % 3 == 0) ? e + 2 : e - 1;
+    }
+
+    /** Resize to the given number of triangles, keeping the allocated memory.
+        The contents of the half-edges are unspecified afterwards.
+     */
+    void reset(std::size_t triangleCount)
+    {
+        mHalfEdgeList.resize(triangleCount * 3);
+    }
+
+    /** Number of half-edges, i.e. three times the number of triangles.
+     */
+    std::size_t size() const
+    {
+        return mHalfEdgeList.size();
+    }
+
+    std::size_t triangleCount() const
+    {
+        return mHalfEdgeList.size() / 3;
+    }
+
+    HalfEdge& operator[](EdgeIndex e)
+    {
+        return mHalfEdgeList[e];
+    }
+
+    HalfEdge const& operator[](EdgeIndex e) const
+    {
+        return mHalfEdgeList[e];
+    }
+
+    /** Get the current triangles, e.g. after they were changed by edgeFlip.
+     */
+    BasicIndexList<Index> triangleList() const
+    {
+        BasicIndexList<Index> result;
+        result.reserve(mHalfEdgeList.size());
+        for (auto const& edge : mHalfEdgeList)
+            result.push_back(edge.vertex);
+        return result;
+    }
+
+private:
+    std::vector<HalfEdge> mHalfEdgeList;
+};
+
+template <class Index> typename BasicHalfEdgeMesh<Index>::EdgeIndex const BasicHalfEdgeMesh<Index>::none;
+
+using HalfEdgeMesh = BasicHalfEdgeMesh<std::uint16_t>;
+using HalfEdgeMesh32 = BasicHalfEdgeMesh<std::uint32_t>;
+
+/** Build the half-edge mesh for a list of triangles. Half-edges on the given fixed edges are
+    marked, so they are neither flipped nor removed later.
+ */
+template <class Index>
+BasicHalfEdgeMesh<Index> buildHalfEdgeGraph(BasicIndexList<Index> const& triangleList,
+                                            std::vector<BasicEdgeID<Index>> const& fixedEdges);
+
+inline HalfEdgeMesh buildHalfEdgeGraph(IndexList const& triangleList, std::vector<EdgeID> const& fixedEdges)
 {
-    std::uint16_t vertex;
-    HalfEdge* partner;
-    HalfEdge* next;
-    bool fixed;
+    return buildHalfEdgeGraph<std::uint16_t>(triangleList, fixedEdges);
+}
+
+/** Same as above, but rebuild the given mesh to reuse its memory, and take all temporary storage
+    from the given resource.
+ */
+template <class Index>
+void buildHalfEdgeGraph(BasicIndexList<Index> const& triangleList,
+                        std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                        BasicHalfEdgeMesh<Index>& mesh,
+                        MemoryResource& resource);
+
+/** Default for the number of times a single edge may be flipped in edgeFlip.
+ */
+unsigned const defaultFlipLimit = 16;
+
+/** Refine a triangulation by flipping edges to increase the minimum interior angle.
+    After each flip, only the four surrounding edges are checked again. Edges that were already
+    flipped flipLimit times are left alone, which guards against cycling on degenerate input.
+    Returns the number of flips made.
+ */
+template <class Index>
+std::size_t edgeFlip(PointList const& pointList, BasicHalfEdgeMesh<Index>& mesh, unsigned flipLimit = defaultFlipLimit);
+
+/** Same as above, but take all temporary storage from the given resource.
+ */
+template <class Points, class Index>
+std::size_t
+edgeFlip(Points const& pointList, BasicHalfEdgeMesh<Index>& mesh, unsigned flipLimit, MemoryResource& resource);
+
+/** Flip edges until the triangulation is the constrained Delaunay triangulation, where the boundary edges and the
+    fixed edges are the constraints. The incircle tests are exact, so this terminates without a flip limit.
+    Each flip is O(1), but there can be O(n^2) of them for n vertices, depending on the starting triangulation.
+    Degenerate triangles are flipped away where possible. Returns the number of flips made.
+ */
+template <class Index> std::size_t delaunayFlip(PointList const& pointList, BasicHalfEdgeMesh<Index>& mesh);
+
+/** Same as above, but take all temporary storage from the given resource.
+ */
+template <class Points, class Index>
+std::size_t delaunayFlip(Points const& pointList, BasicHalfEdgeMesh<Index>& mesh, MemoryResource& resource);
+
+/** Order in which hertelMehlhorn removes the inner edges of a mesh.
+ */
+enum class MergeOrder
+{
+    /** Always remove the edge that leaves the largest angles next, with the removable edges in a priority queue.
+        This takes O(n log n) time for n triangles, plus the time to walk around vertices of high degree.
+        Edges with the same priority are removed in the order their half-edges are stored in the mesh. edgeFlip
+        moves half-edges between the slots of the flipped triangles, so after flips this is no longer the order of
+        the input triangles.
+     */
+    LargestAngle,
+
+    /** Remove every edge that can be removed in a single pass over the mesh, in the order the edges are stored.
+        The merged polygons are kept as linked lists of their half-edges, so each test takes constant time, and
+        the merge takes O(n) time overall. Like any order, this gives at most four times the optimal number of
+        polygons, but they tend to have sharper corners.
+     */
+    Linear
 };
 
-using EdgeID = std::pair<std::uint16_t, std::uint16_t>;
+/** Adjacency of a list of convex polygons that share their edges, stored in flat arrays.
+    Side s of polygon p is its edge from vertex s to vertex s + 1, which is also the portal to the neighbor on
+    that side. The entries for that side are at offsetList[p] + s.
+ */
+struct PolygonAdjacency
+{
+    /** Neighbor of sides on the boundary.
+     */
+    static std::uint32_t const none = ~std::uint32_t(0);
+
+    /** Index of the first side of each polygon, followed by the total number of sides.
+     */
+    std::vector<std::uint32_t> offsetList;
 
-std::vector<std::unique_ptr<HalfEdge>> buildHalfEdgeGraph(IndexList const& triangleList, std::vector<EdgeID> const& fixedEdges);
+    /** The polygon on the other side of each side, or none.
+     */
+    std::vector<std::uint32_t> neighborList;
 
-std::vector<IndexList> hertelMehlhorn(PointList const& pointList, IndexList const& triangleList, std::vector<EdgeID> const& fixedEdges);
+    /** The side of the neighbor that is the same edge in the opposite direction, or none.
+     */
+    std::vector<std::uint32_t> neighborSideList;
 
-void edgeFlip(PointList const& pointList, std::vector<std::unique_ptr<HalfEdge>> const& edges);
+    std::size_t polygonCount() const
+    {
+        return offsetList.empty() ? 0 : offsetList.size() - 1;
+    }
+
+    std::uint32_t neighbor(std::size_t polygon, std::size_t side) const
+    {
+        return neighborList[offsetList[polygon] + side];
+    }
+
+    std::uint32_t neighborSide(std::size_t polygon, std::size_t side) const
+    {
+        return neighborSideList[offsetList[polygon] + side];
+    }
+};
+
+/** Merge the triangles of an existing mesh into convex polygons.
+    Unlike the triangle list overload, this does not run edgeFlip first.
+ */
+template <class Index>
+std::vector<BasicIndexList<Index>> hertelMehlhorn(PointList const& pointList, BasicHalfEdgeMesh<Index> const& mesh);
+
+/** Same as above, but write into the given result to reuse its memory, and take all temporary storage
+    from the given resource. The edges are removed in the given order.
+ */
+template <class Points, class Index>
+void hertelMehlhorn(Points const& pointList,
+                    BasicHalfEdgeMesh<Index> const& mesh,
+                    std::vector<BasicIndexList<Index>>& result,
+                    MemoryResource& resource,
+                    MergeOrder order = MergeOrder::LargestAngle);
+
+/** Same as above, but also write the adjacency of the polygons, as given by the half-edges between them.
+ */
+template <class Points, class Index>
+void hertelMehlhorn(Points const& pointList,
+                    BasicHalfEdgeMesh<Index> const& mesh,
+                    std::vector<BasicIndexList<Index>>& result,
+                    PolygonAdjacency& adjacency,
+                    MemoryResource& resource,
+                    MergeOrder order = MergeOrder::LargestAngle);
+
+/** Same as above, but pass the polygons to the given sink instead, e.g. to write them into flat buffers.
+    Apart from the sink itself, this allocates only from the given resource.
+ */
+template <class Points, class Index>
+void hertelMehlhorn(Points const& pointList,
+                    BasicHalfEdgeMesh<Index> const& mesh,
+                    BasicPolygonSink<Index>& sink,
+                    MemoryResource& resource,
+                    MergeOrder order = MergeOrder::LargestAngle);
+
+/** Same as above, but also write the adjacency of the polygons, in the order they are passed to the sink.
+ */
+template <class Points, class Index>
+void hertelMehlhorn(Points const& pointList,
+                    BasicHalfEdgeMesh<Index> const& mesh,
+                    BasicPolygonSink<Index>& sink,
+                    PolygonAdjacency& adjacency,
+                    MemoryResource& resource,
+                    MergeOrder order = MergeOrder::LargestAngle);
+
+/** Merge the given triangles into convex polygons, after refining them with edgeFlip.
+ */
+template <class Index>
+std::vector<BasicIndexList<Index>> hertelMehlhorn(PointList const& pointList,
+                                                  BasicIndexList<Index> const& triangleList,
+                                                  std::vector<BasicEdgeID<Index>> const& fixedEdges);
+
+inline std::vector<IndexList>
+hertelMehlhorn(PointList const& pointList, IndexList const& triangleList, std::vector<EdgeID> const& fixedEdges)
+{
+    return hertelMehlhorn<std::uint16_t>(pointList, triangleList, fixedEdges);
+}
+
+/** Algorithm used by decompose to triangulate the polygon, before the triangles are refined and merged.
+ */
+enum class Triangulator
+{
+    /** removeHoles followed by earClipping, which is quadratic in the worst case.
+     */
+    EarClipping,
+
+    /** monotoneTriangulation, which takes O(n log n) time and is better suited for large polygons.
+     */
+    Monotone,
+
+    /** constrainedDelaunay instead of edgeFlip, which maximizes the smallest angle over all triangulations of
+        the polygon. It triangulates the vertices by divide and conquer in O(n log n) time, and then inserts the
+        edges, which takes close to linear time on typical outlines, but is quadratic in the worst case.
+     */
+    ConstrainedDelaunay
+};
+
+/** Trade-off between the quality of the convex polygons and the time decompose takes, e.g. for carving
+    obstacles into a navigation mesh at runtime. The complexities are for n vertices, including those of the holes,
+    and leave out the triangulation itself, which is the same in all tiers: quadratic in the worst case for ear
+    clipping, but close to linear on typical outlines, O(n log n) for the monotone triangulator, and in between for
+    the constrained Delaunay triangulator.
+    The tiers only differ in whether edgeFlip runs and in the MergeOrder of hertelMehlhorn.
+ */
+enum class Tier
+{
+    /** No flips and a linear merge: skip edgeFlip, and merge in MergeOrder::Linear, which takes O(n) time.
+        The polygons have the sharpest corners, and hole bridges often leave twice as many of them.
+     */
+    Fast,
+
+    /** Run edgeFlip, but merge in MergeOrder::Linear. Both take O(n) time. There are about as many polygons
+        as in the quality tier, but their corners are sharper.
+     */
+    Balanced,
+
+    /** The full pipeline: edgeFlip and MergeOrder::LargestAngle. The merge takes
+        O(n log n) for its queue, plus the walks around vertices of high degree, which are quadratic in the degree.
+     */
+    Quality
+};
+
+/** Merge order of the given tier.
+ */
+inline MergeOrder mergeOrder(Tier tier)
+{
+    return tier == Tier::Quality ? MergeOrder::LargestAngle : MergeOrder::Linear;
+}
+
+struct DecomposeOptions
+{
+    Triangulator triangulator = Triangulator::EarClipping;
+
+    /** Whether edgeFlip runs and how the triangles are merged, see Tier. Ear clipping always uses
+        EarOrder::LargestAngle. Triangulator::ConstrainedDelaunay never runs edgeFlip, as its triangles are
+        already Delaunay, so its fast and balanced tiers are the same.
+     */
+    Tier tier = Tier::Quality;
+};
 
 /** Decompose a given simple polygon with simple holes into a list of convex polygons.
     The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
+    The result only depends on the values of the points, so it is the same for a view as for a PointList with
+    the converted points, except in the integer mode.
+ */
+template <class Points, class Index>
+std::vector<BasicIndexList<Index>> decompose(Points const& pointList,
+                                             BasicIndexList<Index> const& simplePolygon,
+                                             std::vector<BasicIndexList<Index>> const& holeList = {},
+                                             std::vector<BasicEdgeID<Index>> const& fixedEdges = {},
+                                             DecomposeOptions const& options = {});
+
+inline std::vector<IndexList> decompose(PointList const& pointList,
+                                        IndexList const& simplePolygon,
+                                        std::vector<IndexList> const& holeList = {},
+                                        std::vector<EdgeID> const& fixedEdges = {},
+                                        DecomposeOptions const& options = {})
+{
+    return decompose<PointList, std::uint16_t>(pointList, simplePolygon, holeList, fixedEdges, options);
+}
+
+/** Same as above, but also write the adjacency of the convex polygons, which comes for free from the
+    half-edges left over from merging. Each side is shared with at most one neighbor.
+ */
+template <class Points, class Index>
+std::vector<BasicIndexList<Index>> decompose(Points const& pointList,
+                                             BasicIndexList<Index> const& simplePolygon,
+                                             std::vector<BasicIndexList<Index>> const& holeList,
+                                             std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                             PolygonAdjacency& adjacency,
+                                             DecomposeOptions const& options = {});
+
+/** Same as the first overload, but pass the convex polygons to the given sink instead of returning them,
+    e.g. a BasicFlatPolygonSink or a BasicBufferSink for one contiguous index array with offsets.
  */
-std::vector<IndexList>
-decompose(PointList const& pointList, IndexList simplePolygon, std::vector<IndexList> holeList = {}, std::vector<EdgeID> const& fixedEdges = {});
+template <class Points, class Index>
+void decompose(Points const& pointList,
+               BasicIndexList<Index> const& simplePolygon,
+               std::vector<BasicIndexList<Index>> const& holeList,
+               std::vector<BasicEdgeID<Index>> const& fixedEdges,
+               BasicPolygonSink<Index>& sink,
+               DecomposeOptions const& options = {});
 }
 
 #endif
@@ -0,0 +1,398 @@
+#include "decomposer.hpp"
+#include "delaunay.hpp"
+#include "monotone.hpp"
+
+using namespace decomp;
+
+namespace
+{
+
+// Reclaims the arena when a decomposition ends, even if it throws
+class ArenaScope
+{
+public:
+    explicit ArenaScope(ArenaResource& arena)
+    : mArena(arena)
+    {
+    }
+
+    ~ArenaScope()
+    {
+        mArena.release();
+    }
+
+private:
+    ArenaResource& mArena;
+};
+
+} // namespace
+
+template <class Index>
+BasicDecomposer<Index>::BasicDecomposer(MemoryResource& upstream)
+: mArena(upstream)
+{
+}
+
+template <class Index>
+template <class Points>
+void BasicDecomposer<Index>::decompose(Points const& pointList,
+                                       BasicIndexList<Index> const& simplePolygon,
+                                       std::vector<BasicIndexList<Index>> const& holeList,
+                                       std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                       std::vector<BasicIndexList<Index>>& result,
+                                       DecomposeOptions const& options)
+{
+    run(pointList, simplePolygon, holeList, fixedEdges, result, nullptr, options);
+}
+
+template <class Index>
+template <class Points>
+void BasicDecomposer<Index>::decompose(Points const& pointList,
+                                       BasicIndexList<Index> const& simplePolygon,
+                                       std::vector<BasicIndexList<Index>> const& holeList,
+                                       std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                       std::vector<BasicIndexList<Index>>& result,
+                                       PolygonAdjacency& adjacency,
+                                       DecomposeOptions const& options)
+{
+    run(pointList, simplePolygon, holeList, fixedEdges, result, &adjacency, options);
+}
+
+template <class Index>
+template <class Points>
+void BasicDecomposer<Index>::decompose(Points const& pointList,
+                                       BasicIndexList<Index> const& simplePolygon,
+                                       std::vector<BasicIndexList<Index>> const& holeList,
+                                       std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                       BasicPolygonSink<Index>& sink,
+                                       DecomposeOptions const& options)
+{
+    run(pointList, simplePolygon, holeList, fixedEdges, sink, nullptr, options);
+}
+
+template <class Index>
+template <class Points>
+void BasicDecomposer<Index>::decompose(Points const& pointList,
+                                       BasicIndexList<Index> const& simplePolygon,
+                                       std::vector<BasicIndexList<Index>> const& holeList,
+                                       std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                       BasicPolygonSink<Index>& sink,
+                                       PolygonAdjacency& adjacency,
+                                       DecomposeOptions const& options)
+{
+    run(pointList, simplePolygon, holeList, fixedEdges, sink, &adjacency, options);
+}
+
+template <class Index>
+template <class Points, class Result>
+void BasicDecomposer<Index>::run(Points const& pointList,
+                                 BasicIndexList<Index> const& simplePolygon,
+                                 std::vector<BasicIndexList<Index>> const& holeList,
+                                 std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                 Result& result,
+                                 PolygonAdjacency* adjacency,
+                                 DecomposeOptions const& options)
+{
+    ArenaScope scope(mArena);
+
+    if (options.triangulator == Triangulator::EarClipping)
+    {
+        removeHoles(pointList, simplePolygon, holeList, mSimplePolygon, mArena);
+        earClipping(pointList, mSimplePolygon, mTriangleList, mArena);
+    }
+    else if (options.triangulator == Triangulator::ConstrainedDelaunay)
+    {
+        constrainedDelaunay(pointList, simplePolygon, holeList, mTriangleList, mArena);
+    }
+    else
+    {
+        monotoneTriangulation(pointList, simplePolygon, holeList, mTriangleList, mArena);
+    }
+
+    buildHalfEdgeGraph(mTriangleList, fixedEdges, mMesh, mArena);
+
+    // The constrained Delaunay triangulation already maximizes the smallest angle
+    if (options.triangulator != Triangulator::ConstrainedDelaunay && options.tier != Tier::Fast)
+        edgeFlip(pointList, mMesh, defaultFlipLimit, mArena);
+
+    if (adjacency)
+        hertelMehlhorn(pointList, mMesh, result, *adjacency, mArena, mergeOrder(options.tier));
+    else
+        hertelMehlhorn(pointList, mMesh, result, mArena, mergeOrder(options.tier));
+}
+
+template <class Index>
+std::vector<BasicIndexList<Index>> BasicDecomposer<Index>::decompose(PointList const& pointList,
+                                                                     BasicIndexList<Index> const& simplePolygon,
+                                                                     std::vector<BasicIndexList<Index>> const& holeList,
+                                                                     std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                                                                     DecomposeOptions const& options)
+{
+    std::vector<BasicIndexList<Index>> result;
+    decompose(pointList, simplePolygon, holeList, fixedEdges, result, options);
+    return result;
+}
+
+template class decomp::BasicDecomposer<std::uint16_t>;
+template class decomp::BasicDecomposer<std::uint32_t>;
+
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointList const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FloatPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FixedPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(IntegerPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointList const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FloatPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FixedPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(IntegerPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointList const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FloatPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FixedPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(IntegerPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                std::vector<IndexList>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointList const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FloatPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FixedPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(IntegerPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                std::vector<IndexList32>&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointList const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FloatPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FixedPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(IntegerPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointList const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FloatPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FixedPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(IntegerPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointList const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FloatPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(PointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(FixedPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint16_t>::decompose(IntegerPointView const&,
+                                                                IndexList const&,
+                                                                std::vector<IndexList> const&,
+                                                                std::vector<EdgeID> const&,
+                                                                PolygonSink&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointList const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FloatPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(PointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(FixedPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
+template void decomp::BasicDecomposer<std::uint32_t>::decompose(IntegerPointView const&,
+                                                                IndexList32 const&,
+                                                                std::vector<IndexList32> const&,
+                                                                std::vector<EdgeID32> const&,
+                                                                PolygonSink32&,
+                                                                PolygonAdjacency&,
+                                                                DecomposeOptions const&);
@@ -0,0 +1,103 @@
+#ifndef LIB_DECOMP_DECOMPOSER
+#define LIB_DECOMP_DECOMPOSER
+
+#include "convex_decomposition.hpp"
+
+namespace decomp
+{
+
+/** Reusable workspace for repeated calls to decompose.
+    All temporary storage is taken from an arena that is kept between calls, and the intermediate
+    polygon, triangles and half-edge mesh keep their memory as well. Once warmed up on inputs of a given
+    size, a decomposition does not allocate at all, except to grow the result.
+    An instance must not be used from multiple threads at once.
+ */
+template <class Index> class BasicDecomposer
+{
+public:
+    /** The arena gets its memory from the given upstream resource, which needs to outlive this object.
+     */
+    explicit BasicDecomposer(MemoryResource& upstream = newDeleteResource());
+
+    BasicDecomposer(BasicDecomposer const&) = delete;
+    BasicDecomposer& operator=(BasicDecomposer const&) = delete;
+
+    /** Same as the free function decompose, but write into the given result. Existing polygons
+        in the result are reused, so passing in the same result each time avoids reallocating them.
+        The triangulator selected in the options uses the arena as well.
+     */
+    template <class Points>
+    void decompose(Points const& pointList,
+                   BasicIndexList<Index> const& simplePolygon,
+                   std::vector<BasicIndexList<Index>> const& holeList,
+                   std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                   std::vector<BasicIndexList<Index>>& result,
+                   DecomposeOptions const& options = {});
+
+    std::vector<BasicIndexList<Index>> decompose(PointList const& pointList,
+                                                 BasicIndexList<Index> const& simplePolygon,
+                                                 std::vector<BasicIndexList<Index>> const& holeList = {},
+                                                 std::vector<BasicEdgeID<Index>> const& fixedEdges = {},
+                                                 DecomposeOptions const& options = {});
+
+    /** Same as the result-writing overload above, but also write the adjacency of the polygons.
+        The adjacency keeps its memory between calls as well.
+     */
+    template <class Points>
+    void decompose(Points const& pointList,
+                   BasicIndexList<Index> const& simplePolygon,
+                   std::vector<BasicIndexList<Index>> const& holeList,
+                   std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                   std::vector<BasicIndexList<Index>>& result,
+                   PolygonAdjacency& adjacency,
+                   DecomposeOptions const& options = {});
+
+    /** Same as the result-writing overloads above, but pass the polygons to the given sink instead.
+        Together with a BasicBufferSink, a warmed-up decomposition does not allocate at all.
+     */
+    template <class Points>
+    void decompose(Points const& pointList,
+                   BasicIndexList<Index> const& simplePolygon,
+                   std::vector<BasicIndexList<Index>> const& holeList,
+                   std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                   BasicPolygonSink<Index>& sink,
+                   DecomposeOptions const& options = {});
+
+    template <class Points>
+    void decompose(Points const& pointList,
+                   BasicIndexList<Index> const& simplePolygon,
+                   std::vector<BasicIndexList<Index>> const& holeList,
+                   std::vector<BasicEdgeID<Index>> const& fixedEdges,
+                   BasicPolygonSink<Index>& sink,
+                   PolygonAdjacency& adjacency,
+                   DecomposeOptions const& options = {});
+
+    /** Memory currently held for temporary storage.
+     */
+    std::size_t scratchCapacity() const
+    {
+        return mArena.capacity();
+    }
+
+private:
+    template <class Points, class Result>
+    void run(Points const& pointList,
+             BasicIndexList<Index> const& simplePolygon,
+             std::vector<BasicIndexList<Index>> const& holeList,
+             std::vector<BasicEdgeID<Index>> const& fixedEdges,
+             Result& result,
+             PolygonAdjacency* adjacency,
+             DecomposeOptions const& options);
+
+    ArenaResource mArena;
+    BasicIndexList<Index> mSimplePolygon;
+    BasicIndexList<Index> mTriangleList;
+    BasicHalfEdgeMesh<Index> mMesh;
+};
+
+using Decomposer = BasicDecomposer<std::uint16_t>;
+using Decomposer32 = BasicDecomposer<std::uint32_t>;
+
+} // namespace decomp
+
+#endif
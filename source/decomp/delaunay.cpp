@@ -0,0 +1,776 @@
+#include "delaunay.hpp"
+#include "predicates.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+using namespace decomp;
+
+namespace
+{
+
+using SlotList = ScratchVector<std::uint32_t>;
+
+std::uint32_t const none = ~std::uint32_t(0);
+
+// Lexicographic order, by x and then by y
+template <class P> bool isLess(P const& lhs, P const& rhs)
+{
+    return lhs[0] < rhs[0] || (lhs[0] == rhs[0] && lhs[1] < rhs[1]);
+}
+
+// Whether p is strictly between a and b, for three points on a common line
+template <class P> bool isBetween(P const& a, P const& b, P const& p)
+{
+    int const axis = a[0] != b[0] ? 0 : 1;
+    return (a[axis] < p[axis] && p[axis] < b[axis]) || (b[axis] < p[axis] && p[axis] < a[axis]);
+}
+
+// Constrained Delaunay triangulation in three steps:
+// - the Delaunay triangulation of the vertices of all rings, by divide and conquer after Guibas and Stolfi,
+//   "Primitives for the Manipulation of General Subdivisions and the Computation of Voronoi Diagrams",
+// - the edges of the rings, each inserted by retriangulating the triangles that it crosses, see retriangulate,
+// - the triangles inside the polygon, found by flooding from the outside and toggling at each ring edge.
+// All vertices of all rings are stored in slots, and the edge from a slot to the next one in its ring is
+// named by the same slot. P is the point type the predicates compute with, see exactPoint.
+template <class P> class DelaunayBuilder
+{
+public:
+    DelaunayBuilder(std::size_t size, MemoryResource& resource)
+    : mPointList(resource)
+    , mIndexList(resource)
+    , mNextList(resource)
+    , mVertexList(resource)
+    , mOnextList(resource)
+    , mOriginList(resource)
+    , mFreeList(resource)
+    , mTriangleVertexList(resource)
+    , mPartnerList(resource)
+    , mFixedList(resource)
+    , mVertexEdgeList(resource)
+    , mQueue(resource)
+    , mCavityList(resource)
+    , mLeftList(resource)
+    , mRightList(resource)
+    , mBoundaryList(resource)
+    , mPartList(resource)
+    {
+        mPointList.reserve(size);
+        mIndexList.reserve(size);
+        mNextList.reserve(size);
+    }
+
+    template <class Points, class Index> void addRing(Points const& pointList, BasicIndexList<Index> const& ring)
+    {
+        auto first = static_cast<std::uint32_t>(mIndexList.size());
+        auto N = static_cast<std::uint32_t>(ring.size());
+        for (std::uint32_t i = 0; i < N; ++i)
+        {
+            mPointList.push_back(exactPoint(pointList, ring[i]));
+            mIndexList.push_back(ring[i]);
+            mNextList.push_back(first + (i + 1) % N);
+        }
+    }
+
+    template <class Index> void triangulate(BasicIndexList<Index>& result)
+    {
+        if (!triangulateVertices())
+            return;
+
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        for (std::uint32_t slot = 0; slot < N; ++slot)
+            insertSegment(mVertexList[slot], mVertexList[mNextList[slot]]);
+
+        extractTriangles(result);
+    }
+
+private:
+    // Edge of the triangles crossed by a new segment, with the triangle on its other side
+    struct BoundaryEdge
+    {
+        std::uint32_t from, to, partner;
+        std::uint8_t fixed;
+    };
+
+    // Polygon from a to b, and then along the vertices of a chain in [first, last) back to a
+    struct Part
+    {
+        std::uint32_t a, b, first, last;
+    };
+
+    // Quad-edges: edge e belongs to quad-edge e / 4 and is rotated by e % 4 quarter turns.
+    // Only the even rotations are edges between vertices, the odd ones are between faces.
+    static std::uint32_t rot(std::uint32_t e)
+    {
+        return (e & ~3u) | ((e + 1) & 3u);
+    }
+
+    static std::uint32_t sym(std::uint32_t e)
+    {
+        return (e & ~3u) | ((e + 2) & 3u);
+    }
+
+    static std::uint32_t rotInv(std::uint32_t e)
+    {
+        return (e & ~3u) | ((e + 3) & 3u);
+    }
+
+    std::uint32_t onext(std::uint32_t e) const
+    {
+        return mOnextList[e];
+    }
+
+    std::uint32_t oprev(std::uint32_t e) const
+    {
+        return rot(onext(rot(e)));
+    }
+
+    std::uint32_t lnext(std::uint32_t e) const
+    {
+        return rot(onext(rotInv(e)));
+    }
+
+    std::uint32_t rprev(std::uint32_t e) const
+    {
+        return onext(sym(e));
+    }
+
+    std::uint32_t org(std::uint32_t e) const
+    {
+        return mOriginList[e];
+    }
+
+    std::uint32_t dest(std::uint32_t e) const
+    {
+        return mOriginList[sym(e)];
+    }
+
+    P const& point(std::uint32_t vertex) const
+    {
+        return mPointList[vertex];
+    }
+
+    bool isLeftOf(std::uint32_t vertex, std::uint32_t e) const
+    {
+        return orient2d(point(vertex), point(org(e)), point(dest(e))) > 0;
+    }
+
+    bool isRightOf(std::uint32_t vertex, std::uint32_t e) const
+    {
+        return orient2d(point(vertex), point(dest(e)), point(org(e))) > 0;
+    }
+
+    bool isInCircle(std::uint32_t a, std::uint32_t b, std::uint32_t c, std::uint32_t d) const
+    {
+        return incircle(point(a), point(b), point(c), point(d)) > 0;
+    }
+
+    std::uint32_t makeEdge(std::uint32_t from, std::uint32_t to)
+    {
+        std::uint32_t e;
+        if (!mFreeList.empty())
+        {
+            e = mFreeList.back();
+            mFreeList.pop_back();
+        }
+        else
+        {
+            e = static_cast<std::uint32_t>(mOnextList.size());
+            mOnextList.resize(e + 4);
+            mOriginList.resize(e + 4, none);
+        }
+
+        mOnextList[e] = e;
+        mOnextList[e + 1] = e + 3;
+        mOnextList[e + 2] = e + 2;
+        mOnextList[e + 3] = e + 1;
+        mOriginList[e] = from;
+        mOriginList[e + 2] = to;
+        return e;
+    }
+
+    void splice(std::uint32_t a, std::uint32_t b)
+    {
+        auto alpha = rot(onext(a));
+        auto beta = rot(onext(b));
+        std::swap(mOnextList[a], mOnextList[b]);
+        std::swap(mOnextList[alpha], mOnextList[beta]);
+    }
+
+    // New edge from the destination of a to the origin of b, with the left faces of a and b on its left
+    std::uint32_t connect(std::uint32_t a, std::uint32_t b)
+    {
+        auto e = makeEdge(dest(a), org(b));
+        splice(e, lnext(a));
+        splice(sym(e), b);
+        return e;
+    }
+
+    void deleteEdge(std::uint32_t e)
+    {
+        splice(e, oprev(e));
+        splice(sym(e), oprev(sym(e)));
+        mOriginList[e & ~3u] = none;
+        mFreeList.push_back(e & ~3u);
+    }
+
+    // Delaunay triangulation of the sorted vertices [first, last), at least two of them. Returns the counter-clockwise
+    // convex hull edge out of the leftmost vertex, and the clockwise one out of the rightmost vertex.
+    std::pair<std::uint32_t, std::uint32_t> triangulate(std::uint32_t const* first, std::uint32_t const* last)
+    {
+        auto count = last - first;
+        if (count == 2)
+        {
+            auto a = makeEdge(first[0], first[1]);
+            return { a, sym(a) };
+        }
+
+        if (count == 3)
+        {
+            auto a = makeEdge(first[0], first[1]);
+            auto b = makeEdge(first[1], first[2]);
+            splice(sym(a), b);
+
+            auto orientation = orient2d(point(first[0]), point(first[1]), point(first[2]));
+            if (orientation > 0)
+            {
+                connect(b, a);
+                return { a, sym(b) };
+            }
+            if (orientation < 0)
+            {
+                auto c = connect(b, a);
+                return { sym(c), c };
+            }
+            return { a, sym(b) };
+        }
+
+        auto middle = first + count / 2;
+        auto left = triangulate(first, middle);
+        auto right = triangulate(middle, last);
+        auto ldo = left.first, ldi = left.second;
+        auto rdi = right.first, rdo = right.second;
+
+        // Lower common tangent of the two halves
+        for (;;)
+        {
+            if (isLeftOf(org(rdi), ldi))
+                ldi = lnext(ldi);
+            else if (isRightOf(org(ldi), rdi))
+                rdi = rprev(rdi);
+            else
+                break;
+        }
+
+        auto basel = connect(sym(rdi), ldi);
+        if (org(ldi) == org(ldo))
+            ldo = sym(basel);
+        if (org(rdi) == org(rdo))
+            rdo = basel;
+
+        // Zip the halves together from the bottom up
+        for (;;)
+        {
+            auto lcand = onext(sym(basel));
+            bool lvalid = isRightOf(dest(lcand), basel);
+            if (lvalid)
+            {
+                while (isInCircle(dest(basel), org(basel), dest(lcand), dest(onext(lcand))))
+                {
+                    auto next = onext(lcand);
+                    deleteEdge(lcand);
+                    lcand = next;
+                }
+            }
+
+            auto rcand = oprev(basel);
+            bool rvalid = isRightOf(dest(rcand), basel);
+            if (rvalid)
+            {
+                while (isInCircle(dest(basel), org(basel), dest(rcand), dest(oprev(rcand))))
+                {
+                    auto next = oprev(rcand);
+                    deleteEdge(rcand);
+                    rcand = next;
+                }
+            }
+
+            lvalid = isRightOf(dest(lcand), basel);
+            rvalid = isRightOf(dest(rcand), basel);
+            if (!lvalid && !rvalid)
+                break;
+
+            if (!lvalid || (rvalid && isInCircle(dest(lcand), org(lcand), org(rcand), dest(rcand))))
+                basel = connect(rcand, sym(basel));
+            else
+                basel = connect(sym(basel), sym(lcand));
+        }
+
+        return { ldo, rdo };
+    }
+
+    // Triangle meshes: the half-edges of triangle t are stored at 3t, 3t+1 and 3t+2 in counter-clockwise order,
+    // like in BasicHalfEdgeMesh. Each edge of the convex hull has a ghost triangle on its outside, whose third
+    // vertex is none, so every half-edge has a partner.
+    static std::uint32_t next(std::uint32_t e)
+    {
+        return (e % 3 == 2) ? e - 2 : e + 1;
+    }
+
+    static std::uint32_t prev(std::uint32_t e)
+    {
+        return (e % 3 == 0) ? e + 2 : e - 1;
+    }
+
+    std::uint32_t vertex(std::uint32_t e) const
+    {
+        return mTriangleVertexList[e];
+    }
+
+    void link(std::uint32_t e, std::uint32_t f)
+    {
+        mPartnerList[e] = f;
+        mPartnerList[f] = e;
+    }
+
+    std::uint32_t addTriangle(std::uint32_t a, std::uint32_t b, std::uint32_t c)
+    {
+        auto e = static_cast<std::uint32_t>(mTriangleVertexList.size());
+        mTriangleVertexList.push_back(a);
+        mTriangleVertexList.push_back(b);
+        mTriangleVertexList.push_back(c);
+        mPartnerList.resize(e + 3, none);
+        mFixedList.resize(e + 3, false);
+        return e;
+    }
+
+    // Give each set of equal points one vertex, and triangulate the vertices. Returns false if they are all on a line.
+    bool triangulateVertices()
+    {
+        auto N = static_cast<std::uint32_t>(mPointList.size());
+        SlotList sortedList(N, 0, mQueue.get_allocator());
+        for (std::uint32_t slot = 0; slot < N; ++slot)
+            sortedList[slot] = slot;
+        std::sort(sortedList.begin(), sortedList.end(), [this](std::uint32_t lhs, std::uint32_t rhs) {
+            return isLess(point(lhs), point(rhs)) || (!isLess(point(rhs), point(lhs)) && lhs < rhs);
+        });
+
+        mVertexList.assign(N, none);
+        std::uint32_t uniqueCount = 0;
+        for (std::uint32_t i = 0; i < N; ++i)
+        {
+            auto slot = sortedList[i];
+            if (uniqueCount > 0 && !isLess(point(sortedList[uniqueCount - 1]), point(slot)))
+            {
+                mVertexList[slot] = sortedList[uniqueCount - 1];
+                continue;
+            }
+            mVertexList[slot] = slot;
+            sortedList[uniqueCount++] = slot;
+        }
+
+        std::uint32_t apex = 2;
+        while (apex < uniqueCount && orient2d(point(sortedList[0]), point(sortedList[1]), point(sortedList[apex])) == 0)
+            ++apex;
+        if (apex >= uniqueCount)
+            return false;
+
+        mOnextList.reserve(uniqueCount * 12);
+        mOriginList.reserve(uniqueCount * 12);
+        auto hull = triangulate(sortedList.data(), sortedList.data() + uniqueCount);
+        buildTriangles(hull.first);
+        return true;
+    }
+
+    // Convert the quad-edges to triangles. The left face of each edge is either a triangle, or the outside of the
+    // convex hull, which is on the left of the hull edges in clockwise order.
+    void buildTriangles(std::uint32_t hullEdge)
+    {
+        auto edgeCount = static_cast<std::uint32_t>(mOnextList.size());
+        SlotList slotList(edgeCount, none, mQueue.get_allocator());
+
+        // Ghost triangles first, on the left of the clockwise hull
+        auto start = sym(hullEdge);
+        auto e = start;
+        do
+        {
+            slotList[e] = addTriangle(org(e), dest(e), none);
+            e = lnext(e);
+        } while (e != start);
+
+        for (std::uint32_t quad = 0; quad < edgeCount; quad += 4)
+        {
+            if (mOriginList[quad] == none)
+                continue;
+
+            for (auto side : { quad, quad + 2 })
+            {
+                if (slotList[side] != none)
+                    continue;
+
+                auto t = addTriangle(org(side), dest(side), dest(lnext(side)));
+                slotList[side] = t;
+                slotList[lnext(side)] = t + 1;
+                slotList[lnext(lnext(side))] = t + 2;
+            }
+        }
+
+        // Partners across the edges, and between neighboring ghost triangles
+        e = start;
+        do
+        {
+            auto slot = slotList[e];
+            link(slot, slotList[sym(e)]);
+            link(slot + 1, slotList[lnext(e)] + 2);
+            e = lnext(e);
+        } while (e != start);
+
+        for (std::uint32_t quad = 0; quad < edgeCount; quad += 4)
+        {
+            if (mOriginList[quad] != none)
+                link(slotList[quad], slotList[quad + 2]);
+        }
+
+        mVertexEdgeList.assign(mPointList.size(), none);
+        auto halfEdgeCount = static_cast<std::uint32_t>(mTriangleVertexList.size());
+        for (std::uint32_t slot = 0; slot < halfEdgeCount; ++slot)
+        {
+            if (vertex(slot) != none)
+                mVertexEdgeList[vertex(slot)] = slot;
+        }
+    }
+
+    // Half-edge from a to b, or none if there is no such edge
+    std::uint32_t findEdge(std::uint32_t a, std::uint32_t b) const
+    {
+        auto start = mVertexEdgeList[a];
+        auto e = start;
+        do
+        {
+            if (vertex(next(e)) == b)
+                return e;
+            e = mPartnerList[prev(e)];
+        } while (e != start);
+        return none;
+    }
+
+    void markFixed(std::uint32_t e)
+    {
+        mFixedList[e] = true;
+        mFixedList[mPartnerList[e]] = true;
+    }
+
+    // Make the segment from a to b an edge of the triangulation, and mark it as fixed
+    void insertSegment(std::uint32_t a, std::uint32_t b)
+    {
+        while (a != b)
+            a = insertSegmentPart(a, b);
+    }
+
+    // Insert the segment from a to b up to the first vertex on it, and return that vertex
+    std::uint32_t insertSegmentPart(std::uint32_t a, std::uint32_t b)
+    {
+        auto existing = findEdge(a, b);
+        if (existing != none)
+        {
+            markFixed(existing);
+            return b;
+        }
+
+        // Find the edge opposite of a that the segment leaves its first triangle through, or a vertex on the segment
+        auto start = mVertexEdgeList[a];
+        auto e = start;
+        auto crossing = none;
+        do
+        {
+            auto c = vertex(next(e));
+            auto d = vertex(prev(e));
+            if (c != none && d != none)
+            {
+                auto sideC = orient2d(point(a), point(b), point(c));
+                if (sideC == 0 && isBetween(point(a), point(b), point(c)))
+                {
+                    markFixed(e);
+                    return c;
+                }
+                if (sideC < 0 && orient2d(point(a), point(b), point(d)) > 0)
+                {
+                    crossing = next(e);
+                    break;
+                }
+            }
+            e = mPartnerList[prev(e)];
+        } while (e != start);
+
+        if (crossing == none)
+            throw std::invalid_argument("Polygon edges intersect or overlap");
+
+        // Walk along the segment, and collect the edges crossing it, each from its right to its left side
+        mQueue.clear();
+        auto end = b;
+        for (;;)
+        {
+            if (mFixedList[crossing])
+                throw std::invalid_argument("Polygon edges intersect");
+            mQueue.push_back(crossing);
+
+            auto f = mPartnerList[crossing];
+            auto opposite = vertex(prev(f));
+            if (opposite == b)
+                break;
+
+            auto side = orient2d(point(a), point(b), point(opposite));
+            if (side == 0)
+            {
+                end = opposite;
+                break;
+            }
+            crossing = side > 0 ? next(f) : prev(f);
+        }
+
+        retriangulate(a, end);
+        markFixed(findEdge(a, end));
+        return end;
+    }
+
+    // Replace the triangles crossed by the segment from a to b with the constrained Delaunay triangulations of the
+    // polygons on either side of it, after Anglada, "An improved incremental algorithm for constructing restricted
+    // Delaunay triangulations". There are as many triangles as before, so they keep their storage.
+    void retriangulate(std::uint32_t a, std::uint32_t b)
+    {
+        mCavityList.clear();
+        mLeftList.clear();
+        mRightList.clear();
+        mCavityList.push_back(mQueue.front() / 3);
+        for (auto e : mQueue)
+        {
+            mCavityList.push_back(mPartnerList[e] / 3);
+            if (mRightList.empty() || mRightList.back() != vertex(e))
+                mRightList.push_back(vertex(e));
+            if (mLeftList.empty() || mLeftList.back() != vertex(next(e)))
+                mLeftList.push_back(vertex(next(e)));
+        }
+
+        mBoundaryList.clear();
+        for (auto t : mCavityList)
+        {
+            for (std::uint32_t e = 3 * t; e < 3 * t + 3; ++e)
+            {
+                auto partner = mPartnerList[e];
+                if (std::find(mCavityList.begin(), mCavityList.end(), partner / 3) == mCavityList.end())
+                    mBoundaryList.push_back({ vertex(e), vertex(next(e)), partner, mFixedList[e] });
+            }
+        }
+
+        mTriangleCount = 0;
+        std::reverse(mLeftList.begin(), mLeftList.end());
+        triangulatePseudoPolygon(a, b, mLeftList);
+        triangulatePseudoPolygon(b, a, mRightList);
+
+        for (auto t : mCavityList)
+        {
+            for (std::uint32_t e = 3 * t; e < 3 * t + 3; ++e)
+            {
+                auto from = vertex(e), to = vertex(next(e));
+                mVertexEdgeList[from] = e;
+                mFixedList[e] = false;
+
+                auto boundary = std::find_if(mBoundaryList.begin(), mBoundaryList.end(), [&](BoundaryEdge const& edge) {
+                    return edge.from == from && edge.to == to;
+                });
+                if (boundary != mBoundaryList.end())
+                {
+                    link(e, boundary->partner);
+                    mFixedList[e] = boundary->fixed;
+                    continue;
+                }
+
+                for (auto other : mCavityList)
+                {
+                    for (std::uint32_t f = 3 * other; f < 3 * other + 3; ++f)
+                    {
+                        if (vertex(f) == to && vertex(next(f)) == from)
+                            link(e, f);
+                    }
+                }
+            }
+        }
+    }
+
+    // Triangulate the polygon from a to b, and then along the chain back to a, where all of the chain is visible from
+    // the edge ab. The vertex of the chain whose circle through a and b is empty forms a triangle with them, which
+    // splits off the two parts of the chain before and after it.
+    void triangulatePseudoPolygon(std::uint32_t a, std::uint32_t b, SlotList const& chain)
+    {
+        mPartList.clear();
+        mPartList.push_back({ a, b, 0, static_cast<std::uint32_t>(chain.size()) });
+        while (!mPartList.empty())
+        {
+            auto part = mPartList.back();
+            mPartList.pop_back();
+            if (part.first == part.last)
+                continue;
+
+            auto apex = part.first;
+            for (auto i = part.first + 1; i < part.last; ++i)
+            {
+                if (isInCircle(part.a, part.b, chain[apex], chain[i]))
+                    apex = i;
+            }
+
+            auto c = chain[apex];
+            auto t = 3 * mCavityList[mTriangleCount++];
+            mTriangleVertexList[t] = part.a;
+            mTriangleVertexList[t + 1] = part.b;
+            mTriangleVertexList[t + 2] = c;
+            mPartList.push_back({ c, part.b, part.first, apex });
+            mPartList.push_back({ part.a, c, apex + 1, part.last });
+        }
+    }
+
+    // Flood the triangles from the ghost triangles, and toggle between outside and inside at each fixed edge
+    template <class Index> void extractTriangles(BasicIndexList<Index>& result)
+    {
+        auto triangleCount = static_cast<std::uint32_t>(mTriangleVertexList.size() / 3);
+        ScratchVector<std::uint8_t> stateList(triangleCount, 0, mQueue.get_allocator());
+        std::uint8_t const unvisited = 0, outside = 1, inside = 2;
+
+        mQueue.clear();
+        for (std::uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (vertex(3 * t + 2) != none)
+                break;
+            stateList[t] = outside;
+            mQueue.push_back(t);
+        }
+
+        for (std::size_t i = 0; i < mQueue.size(); ++i)
+        {
+            auto t = mQueue[i];
+            for (std::uint32_t e = 3 * t; e < 3 * t + 3; ++e)
+            {
+                auto neighbor = mPartnerList[e] / 3;
+                if (stateList[neighbor] != unvisited)
+                    continue;
+
+                bool toggle = mFixedList[e] != 0;
+                stateList[neighbor] = (stateList[t] == inside) != toggle ? inside : outside;
+                mQueue.push_back(neighbor);
+            }
+        }
+
+        for (std::uint32_t t = 0; t < triangleCount; ++t)
+        {
+            if (stateList[t] != inside)
+                continue;
+            for (std::uint32_t e = 3 * t; e < 3 * t + 3; ++e)
+                result.push_back(static_cast<Index>(mIndexList[vertex(e)]));
+        }
+    }
+
+    ScratchVector<P> mPointList;
+    ScratchVector<std::size_t> mIndexList;
+    SlotList mNextList;
+
+    // Slot of the first of the equal points for each slot, which stands for all of them
+    SlotList mVertexList;
+
+    SlotList mOnextList;
+    SlotList mOriginList;
+    SlotList mFreeList;
+
+    SlotList mTriangleVertexList;
+    SlotList mPartnerList;
+    ScratchVector<std::uint8_t> mFixedList;
+    SlotList mVertexEdgeList;
+
+    SlotList mQueue;
+    SlotList mCavityList;
+    SlotList mLeftList;
+    SlotList mRightList;
+    ScratchVector<BoundaryEdge> mBoundaryList;
+    ScratchVector<Part> mPartList;
+    std::uint32_t mTriangleCount = 0;
+};
+
+template <class Points, class Index>
+void constrainedDelaunayImpl(Points const& pointList,
+                             BasicIndexList<Index> const& polygon,
+                             std::vector<BasicIndexList<Index>> const& holeList,
+                             BasicIndexList<Index>& result,
+                             MemoryResource& resource)
+{
+    if (polygon.size() < 3)
+        throw std::invalid_argument("Polygon needs at least 3 vertices");
+
+    std::size_t vertexCount = polygon.size(), ringCount = 1;
+    for (auto const& hole : holeList)
+    {
+        if (hole.empty())
+            continue;
+        if (hole.size() < 3)
+            throw std::invalid_argument("Holes need at least 3 vertices");
+        vertexCount += hole.size();
+        ++ringCount;
+    }
+
+    using ExactPoint = decltype(exactPoint(pointList, std::size_t()));
+    DelaunayBuilder<ExactPoint> builder(vertexCount, resource);
+    builder.addRing(pointList, polygon);
+    for (auto const& hole : holeList)
+    {
+        if (!hole.empty())
+            builder.addRing(pointList, hole);
+    }
+
+    // Each hole adds two triangles
+    result.clear();
+    result.reserve((vertexCount + 2 * ringCount - 4) * 3);
+    builder.triangulate(result);
+}
+
+} // namespace
+
+template <class Index>
+BasicIndexList<Index> decomp::constrainedDelaunay(PointList const& pointList,
+                                                  BasicIndexList<Index> const& polygon,
+                                                  std::vector<BasicIndexList<Index>> const& holeList)
+{
+    BasicIndexList<Index> result;
+    constrainedDelaunay(pointList, polygon, holeList, result, newDeleteResource());
+    return result;
+}
+
+template <class Points, class Index>
+void decomp::constrainedDelaunay(Points const& pointList,
+                                 BasicIndexList<Index> const& polygon,
+                                 std::vector<BasicIndexList<Index>> const& holeList,
+                                 BasicIndexList<Index>& result,
+                                 MemoryResource& resource)
+{
+    constrainedDelaunayImpl(pointList, polygon, holeList, result, resource);
+}
+
+template IndexList decomp::constrainedDelaunay(PointList const&, IndexList const&, std::vector<IndexList> const&);
+template IndexList32
+decomp::constrainedDelaunay(PointList const&, IndexList32 const&, std::vector<IndexList32> const&);
+template void decomp::constrainedDelaunay(
+    PointList const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    PointList const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    FloatPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    FloatPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    PointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    PointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    FixedPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    FixedPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    IntegerPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::constrainedDelaunay(
+    IntegerPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
@@ -0,0 +1,42 @@
+#ifndef LIB_DECOMP_DELAUNAY
+#define LIB_DECOMP_DELAUNAY
+
+#include "convex_decomposition.hpp"
+
+namespace decomp
+{
+
+/** Constrained Delaunay triangulation of a simple polygon with simple holes, where the edges of the polygon
+    and the holes are the constraints. Among all triangulations of the polygon, this maximizes the smallest angle,
+    so the triangles do not need to be refined with edgeFlip anymore.
+    The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
+    Like monotoneTriangulation, this takes the holes directly, and has the same requirements on its input.
+    The vertices are triangulated by divide and conquer in O(n log n) time, and then each edge of the polygon and
+    the holes is inserted by retriangulating the triangles it crosses. That takes time proportional to the number
+    of crossed triangles, which is small for typical polygons, but can be O(n^2) in total for contrived ones.
+    Edges that cross each other throw std::invalid_argument.
+ */
+template <class Index>
+BasicIndexList<Index> constrainedDelaunay(PointList const& pointList,
+                                          BasicIndexList<Index> const& polygon,
+                                          std::vector<BasicIndexList<Index>> const& holeList = {});
+
+inline IndexList
+constrainedDelaunay(PointList const& pointList, IndexList const& polygon, std::vector<IndexList> const& holeList = {})
+{
+    return constrainedDelaunay<std::uint16_t>(pointList, polygon, holeList);
+}
+
+/** Same as above, but write into the given result to reuse its memory, and take all
+    temporary storage from the given resource.
+ */
+template <class Points, class Index>
+void constrainedDelaunay(Points const& pointList,
+                         BasicIndexList<Index> const& polygon,
+                         std::vector<BasicIndexList<Index>> const& holeList,
+                         BasicIndexList<Index>& result,
+                         MemoryResource& resource);
+
+} // namespace decomp
+
+#endif
@@ -0,0 +1,461 @@
+#include "dynamic.hpp"
+#include "operations.hpp"
+#include "predicates.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <unordered_set>
+
+using namespace decomp;
+
+namespace
+{
+
+double const pi = 3.14159265358979323846;
+
+std::uint64_t edgeKey(std::uint32_t from, std::uint32_t to)
+{
+    return static_cast<std::uint64_t>(from) << 32 | to;
+}
+
+// For p on the line through a and b
+bool isOnSegment(Point const& a, Point const& b, Point const& p)
+{
+    return std::min(a.x(), b.x()) <= p.x() && p.x() <= std::max(a.x(), b.x()) && std::min(a.y(), b.y()) <= p.y() &&
+           p.y() <= std::max(a.y(), b.y());
+}
+
+// Whether the segments ab and cd have any point in common
+bool segmentsTouch(Point const& a, Point const& b, Point const& c, Point const& d)
+{
+    auto o1 = orient2d(a, b, c);
+    auto o2 = orient2d(a, b, d);
+    auto o3 = orient2d(c, d, a);
+    auto o4 = orient2d(c, d, b);
+
+    if (((o1 > 0.0 && o2 < 0.0) || (o1 < 0.0 && o2 > 0.0)) && ((o3 > 0.0 && o4 < 0.0) || (o3 < 0.0 && o4 > 0.0)))
+        return true;
+
+    return (o1 == 0.0 && isOnSegment(a, b, c)) || (o2 == 0.0 && isOnSegment(a, b, d)) ||
+           (o3 == 0.0 && isOnSegment(c, d, a)) || (o4 == 0.0 && isOnSegment(c, d, b));
+}
+
+// Whether a convex polygon and an arbitrary simple polygon overlap or touch
+bool overlaps(PointList const& pointList, IndexList32 const& convex, IndexList32 const& polygon)
+{
+    auto const N = convex.size();
+    auto const M = polygon.size();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto const& a = pointList[convex[i]];
+        auto const& b = pointList[convex[(i + 1) % N]];
+        for (std::size_t j = 0; j < M; ++j)
+        {
+            if (segmentsTouch(a, b, pointList[polygon[j]], pointList[polygon[(j + 1) % M]]))
+                return true;
+        }
+    }
+
+    // Without touching edges, one is either inside the other or they are apart
+    auto const& p = pointList[polygon.front()];
+    bool inside = true;
+    for (std::size_t i = 0; i < N && inside; ++i)
+        inside = orient2d(pointList[convex[i]], pointList[convex[(i + 1) % N]], p) > 0.0;
+
+    return inside || containsPoint(pointList, polygon, pointList[convex.front()]);
+}
+
+// Directed edge on the outline of a union of polygons
+struct BoundaryEdge
+{
+    std::uint32_t from;
+    std::uint32_t to;
+};
+
+/** Split the outline of a union of polygons into loops.
+    Where the outline passes a vertex more than once, each loop takes the first outgoing edge clockwise from
+    the edge it came in on. That keeps loops from crossing each other, so they are simple polygons.
+ */
+std::vector<IndexList32> traceLoops(PointList const& pointList, std::vector<BoundaryEdge> edgeList)
+{
+    std::sort(edgeList.begin(), edgeList.end(), [](BoundaryEdge const& lhs, BoundaryEdge const& rhs) {
+        return lhs.from < rhs.from || (lhs.from == rhs.from && lhs.to < rhs.to);
+    });
+
+    std::vector<bool> used(edgeList.size(), false);
+    std::vector<IndexList32> result;
+    for (std::size_t first = 0; first < edgeList.size(); ++first)
+    {
+        if (used[first])
+            continue;
+
+        IndexList32 loop;
+        auto current = first;
+        do
+        {
+            used[current] = true;
+            auto const& edge = edgeList[current];
+            loop.push_back(edge.from);
+
+            auto byStart = [](BoundaryEdge const& lhs, BoundaryEdge const& rhs) { return lhs.from < rhs.from; };
+            auto range = std::equal_range(edgeList.begin(), edgeList.end(), BoundaryEdge{ edge.to, 0 }, byStart);
+
+            auto const& v = pointList[edge.to];
+            auto back = pointList[edge.from] - v;
+            auto next = edgeList.size();
+            double nextAngle = 0.0;
+            for (auto i = range.first; i != range.second; ++i)
+            {
+                auto index = static_cast<std::size_t>(i - edgeList.begin());
+                if (used[index] && index != first)
+                    continue;
+
+                // Clockwise angle from the way back to this edge
+                auto out = pointList[i->to] - v;
+                auto angle = std::atan2(back.x() * out.y() - back.y() * out.x(), dot(back, out));
+                if (angle <= 0.0)
+                    angle += 2.0 * pi;
+                angle = 2.0 * pi - angle;
+                if (angle == 0.0)
+                    angle = 2.0 * pi;
+
+                if (next == edgeList.size() || angle < nextAngle)
+                {
+                    next = index;
+                    nextAngle = angle;
+                }
+            }
+
+            if (next == edgeList.size())
+                throw std::invalid_argument("Outline is not closed");
+            current = next;
+        } while (current != first);
+
+        result.push_back(std::move(loop));
+    }
+    return result;
+}
+
+} // namespace
+
+DynamicDecomposition::DynamicDecomposition(PointList pointList,
+                                           IndexList32 simplePolygon,
+                                           std::vector<IndexList32> holeList,
+                                           DecomposeOptions const& options)
+: mPointList(std::move(pointList))
+, mSimplePolygon(std::move(simplePolygon))
+, mObstacleList(std::move(holeList))
+, mOptions(options)
+{
+    rebuild();
+}
+
+std::uint32_t DynamicDecomposition::addObstacle(PointList const& outline)
+{
+    if (outline.size() < 3)
+        throw std::invalid_argument("Obstacle needs at least three points");
+
+    // Reuse the points and ids of removed obstacles
+    IndexList32 hole;
+    for (auto const& p : outline)
+    {
+        if (!mFreePointList.empty())
+        {
+            hole.push_back(mFreePointList.back());
+            mFreePointList.pop_back();
+            mPointList[hole.back()] = p;
+        }
+        else
+        {
+            hole.push_back(static_cast<std::uint32_t>(mPointList.size()));
+            mPointList.push_back(p);
+        }
+    }
+
+    std::uint32_t obstacle;
+    if (!mFreeObstacleList.empty())
+    {
+        obstacle = mFreeObstacleList.back();
+        mFreeObstacleList.pop_back();
+        mObstacleList[obstacle] = hole;
+    }
+    else
+    {
+        obstacle = static_cast<std::uint32_t>(mObstacleList.size());
+        mObstacleList.push_back(hole);
+    }
+
+    try
+    {
+        if (signedArea(mPointList, hole) >= 0.0)
+            throw std::invalid_argument("Obstacle needs to be clockwise");
+
+        Point min(outline.front());
+        Point max(outline.front());
+        for (auto const& p : outline)
+        {
+            min = Point(std::min(min.x(), p.x()), std::min(min.y(), p.y()));
+            max = Point(std::max(max.x(), p.x()), std::max(max.y(), p.y()));
+        }
+
+        // Bounding boxes rule out most polygons cheaply
+        std::vector<std::uint32_t> touched;
+        for (std::uint32_t i = 0; i < mBoxList.size(); ++i)
+        {
+            auto const& box = mBoxList[i];
+            if (box.max.x() < min.x() || box.min.x() > max.x() || box.max.y() < min.y() || box.min.y() > max.y())
+                continue;
+            if (overlaps(mPointList, mPolygonList[i], hole))
+                touched.push_back(i);
+        }
+
+        if (touched.empty())
+            throw std::invalid_argument("Obstacle needs to be inside the free area");
+
+        update(std::move(touched), nullptr, &hole);
+    }
+    catch (...)
+    {
+        mObstacleList[obstacle].clear();
+        mFreeObstacleList.push_back(obstacle);
+        mFreePointList.insert(mFreePointList.end(), hole.rbegin(), hole.rend());
+        throw;
+    }
+
+    return obstacle;
+}
+
+void DynamicDecomposition::removeObstacle(std::uint32_t obstacle)
+{
+    if (obstacle >= mObstacleList.size() || mObstacleList[obstacle].empty())
+        throw std::out_of_range("No such obstacle");
+
+    auto hole = std::move(mObstacleList[obstacle]);
+    mObstacleList[obstacle].clear();
+
+    // All polygons using a vertex of the hole need to go, so its points are free afterwards.
+    // The polygons along the hole have its edges in the same direction, and from there,
+    // the others are found by walking around each vertex.
+    std::vector<std::uint32_t> touched;
+    auto const N = hole.size();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto const vertex = hole[i];
+        auto found = mEdgeMap.find(edgeKey(vertex, hole[(i + 1) % N]));
+        if (found == mEdgeMap.end())
+            continue;
+
+        auto const first = found->second;
+        auto current = first;
+        do
+        {
+            touched.push_back(current);
+            auto const& polygon = mPolygonList[current];
+            auto position = std::find(polygon.begin(), polygon.end(), vertex);
+            auto previous = position == polygon.begin() ? polygon.back() : *(position - 1);
+
+            found = mEdgeMap.find(edgeKey(vertex, previous));
+            if (found == mEdgeMap.end())
+                break;
+            current = found->second;
+        } while (current != first);
+    }
+
+    try
+    {
+        update(std::move(touched), &hole, nullptr);
+    }
+    catch (...)
+    {
+        mObstacleList[obstacle] = std::move(hole);
+        throw;
+    }
+
+    mFreeObstacleList.push_back(obstacle);
+    mFreePointList.insert(mFreePointList.end(), hole.rbegin(), hole.rend());
+}
+
+void DynamicDecomposition::update(std::vector<std::uint32_t> touched,
+                                  IndexList32 const* removedHole,
+                                  IndexList32 const* addedHole)
+{
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+
+    // The region to decompose again is the union of the touched polygons, and a removed hole.
+    // Its outline consists of the edges not shared between those.
+    std::vector<IndexList32 const*> faceList;
+    for (auto polygon : touched)
+        faceList.push_back(&mPolygonList[polygon]);
+
+    IndexList32 removedFace;
+    if (removedHole)
+    {
+        removedFace.assign(removedHole->rbegin(), removedHole->rend());
+        faceList.push_back(&removedFace);
+    }
+
+    std::unordered_set<std::uint64_t> edgeSet;
+    for (auto face : faceList)
+    {
+        for (std::size_t i = 0, N = face->size(); i < N; ++i)
+            edgeSet.insert(edgeKey((*face)[i], (*face)[(i + 1) % N]));
+    }
+
+    std::vector<BoundaryEdge> boundary;
+    for (auto face : faceList)
+    {
+        for (std::size_t i = 0, N = face->size(); i < N; ++i)
+        {
+            auto from = (*face)[i];
+            auto to = (*face)[(i + 1) % N];
+            if (edgeSet.count(edgeKey(to, from)) == 0)
+                boundary.push_back({ from, to });
+        }
+    }
+
+    // An added hole must not touch the outline, or it would reach outside of the region
+    if (addedHole)
+    {
+        auto const& hole = *addedHole;
+        for (std::size_t i = 0, N = hole.size(); i < N; ++i)
+        {
+            auto const& a = mPointList[hole[i]];
+            auto const& b = mPointList[hole[(i + 1) % N]];
+            for (auto const& edge : boundary)
+            {
+                if (segmentsTouch(a, b, mPointList[edge.from], mPointList[edge.to]))
+                    throw std::invalid_argument("Obstacle needs to be inside the free area");
+            }
+        }
+    }
+
+    std::vector<IndexList32> outerList;
+    std::vector<IndexList32> holeList;
+    for (auto& loop : traceLoops(mPointList, std::move(boundary)))
+    {
+        // Since the added hole does not touch any loop, a loop is either completely inside or outside of it.
+        // Inside means the obstacle encloses another one, which the holes of a polygon must not do.
+        if (addedHole && containsPoint(mPointList, *addedHole, mPointList[loop.front()]))
+            throw std::invalid_argument("Obstacle needs to be inside the free area");
+
+        auto area = signedArea(mPointList, loop);
+        if (area > 0.0)
+            outerList.push_back(std::move(loop));
+        else if (area < 0.0)
+            holeList.push_back(std::move(loop));
+    }
+
+    // Assign each hole to the outer loop containing it, testing a point that is not shared with any outer loop
+    std::vector<std::vector<IndexList32>> assignment(outerList.size());
+    auto assign = [&](IndexList32 const& hole, bool required) {
+        auto test = hole.front();
+        for (auto index : hole)
+        {
+            bool shared = false;
+            for (auto const& outer : outerList)
+                shared = shared || std::find(outer.begin(), outer.end(), index) != outer.end();
+            if (!shared)
+            {
+                test = index;
+                break;
+            }
+        }
+
+        for (std::size_t i = 0; i < outerList.size(); ++i)
+        {
+            if ((outerList.size() == 1 && !required) || containsPoint(mPointList, outerList[i], mPointList[test]))
+            {
+                assignment[i].push_back(hole);
+                return;
+            }
+        }
+
+        if (required)
+            throw std::invalid_argument("Obstacle needs to be inside the free area");
+    };
+
+    for (auto const& hole : holeList)
+        assign(hole, false);
+    if (addedHole)
+        assign(*addedHole, true);
+
+    std::vector<IndexList32> created;
+    try
+    {
+        for (std::size_t i = 0; i < outerList.size(); ++i)
+        {
+            mDecomposer.decompose(mPointList, outerList[i], assignment[i], {}, mResult, mOptions);
+            created.insert(created.end(), mResult.begin(), mResult.end());
+        }
+    }
+    catch (std::invalid_argument const&)
+    {
+        // Outlines touching themselves can trip up the local decomposition, but never the whole polygon
+        rebuild();
+        return;
+    }
+
+    // Erase from the back, so polygons moved into erased slots are never touched ones
+    for (auto i = touched.rbegin(); i != touched.rend(); ++i)
+        erasePolygon(*i);
+
+    for (auto& polygon : created)
+        insertPolygon(std::move(polygon));
+}
+
+void DynamicDecomposition::rebuild()
+{
+    std::vector<IndexList32> holeList;
+    for (auto const& obstacle : mObstacleList)
+    {
+        if (!obstacle.empty())
+            holeList.push_back(obstacle);
+    }
+
+    mDecomposer.decompose(mPointList, mSimplePolygon, holeList, {}, mResult, mOptions);
+
+    mPolygonList.clear();
+    mBoxList.clear();
+    mEdgeMap.clear();
+    for (auto const& polygon : mResult)
+        insertPolygon(polygon);
+}
+
+void DynamicDecomposition::insertPolygon(IndexList32 polygon)
+{
+    auto const id = static_cast<std::uint32_t>(mPolygonList.size());
+    Box box{ mPointList[polygon.front()], mPointList[polygon.front()] };
+    for (std::size_t i = 0, N = polygon.size(); i < N; ++i)
+    {
+        auto const& p = mPointList[polygon[i]];
+        box.min = Point(std::min(box.min.x(), p.x()), std::min(box.min.y(), p.y()));
+        box.max = Point(std::max(box.max.x(), p.x()), std::max(box.max.y(), p.y()));
+        mEdgeMap[edgeKey(polygon[i], polygon[(i + 1) % N])] = id;
+    }
+
+    mPolygonList.push_back(std::move(polygon));
+    mBoxList.push_back(box);
+}
+
+void DynamicDecomposition::erasePolygon(std::uint32_t polygon)
+{
+    auto const& erased = mPolygonList[polygon];
+    for (std::size_t i = 0, N = erased.size(); i < N; ++i)
+        mEdgeMap.erase(edgeKey(erased[i], erased[(i + 1) % N]));
+
+    // Move the last polygon into the free slot
+    auto const last = static_cast<std::uint32_t>(mPolygonList.size() - 1);
+    if (polygon != last)
+    {
+        auto const& moved = mPolygonList[last];
+        for (std::size_t i = 0, N = moved.size(); i < N; ++i)
+            mEdgeMap[edgeKey(moved[i], moved[(i + 1) % N])] = polygon;
+
+        mPolygonList[polygon] = std::move(mPolygonList[last]);
+        mBoxList[polygon] = mBoxList[last];
+    }
+
+    mPolygonList.pop_back();
+    mBoxList.pop_back();
+}
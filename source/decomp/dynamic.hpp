@@ -0,0 +1,85 @@
+#ifndef LIB_DECOMP_DYNAMIC
+#define LIB_DECOMP_DYNAMIC
+
+#include "decomposer.hpp"
+#include <unordered_map>
+
+namespace decomp
+{
+
+/** Convex decomposition of a polygon with holes that supports adding and removing holes later on.
+    Holes added or removed this way are called obstacles. An update only decomposes the union of the
+    polygons touching the obstacle again, while all other polygons are kept as they are.
+    Polygons share their edges exactly with their neighbors, so the result is always a conforming mesh.
+    Indices are always 32 bits wide here, since obstacles add points.
+ */
+class DynamicDecomposition
+{
+public:
+    /** Decompose the given polygon with holes. The holes become obstacles 0 to holeList.size() - 1.
+        The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
+        The given options are used for this and for all updates.
+     */
+    DynamicDecomposition(PointList pointList,
+                         IndexList32 simplePolygon,
+                         std::vector<IndexList32> holeList = {},
+                         DecomposeOptions const& options = {});
+
+    /** Add an obstacle with the given clockwise outline, and return its id.
+        The obstacle needs to be strictly inside the free area, and must not enclose another obstacle.
+        Otherwise, std::invalid_argument is thrown and nothing changes.
+     */
+    std::uint32_t addObstacle(PointList const& outline);
+
+    /** Remove an obstacle again. Its id and its points are reused by later obstacles.
+     */
+    void removeObstacle(std::uint32_t obstacle);
+
+    /** Points of the polygon and all obstacles. Points of removed obstacles are no longer used by any polygon.
+     */
+    PointList const& pointList() const
+    {
+        return mPointList;
+    }
+
+    /** The current convex polygons. Updates move polygons around in this list.
+     */
+    std::vector<IndexList32> const& polygonList() const
+    {
+        return mPolygonList;
+    }
+
+private:
+    struct Box
+    {
+        Point min;
+        Point max;
+    };
+
+    void update(std::vector<std::uint32_t> touched, IndexList32 const* removedHole, IndexList32 const* addedHole);
+    void rebuild();
+    void insertPolygon(IndexList32 polygon);
+    void erasePolygon(std::uint32_t polygon);
+
+    PointList mPointList;
+    std::vector<std::uint32_t> mFreePointList;
+    IndexList32 mSimplePolygon;
+
+    // Removed obstacles have an empty outline
+    std::vector<IndexList32> mObstacleList;
+    std::vector<std::uint32_t> mFreeObstacleList;
+
+    std::vector<IndexList32> mPolygonList;
+    std::vector<Box> mBoxList;
+
+    // Directed edge from a to b as a << 32 | b, to the polygon having it
+    std::unordered_map<std::uint64_t, std::uint32_t> mEdgeMap;
+
+    DecomposeOptions mOptions;
+    Decomposer32 mDecomposer;
+    std::vector<IndexList32> mResult;
+};
+
+} // namespace decomp
+
+#endif
@@ -0,0 +1,194 @@
+#ifndef LIB_DECOMP_INDEXED_HEAP
+#define LIB_DECOMP_INDEXED_HEAP
+
+#include "memory_resource.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace decomp
+{
+
+/** Addressable binary min-heap over the slots [0, slotCount), stored in one contiguous array.
+    The heap position of each slot is kept in a parallel array, so priorities can be changed
+    and slots erased in O(log n) without any allocation.
+    Slots with equal priority are extracted in insertion order, and update counts as a
+    re-insertion, just like erasing and re-inserting into a std::multimap.
+ */
+template <class Priority> class IndexedHeap
+{
+public:
+    explicit IndexedHeap(std::size_t slotCount = 0, MemoryResource& resource = newDeleteResource())
+    : mHeap(resource)
+    , mPosition(resource)
+    {
+        reset(slotCount);
+    }
+
+    /** Remove all elements and resize the slot range, keeping the allocated memory.
+     */
+    void reset(std::size_t slotCount)
+    {
+        mHeap.clear();
+        mPosition.assign(slotCount, npos);
+        mSequence = 0;
+    }
+
+    bool empty() const
+    {
+        return mHeap.empty();
+    }
+
+    std::size_t size() const
+    {
+        return mHeap.size();
+    }
+
+    bool contains(std::uint32_t slot) const
+    {
+        return mPosition[slot] != npos;
+    }
+
+    Priority const& priority(std::uint32_t slot) const
+    {
+        assert(contains(slot));
+        return mHeap[mPosition[slot]].priority;
+    }
+
+    std::uint32_t top() const
+    {
+        assert(!empty());
+        return mHeap.front().slot;
+    }
+
+    void push(std::uint32_t slot, Priority priority)
+    {
+        assert(!contains(slot));
+        mHeap.push_back({ std::move(priority), mSequence++, slot });
+        mPosition[slot] = static_cast<std::uint32_t>(mHeap.size() - 1);
+        siftUp(mHeap.size() - 1);
+    }
+
+    /** Change the priority of a contained slot, which can both increase or decrease it.
+     */
+    void update(std::uint32_t slot, Priority priority)
+    {
+        assert(contains(slot));
+        auto position = mPosition[slot];
+        mHeap[position].priority = std::move(priority);
+        mHeap[position].sequence = mSequence++;
+        restore(position);
+    }
+
+    void erase(std::uint32_t slot)
+    {
+        assert(contains(slot));
+        auto position = mPosition[slot];
+        mPosition[slot] = npos;
+
+        if (position + 1 == mHeap.size())
+        {
+            mHeap.pop_back();
+            return;
+        }
+
+        mHeap[position] = std::move(mHeap.back());
+        mHeap.pop_back();
+        mPosition[mHeap[position].slot] = position;
+        restore(position);
+    }
+
+    std::uint32_t pop()
+    {
+        auto slot = top();
+        erase(slot);
+        return slot;
+    }
+
+private:
+    static std::uint32_t const npos = ~std::uint32_t(0);
+
+    struct Entry
+    {
+        Priority priority;
+        std::uint64_t sequence;
+        std::uint32_t slot;
+    };
+
+    static bool less(Entry const& lhs, Entry const& rhs)
+    {
+        if (lhs.priority < rhs.priority)
+            return true;
+        if (rhs.priority < lhs.priority)
+            return false;
+        return lhs.sequence < rhs.sequence;
+    }
+
+    void restore(std::size_t position)
+    {
+        if (position > 0 && less(mHeap[position], mHeap[(position - 1) / 2]))
+            siftUp(position);
+        else
+            siftDown(position);
+    }
+
+    void siftUp(std::size_t position)
+    {
+        Entry entry = std::move(mHeap[position]);
+        while (position > 0)
+        {
+            auto parent = (position - 1) / 2;
+            if (!less(entry, mHeap[parent]))
+                break;
+
+            move(position, parent);
+            position = parent;
+        }
+        place(position, std::move(entry));
+    }
+
+    void siftDown(std::size_t position)
+    {
+        Entry entry = std::move(mHeap[position]);
+        auto const N = mHeap.size();
+        while (true)
+        {
+            auto child = 2 * position + 1;
+            if (child >= N)
+                break;
+
+            if (child + 1 < N && less(mHeap[child + 1], mHeap[child]))
+                ++child;
+
+            if (!less(mHeap[child], entry))
+                break;
+
+            move(position, child);
+            position = child;
+        }
+        place(position, std::move(entry));
+    }
+
+    void move(std::size_t to, std::size_t from)
+    {
+        mHeap[to] = std::move(mHeap[from]);
+        mPosition[mHeap[to].slot] = static_cast<std::uint32_t>(to);
+    }
+
+    void place(std::size_t position, Entry entry)
+    {
+        mPosition[entry.slot] = static_cast<std::uint32_t>(position);
+        mHeap[position] = std::move(entry);
+    }
+
+    ScratchVector<Entry> mHeap;
+    ScratchVector<std::uint32_t> mPosition;
+    std::uint64_t mSequence;
+};
+
+template <class Priority> std::uint32_t const IndexedHeap<Priority>::npos;
+
+} // namespace decomp
+
+#endif
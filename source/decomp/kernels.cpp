@@ -0,0 +1,416 @@
+#include "kernels.hpp"
+#include "predicates.hpp"
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define DECOMP_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// Vectorized functions are compiled for their instruction set only, and only called after checking the CPU
+#if defined(__GNUC__) || defined(__clang__)
+#define DECOMP_TARGET(name) __attribute__((target(name)))
+#else
+#define DECOMP_TARGET(name)
+#endif
+
+using namespace decomp;
+
+namespace
+{
+
+// The scalar versions define the results. They use the exact predicates, and so do the vectorized versions below:
+// these evaluate the floating-point filter of orient2d for all elements at once, and only fall back to the scalar
+// version for a block that contains an element the filter can not decide.
+
+std::size_t firstInTriangleScalar(
+    Point const& a, Point const& b, Point const& c, double const* x, double const* y, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Point p(x[i], y[i]);
+        if (orient2d(a, p, b) <= 0.0 && orient2d(b, p, c) <= 0.0 && orient2d(c, p, a) <= 0.0)
+            return i;
+    }
+    return count;
+}
+
+std::size_t firstIntersectingScalar(Point const& a,
+                                    Point const& b,
+                                    double const* x0,
+                                    double const* y0,
+                                    double const* x1,
+                                    double const* y1,
+                                    std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (segmentsIntersect(a, b, Point(x0[i], y0[i]), Point(x1[i], y1[i])))
+            return i;
+    }
+    return count;
+}
+
+// The sum is split into four partial sums, where edge i goes into sum i % 4
+std::size_t const shoelaceLanes = 4;
+
+void addShoelaceTerms(double const* x, double const* y, std::size_t first, std::size_t count, double* sum)
+{
+    for (auto i = first; i + 1 < count; ++i)
+        sum[i % shoelaceLanes] += x[i] * y[i + 1] - y[i] * x[i + 1];
+}
+
+double reduceShoelaceSum(double const* sum)
+{
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+double shoelaceSumScalar(double const* x, double const* y, std::size_t count)
+{
+    double sum[shoelaceLanes] = {};
+    addShoelaceTerms(x, y, 0, count, sum);
+    return reduceShoelaceSum(sum);
+}
+
+BatchKernels const scalarKernels = { firstInTriangleScalar, firstIntersectingScalar, shoelaceSumScalar };
+
+#ifdef DECOMP_X86
+
+std::size_t firstSetBit(int mask)
+{
+    std::size_t result = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        ++result;
+    }
+    return result;
+}
+
+// Signs of orient2d for each element, and which of them the floating-point filter could not decide
+struct OrientationSSE2
+{
+    __m128d positive;
+    __m128d negative;
+    __m128d uncertain;
+};
+
+DECOMP_TARGET("sse2")
+inline OrientationSSE2 orient2dSSE2(__m128d ax, __m128d ay, __m128d bx, __m128d by, __m128d cx, __m128d cy)
+{
+    auto signBit = _mm_set1_pd(-0.0);
+    auto detLeft = _mm_mul_pd(_mm_sub_pd(ax, cx), _mm_sub_pd(by, cy));
+    auto detRight = _mm_mul_pd(_mm_sub_pd(ay, cy), _mm_sub_pd(bx, cx));
+    auto det = _mm_sub_pd(detLeft, detRight);
+    auto detSum = _mm_add_pd(_mm_andnot_pd(signBit, detLeft), _mm_andnot_pd(signBit, detRight));
+
+    OrientationSSE2 result;
+    result.positive = _mm_cmpgt_pd(det, _mm_setzero_pd());
+    result.negative = _mm_cmplt_pd(det, _mm_setzero_pd());
+    result.uncertain = _mm_cmplt_pd(_mm_andnot_pd(signBit, det), _mm_mul_pd(_mm_set1_pd(orientErrorBound), detSum));
+    return result;
+}
+
+DECOMP_TARGET("sse2")
+std::size_t firstInTriangleSSE2(
+    Point const& a, Point const& b, Point const& c, double const* x, double const* y, std::size_t count)
+{
+    auto ax = _mm_set1_pd(a[0]), ay = _mm_set1_pd(a[1]);
+    auto bx = _mm_set1_pd(b[0]), by = _mm_set1_pd(b[1]);
+    auto cx = _mm_set1_pd(c[0]), cy = _mm_set1_pd(c[1]);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        auto px = _mm_loadu_pd(x + i);
+        auto py = _mm_loadu_pd(y + i);
+        auto abp = orient2dSSE2(ax, ay, px, py, bx, by);
+        auto bcp = orient2dSSE2(bx, by, px, py, cx, cy);
+        auto cap = orient2dSSE2(cx, cy, px, py, ax, ay);
+
+        if (_mm_movemask_pd(_mm_or_pd(_mm_or_pd(abp.uncertain, bcp.uncertain), cap.uncertain)) != 0)
+        {
+            auto found = firstInTriangleScalar(a, b, c, x + i, y + i, 2);
+            if (found < 2)
+                return i + found;
+            continue;
+        }
+
+        auto outside = _mm_or_pd(_mm_or_pd(abp.positive, bcp.positive), cap.positive);
+        auto mask = _mm_movemask_pd(outside) ^ 3;
+        if (mask != 0)
+            return i + firstSetBit(mask);
+    }
+    return i + firstInTriangleScalar(a, b, c, x + i, y + i, count - i);
+}
+
+DECOMP_TARGET("sse2")
+std::size_t firstIntersectingSSE2(Point const& a,
+                                  Point const& b,
+                                  double const* x0,
+                                  double const* y0,
+                                  double const* x1,
+                                  double const* y1,
+                                  std::size_t count)
+{
+    auto ax = _mm_set1_pd(a[0]), ay = _mm_set1_pd(a[1]);
+    auto bx = _mm_set1_pd(b[0]), by = _mm_set1_pd(b[1]);
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2)
+    {
+        auto cx = _mm_loadu_pd(x0 + i), cy = _mm_loadu_pd(y0 + i);
+        auto dx = _mm_loadu_pd(x1 + i), dy = _mm_loadu_pd(y1 + i);
+        auto abc = orient2dSSE2(ax, ay, bx, by, cx, cy);
+        auto abd = orient2dSSE2(ax, ay, bx, by, dx, dy);
+        auto cda = orient2dSSE2(cx, cy, dx, dy, ax, ay);
+        auto cdb = orient2dSSE2(cx, cy, dx, dy, bx, by);
+
+        auto uncertain = _mm_or_pd(_mm_or_pd(abc.uncertain, abd.uncertain), _mm_or_pd(cda.uncertain, cdb.uncertain));
+        if (_mm_movemask_pd(uncertain) != 0)
+        {
+            auto found = firstIntersectingScalar(a, b, x0 + i, y0 + i, x1 + i, y1 + i, 2);
+            if (found < 2)
+                return i + found;
+            continue;
+        }
+
+        // Same as segmentsIntersect: c and d are not both on ab, and neither segment is strictly on one side
+        auto notCollinear = _mm_or_pd(_mm_or_pd(abc.positive, abc.negative), _mm_or_pd(abd.positive, abd.negative));
+        auto sameSideOfAB = _mm_or_pd(_mm_and_pd(abc.positive, abd.positive), _mm_and_pd(abc.negative, abd.negative));
+        auto sameSideOfCD = _mm_or_pd(_mm_and_pd(cda.positive, cdb.positive), _mm_and_pd(cda.negative, cdb.negative));
+        auto mask = _mm_movemask_pd(_mm_andnot_pd(_mm_or_pd(sameSideOfAB, sameSideOfCD), notCollinear));
+        if (mask != 0)
+            return i + firstSetBit(mask);
+    }
+    return i + firstIntersectingScalar(a, b, x0 + i, y0 + i, x1 + i, y1 + i, count - i);
+}
+
+DECOMP_TARGET("sse2") double shoelaceSumSSE2(double const* x, double const* y, std::size_t count)
+{
+    // Sums 0 and 1 in the low, sums 2 and 3 in the high register
+    auto low = _mm_setzero_pd();
+    auto high = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + shoelaceLanes < count; i += shoelaceLanes)
+    {
+        low = _mm_add_pd(low,
+                         _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i + 1)),
+                                    _mm_mul_pd(_mm_loadu_pd(y + i), _mm_loadu_pd(x + i + 1))));
+        high = _mm_add_pd(high,
+                          _mm_sub_pd(_mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 3)),
+                                     _mm_mul_pd(_mm_loadu_pd(y + i + 2), _mm_loadu_pd(x + i + 3))));
+    }
+
+    double sum[shoelaceLanes];
+    _mm_storeu_pd(sum, low);
+    _mm_storeu_pd(sum + 2, high);
+    addShoelaceTerms(x, y, i, count, sum);
+    return reduceShoelaceSum(sum);
+}
+
+struct OrientationAVX2
+{
+    __m256d positive;
+    __m256d negative;
+    __m256d uncertain;
+};
+
+DECOMP_TARGET("avx2")
+inline OrientationAVX2 orient2dAVX2(__m256d ax, __m256d ay, __m256d bx, __m256d by, __m256d cx, __m256d cy)
+{
+    auto signBit = _mm256_set1_pd(-0.0);
+    auto detLeft = _mm256_mul_pd(_mm256_sub_pd(ax, cx), _mm256_sub_pd(by, cy));
+    auto detRight = _mm256_mul_pd(_mm256_sub_pd(ay, cy), _mm256_sub_pd(bx, cx));
+    auto det = _mm256_sub_pd(detLeft, detRight);
+    auto detSum = _mm256_add_pd(_mm256_andnot_pd(signBit, detLeft), _mm256_andnot_pd(signBit, detRight));
+
+    OrientationAVX2 result;
+    result.positive = _mm256_cmp_pd(det, _mm256_setzero_pd(), _CMP_GT_OQ);
+    result.negative = _mm256_cmp_pd(det, _mm256_setzero_pd(), _CMP_LT_OQ);
+    result.uncertain = _mm256_cmp_pd(
+        _mm256_andnot_pd(signBit, det), _mm256_mul_pd(_mm256_set1_pd(orientErrorBound), detSum), _CMP_LT_OQ);
+    return result;
+}
+
+DECOMP_TARGET("avx2")
+std::size_t firstInTriangleAVX2(
+    Point const& a, Point const& b, Point const& c, double const* x, double const* y, std::size_t count)
+{
+    auto ax = _mm256_set1_pd(a[0]), ay = _mm256_set1_pd(a[1]);
+    auto bx = _mm256_set1_pd(b[0]), by = _mm256_set1_pd(b[1]);
+    auto cx = _mm256_set1_pd(c[0]), cy = _mm256_set1_pd(c[1]);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        auto px = _mm256_loadu_pd(x + i);
+        auto py = _mm256_loadu_pd(y + i);
+        auto abp = orient2dAVX2(ax, ay, px, py, bx, by);
+        auto bcp = orient2dAVX2(bx, by, px, py, cx, cy);
+        auto cap = orient2dAVX2(cx, cy, px, py, ax, ay);
+
+        if (_mm256_movemask_pd(_mm256_or_pd(_mm256_or_pd(abp.uncertain, bcp.uncertain), cap.uncertain)) != 0)
+        {
+            auto found = firstInTriangleScalar(a, b, c, x + i, y + i, 4);
+            if (found < 4)
+                return i + found;
+            continue;
+        }
+
+        auto outside = _mm256_or_pd(_mm256_or_pd(abp.positive, bcp.positive), cap.positive);
+        auto mask = _mm256_movemask_pd(outside) ^ 15;
+        if (mask != 0)
+            return i + firstSetBit(mask);
+    }
+    return i + firstInTriangleSSE2(a, b, c, x + i, y + i, count - i);
+}
+
+DECOMP_TARGET("avx2")
+std::size_t firstIntersectingAVX2(Point const& a,
+                                  Point const& b,
+                                  double const* x0,
+                                  double const* y0,
+                                  double const* x1,
+                                  double const* y1,
+                                  std::size_t count)
+{
+    auto ax = _mm256_set1_pd(a[0]), ay = _mm256_set1_pd(a[1]);
+    auto bx = _mm256_set1_pd(b[0]), by = _mm256_set1_pd(b[1]);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        auto cx = _mm256_loadu_pd(x0 + i), cy = _mm256_loadu_pd(y0 + i);
+        auto dx = _mm256_loadu_pd(x1 + i), dy = _mm256_loadu_pd(y1 + i);
+        auto abc = orient2dAVX2(ax, ay, bx, by, cx, cy);
+        auto abd = orient2dAVX2(ax, ay, bx, by, dx, dy);
+        auto cda = orient2dAVX2(cx, cy, dx, dy, ax, ay);
+        auto cdb = orient2dAVX2(cx, cy, dx, dy, bx, by);
+
+        auto uncertain =
+            _mm256_or_pd(_mm256_or_pd(abc.uncertain, abd.uncertain), _mm256_or_pd(cda.uncertain, cdb.uncertain));
+        if (_mm256_movemask_pd(uncertain) != 0)
+        {
+            auto found = firstIntersectingScalar(a, b, x0 + i, y0 + i, x1 + i, y1 + i, 4);
+            if (found < 4)
+                return i + found;
+            continue;
+        }
+
+        auto notCollinear =
+            _mm256_or_pd(_mm256_or_pd(abc.positive, abc.negative), _mm256_or_pd(abd.positive, abd.negative));
+        auto sameSideOfAB =
+            _mm256_or_pd(_mm256_and_pd(abc.positive, abd.positive), _mm256_and_pd(abc.negative, abd.negative));
+        auto sameSideOfCD =
+            _mm256_or_pd(_mm256_and_pd(cda.positive, cdb.positive), _mm256_and_pd(cda.negative, cdb.negative));
+        auto mask = _mm256_movemask_pd(_mm256_andnot_pd(_mm256_or_pd(sameSideOfAB, sameSideOfCD), notCollinear));
+        if (mask != 0)
+            return i + firstSetBit(mask);
+    }
+    return i + firstIntersectingSSE2(a, b, x0 + i, y0 + i, x1 + i, y1 + i, count - i);
+}
+
+DECOMP_TARGET("avx2") double shoelaceSumAVX2(double const* x, double const* y, std::size_t count)
+{
+    auto accumulated = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + shoelaceLanes < count; i += shoelaceLanes)
+    {
+        accumulated = _mm256_add_pd(accumulated,
+                                    _mm256_sub_pd(_mm256_mul_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i + 1)),
+                                                  _mm256_mul_pd(_mm256_loadu_pd(y + i), _mm256_loadu_pd(x + i + 1))));
+    }
+
+    double sum[shoelaceLanes];
+    _mm256_storeu_pd(sum, accumulated);
+    addShoelaceTerms(x, y, i, count, sum);
+    return reduceShoelaceSum(sum);
+}
+
+BatchKernels const sse2Kernels = { firstInTriangleSSE2, firstIntersectingSSE2, shoelaceSumSSE2 };
+BatchKernels const avx2Kernels = { firstInTriangleAVX2, firstIntersectingAVX2, shoelaceSumAVX2 };
+
+#ifdef _MSC_VER
+
+bool cpuSupportsSSE2()
+{
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+}
+
+bool cpuSupportsAVX2()
+{
+    // The OS also needs to save the AVX registers on context switches
+    int info[4];
+    __cpuid(info, 1);
+    bool const hasXSave = (info[2] & (1 << 27)) != 0;
+    bool const hasAVX = (info[2] & (1 << 28)) != 0;
+    if (!hasXSave || !hasAVX || (_xgetbv(0) & 6) != 6)
+        return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+}
+
+#else
+
+bool cpuSupportsSSE2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse2");
+}
+
+bool cpuSupportsAVX2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+#endif
+#endif
+
+} // namespace
+
+bool decomp::isSupported(InstructionSet instructionSet)
+{
+    switch (instructionSet)
+    {
+    case InstructionSet::Scalar:
+        return true;
+#ifdef DECOMP_X86
+    case InstructionSet::SSE2:
+        return cpuSupportsSSE2();
+    case InstructionSet::AVX2:
+        return cpuSupportsSSE2() && cpuSupportsAVX2();
+#endif
+    default:
+        return false;
+    }
+}
+
+BatchKernels const& decomp::batchKernels(InstructionSet instructionSet)
+{
+    if (!isSupported(instructionSet))
+        throw std::invalid_argument("Instruction set is not supported");
+
+    switch (instructionSet)
+    {
+#ifdef DECOMP_X86
+    case InstructionSet::SSE2:
+        return sse2Kernels;
+    case InstructionSet::AVX2:
+        return avx2Kernels;
+#endif
+    default:
+        return scalarKernels;
+    }
+}
+
+BatchKernels const& decomp::batchKernels()
+{
+    static BatchKernels const& best = batchKernels(isSupported(InstructionSet::AVX2)   ? InstructionSet::AVX2
+                                                   : isSupported(InstructionSet::SSE2) ? InstructionSet::SSE2
+                                                                                       : InstructionSet::Scalar);
+    return best;
+}
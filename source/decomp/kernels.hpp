@@ -0,0 +1,60 @@
+#ifndef LIB_DECOMP_KERNELS
+#define LIB_DECOMP_KERNELS
+
+#include "triangulation.hpp"
+
+namespace decomp
+{
+
+enum class InstructionSet
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/** Geometric tests on blocks of points or segments in structure-of-arrays layout, as used by the inner loops
+    of the triangulation. The point and segment tests are exact, like orient2d and segmentsIntersect, and the shoelace
+    sum does the same floating-point operations in the same order for every instruction set, so all of them give the
+    exact same results.
+ */
+struct BatchKernels
+{
+    /** Index of the first of count points that is inside or on the border of the clockwise triangle abc,
+        or count if there is none.
+     */
+    std::size_t (*firstInTriangle)(
+        Point const& a, Point const& b, Point const& c, double const* x, double const* y, std::size_t count);
+
+    /** Index of the first of count segments from (x0, y0) to (x1, y1) that intersects the segment from a to b,
+        or count if there is none. This uses the same rules as segmentsIntersect.
+     */
+    std::size_t (*firstIntersecting)(Point const& a,
+                                     Point const& b,
+                                     double const* x0,
+                                     double const* y0,
+                                     double const* x1,
+                                     double const* y1,
+                                     std::size_t count);
+
+    /** Shoelace sum over the count - 1 edges of the polyline through the given points,
+        i.e. twice the signed area of the polygon if the last point repeats the first one.
+     */
+    double (*shoelaceSum)(double const* x, double const* y, std::size_t count);
+};
+
+/** Whether the CPU we are running on can execute the given instruction set.
+ */
+bool isSupported(InstructionSet instructionSet);
+
+/** Kernels for the given instruction set, which needs to be supported.
+ */
+BatchKernels const& batchKernels(InstructionSet instructionSet);
+
+/** Kernels for the best supported instruction set, which is detected on first use.
+ */
+BatchKernels const& batchKernels();
+
+} // namespace decomp
+
+#endif
@@ -0,0 +1,110 @@
+#include "memory_resource.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+using namespace decomp;
+
+namespace
+{
+
+class NewDeleteResource : public MemoryResource
+{
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t) override
+    {
+        return ::operator new(bytes);
+    }
+
+    void doDeallocate(void* pointer, std::size_t, std::size_t) override
+    {
+        ::operator delete(pointer);
+    }
+};
+
+// Size of the block header, rounded up so the data after it is suitably aligned
+std::size_t const maxAlignment = alignof(std::max_align_t);
+std::size_t const headerSize = (sizeof(void*) + sizeof(std::size_t) + maxAlignment - 1) & ~(maxAlignment - 1);
+
+} // namespace
+
+MemoryResource& decomp::newDeleteResource()
+{
+    static NewDeleteResource resource;
+    return resource;
+}
+
+ArenaResource::ArenaResource(MemoryResource& upstream, std::size_t initialSize)
+: mUpstream(upstream)
+, mInitialSize(std::max<std::size_t>(initialSize, 64))
+{
+}
+
+ArenaResource::~ArenaResource()
+{
+    freeBlocks();
+}
+
+void ArenaResource::release()
+{
+    if (mBlock == nullptr)
+        return;
+
+    // Merge multiple blocks into one, so the next round fits without growing
+    if (mBlock->previous != nullptr)
+    {
+        auto capacity = mCapacity;
+        freeBlocks();
+        pushBlock(capacity);
+        return;
+    }
+
+    mCurrent = reinterpret_cast<char*>(mBlock) + headerSize;
+}
+
+void* ArenaResource::doAllocate(std::size_t bytes, std::size_t alignment)
+{
+    auto align = [alignment](char* pointer) {
+        auto address = reinterpret_cast<std::uintptr_t>(pointer);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(std::uintptr_t(alignment) - 1));
+    };
+
+    auto start = align(mCurrent);
+    if (mBlock == nullptr || start + bytes > mEnd)
+    {
+        // Grow geometrically, so the number of blocks stays logarithmic
+        auto size = std::max(mBlock ? mBlock->size * 2 : mInitialSize, bytes + alignment);
+        pushBlock(size);
+        start = align(mCurrent);
+    }
+
+    mCurrent = start + bytes;
+    return start;
+}
+
+void ArenaResource::doDeallocate(void*, std::size_t, std::size_t)
+{
+}
+
+void ArenaResource::pushBlock(std::size_t size)
+{
+    auto block = static_cast<Block*>(mUpstream.allocate(headerSize + size));
+    block->previous = mBlock;
+    block->size = size;
+    mBlock = block;
+    mCapacity += size;
+    mCurrent = reinterpret_cast<char*>(block) + headerSize;
+    mEnd = mCurrent + size;
+}
+
+void ArenaResource::freeBlocks()
+{
+    while (mBlock != nullptr)
+    {
+        auto previous = mBlock->previous;
+        mUpstream.deallocate(mBlock, headerSize + mBlock->size);
+        mBlock = previous;
+    }
+    mCapacity = 0;
+    mCurrent = mEnd = nullptr;
+}
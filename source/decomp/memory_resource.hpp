@@ -0,0 +1,141 @@
+#ifndef LIB_DECOMP_MEMORY_RESOURCE
+#define LIB_DECOMP_MEMORY_RESOURCE
+
+#include <cstddef>
+#include <vector>
+
+namespace decomp
+{
+
+/** Source of raw memory for the scratch storage of the algorithms, modeled after std::pmr::memory_resource.
+    Derive from this to plug in a custom allocator.
+ */
+class MemoryResource
+{
+public:
+    virtual ~MemoryResource() = default;
+
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        return doAllocate(bytes, alignment);
+    }
+
+    void deallocate(void* pointer, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t))
+    {
+        doDeallocate(pointer, bytes, alignment);
+    }
+
+protected:
+    virtual void* doAllocate(std::size_t bytes, std::size_t alignment) = 0;
+    virtual void doDeallocate(void* pointer, std::size_t bytes, std::size_t alignment) = 0;
+};
+
+/** Resource that forwards to the global operator new and delete.
+ */
+MemoryResource& newDeleteResource();
+
+/** Monotonic arena. Deallocation is a no-op, and all memory is reclaimed at once with release().
+    After a release, the memory is kept in a single block as large as everything allocated before,
+    so repeating the same work does not allocate from the upstream resource again.
+ */
+class ArenaResource : public MemoryResource
+{
+public:
+    explicit ArenaResource(MemoryResource& upstream = newDeleteResource(), std::size_t initialSize = 4096);
+    ~ArenaResource();
+
+    ArenaResource(ArenaResource const&) = delete;
+    ArenaResource& operator=(ArenaResource const&) = delete;
+
+    /** Reclaim all memory allocated from this arena, but keep it for reuse.
+     */
+    void release();
+
+    /** Total size of the blocks held from the upstream resource.
+     */
+    std::size_t capacity() const
+    {
+        return mCapacity;
+    }
+
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t alignment) override;
+    void doDeallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+
+private:
+    struct Block
+    {
+        Block* previous;
+        std::size_t size;
+    };
+
+    void pushBlock(std::size_t size);
+    void freeBlocks();
+
+    MemoryResource& mUpstream;
+    std::size_t mInitialSize;
+    std::size_t mCapacity = 0;
+    Block* mBlock = nullptr;
+    char* mCurrent = nullptr;
+    char* mEnd = nullptr;
+};
+
+/** Standard allocator adaptor that gets its memory from a MemoryResource.
+ */
+template <class T> class ResourceAllocator
+{
+public:
+    using value_type = T;
+
+    ResourceAllocator()
+    : mResource(&newDeleteResource())
+    {
+    }
+
+    ResourceAllocator(MemoryResource& resource)
+    : mResource(&resource)
+    {
+    }
+
+    template <class U>
+    ResourceAllocator(ResourceAllocator<U> const& rhs)
+    : mResource(rhs.resource())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(mResource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t n)
+    {
+        mResource->deallocate(pointer, n * sizeof(T), alignof(T));
+    }
+
+    MemoryResource* resource() const
+    {
+        return mResource;
+    }
+
+private:
+    MemoryResource* mResource;
+};
+
+template <class T, class U> bool operator==(ResourceAllocator<T> const& lhs, ResourceAllocator<U> const& rhs)
+{
+    return lhs.resource() == rhs.resource();
+}
+
+template <class T, class U> bool operator!=(ResourceAllocator<T> const& lhs, ResourceAllocator<U> const& rhs)
+{
+    return !(lhs == rhs);
+}
+
+/** Vector for scratch storage that lives only during a call.
+ */
+template <class T> using ScratchVector = std::vector<T, ResourceAllocator<T>>;
+
+} // namespace decomp
+
+#endif
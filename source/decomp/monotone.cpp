@@ -0,0 +1,509 @@
+#include "monotone.hpp"
+#include "predicates.hpp"
+#include <algorithm>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+
+using namespace decomp;
+
+namespace
+{
+
+using SlotList = ScratchVector<std::uint32_t>;
+
+enum class VertexType : std::uint8_t
+{
+    Start,
+    End,
+    Split,
+    Merge,
+    Regular
+};
+
+template <class T> int sign(T value)
+{
+    return (value > T(0)) - (value < T(0));
+}
+
+// Sweep order from top to bottom: larger y first, and smaller x first on the same height. This is the same as
+// sweeping along a slightly rotated direction, so no two vertices are on the same height.
+template <class P> bool isAbove(P const& lhs, P const& rhs)
+{
+    return lhs[1] > rhs[1] || (lhs[1] == rhs[1] && lhs[0] < rhs[0]);
+}
+
+// Triangulation by partitioning into y-monotone pieces, after de Berg et al., "Computational Geometry", chapter 3.
+// All vertices of all rings are stored in slots, and the edge from a slot to the next one in its ring is
+// named by the same slot. Diagonals are half-edges numbered after the edges, in pairs of twins.
+// P is the point type the predicates compute with, see exactPoint.
+template <class P> class MonotoneSweep
+{
+public:
+    MonotoneSweep(std::size_t size, MemoryResource& resource)
+    : mResource(resource)
+    , mPointList(resource)
+    , mIndexList(resource)
+    , mPrevList(resource)
+    , mNextList(resource)
+    , mDiagonalList(resource)
+    , mSequence(resource)
+    , mStack(resource)
+    {
+        mPointList.reserve(size);
+        mIndexList.reserve(size);
+        mPrevList.reserve(size);
+        mNextList.reserve(size);
+    }
+
+    template <class Points, class Index> void addRing(Points const& pointList, BasicIndexList<Index> const& ring)
+    {
+        auto first = static_cast<std::uint32_t>(mIndexList.size());
+        auto N = static_cast<std::uint32_t>(ring.size());
+        for (std::uint32_t i = 0; i < N; ++i)
+        {
+            mPointList.push_back(exactPoint(pointList, ring[i]));
+            mIndexList.push_back(ring[i]);
+            mPrevList.push_back(first + (i + N - 1) % N);
+            mNextList.push_back(first + (i + 1) % N);
+        }
+    }
+
+    template <class Index> void triangulate(BasicIndexList<Index>& result)
+    {
+        partition();
+        triangulatePieces(result);
+    }
+
+private:
+    struct EdgeOrder
+    {
+        bool operator()(std::uint32_t lhs, std::uint32_t rhs) const
+        {
+            return sweep->isLeftOf(lhs, rhs);
+        }
+
+        MonotoneSweep const* sweep;
+    };
+
+    using EdgeStatus = std::set<std::uint32_t, EdgeOrder, ResourceAllocator<std::uint32_t>>;
+
+    // Side of vertex v relative to edge e, which points downwards: positive if v is right of it
+    int side(std::uint32_t e, std::uint32_t v) const
+    {
+        return sign(orient2d(mPointList[e], mPointList[mNextList[e]], mPointList[v]));
+    }
+
+    // Side of edge f relative to edge e, decided by its upper vertex, or its lower one if the upper is on e
+    int edgeSide(std::uint32_t e, std::uint32_t f) const
+    {
+        auto result = side(e, f);
+        return result != 0 ? result : side(e, mNextList[f]);
+    }
+
+    // Order of the edges crossing the sweep line from left to right. The edge that starts lower is tested
+    // against the other one, which crosses the sweep line at its upper vertex. Edge mQuery stands for mQueryVertex.
+    bool isLeftOf(std::uint32_t lhs, std::uint32_t rhs) const
+    {
+        if (lhs == rhs)
+            return false;
+        if (lhs == mQuery)
+            return side(rhs, mQueryVertex) < 0;
+        if (rhs == mQuery)
+            return side(lhs, mQueryVertex) > 0;
+        if (isAbove(mPointList[rhs], mPointList[lhs]))
+            return edgeSide(rhs, lhs) < 0;
+        return edgeSide(lhs, rhs) > 0;
+    }
+
+    VertexType classify(std::uint32_t v) const
+    {
+        auto const& prev = mPointList[mPrevList[v]];
+        auto const& next = mPointList[mNextList[v]];
+        auto const& center = mPointList[v];
+        bool isConvex = orient2d(prev, center, next) > 0;
+        bool prevBelow = isAbove(center, prev);
+        bool nextBelow = isAbove(center, next);
+        if (prevBelow && nextBelow)
+            return isConvex ? VertexType::Start : VertexType::Split;
+        if (!prevBelow && !nextBelow)
+            return isConvex ? VertexType::End : VertexType::Merge;
+        return VertexType::Regular;
+    }
+
+    // Sweep from top to bottom, and add diagonals at the split and merge vertices
+    void partition()
+    {
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        SlotList eventList(N, 0, mResource);
+        std::iota(eventList.begin(), eventList.end(), 0u);
+        std::sort(eventList.begin(), eventList.end(), [this](std::uint32_t lhs, std::uint32_t rhs) -> bool {
+            if (isAbove(mPointList[lhs], mPointList[rhs]))
+                return true;
+            return !isAbove(mPointList[rhs], mPointList[lhs]) && lhs < rhs;
+        });
+
+        ScratchVector<VertexType> typeList(mResource);
+        typeList.reserve(N);
+        for (std::uint32_t v = 0; v < N; ++v)
+            typeList.push_back(classify(v));
+
+        mQuery = N;
+        EdgeStatus status(EdgeOrder{ this }, ResourceAllocator<std::uint32_t>(mResource));
+        ScratchVector<typename EdgeStatus::iterator> positionList(N, status.end(), mResource);
+        SlotList helperList(N, 0, mResource);
+        mDiagonalList.clear();
+
+        auto insert = [&](std::uint32_t e, std::uint32_t helper) {
+            auto inserted = status.insert(e);
+            if (!inserted.second)
+                throw std::runtime_error("Polygon is not simple");
+            positionList[e] = inserted.first;
+            helperList[e] = helper;
+        };
+
+        // Connect v to the helper of edge e if that is a merge vertex, and remove e
+        auto finish = [&](std::uint32_t v, std::uint32_t e) {
+            if (positionList[e] == status.end())
+                throw std::runtime_error("Polygon is not simple");
+            if (typeList[helperList[e]] == VertexType::Merge)
+                addDiagonal(v, helperList[e]);
+            status.erase(positionList[e]);
+            positionList[e] = status.end();
+        };
+
+        // The edge directly left of v
+        auto leftOf = [&](std::uint32_t v) -> std::uint32_t {
+            mQueryVertex = v;
+            auto position = status.lower_bound(mQuery);
+            if (position == status.begin())
+                throw std::runtime_error("Polygon is not simple");
+            return *--position;
+        };
+
+        for (auto v : eventList)
+        {
+            auto prev = mPrevList[v];
+            switch (typeList[v])
+            {
+            case VertexType::Start:
+                insert(v, v);
+                break;
+            case VertexType::End:
+                finish(v, prev);
+                break;
+            case VertexType::Split:
+            {
+                auto left = leftOf(v);
+                addDiagonal(v, helperList[left]);
+                helperList[left] = v;
+                insert(v, v);
+                break;
+            }
+            case VertexType::Merge:
+            {
+                finish(v, prev);
+                auto left = leftOf(v);
+                if (typeList[helperList[left]] == VertexType::Merge)
+                    addDiagonal(v, helperList[left]);
+                helperList[left] = v;
+                break;
+            }
+            case VertexType::Regular:
+                // The interior is right of v if the boundary goes downwards here
+                if (isAbove(mPointList[v], mPointList[mNextList[v]]))
+                {
+                    finish(v, prev);
+                    insert(v, v);
+                }
+                else
+                {
+                    auto left = leftOf(v);
+                    if (typeList[helperList[left]] == VertexType::Merge)
+                        addDiagonal(v, helperList[left]);
+                    helperList[left] = v;
+                }
+                break;
+            }
+        }
+    }
+
+    void addDiagonal(std::uint32_t from, std::uint32_t to)
+    {
+        mDiagonalList.push_back(from);
+        mDiagonalList.push_back(to);
+    }
+
+    // Walk the pieces bounded by edges and diagonals, and triangulate each one
+    template <class Index> void triangulatePieces(BasicIndexList<Index>& result)
+    {
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        auto halfEdgeCount = N + static_cast<std::uint32_t>(mDiagonalList.size());
+
+        // Diagonals leaving each vertex, sorted clockwise from the edge to its previous vertex.
+        // The interior is between that edge and the edge to the next vertex in this direction.
+        SlotList firstList(N + 1, 0, mResource);
+        for (auto v : mDiagonalList)
+            ++firstList[v + 1];
+        std::partial_sum(firstList.begin(), firstList.end(), firstList.begin());
+
+        SlotList outgoingList(mDiagonalList.size(), 0, mResource);
+        SlotList fillList(firstList.begin(), firstList.end() - 1, mResource);
+        for (std::uint32_t i = 0; i < mDiagonalList.size(); ++i)
+            outgoingList[fillList[mDiagonalList[i]]++] = N + i;
+
+        for (std::uint32_t v = 0; v < N; ++v)
+        {
+            auto const& center = mPointList[v];
+            auto const& marker = mPointList[mPrevList[v]];
+            auto half = [&](std::uint32_t h) { return orient2d(center, marker, mPointList[target(h)]) < 0 ? 0 : 1; };
+            std::sort(outgoingList.begin() + firstList[v],
+                      outgoingList.begin() + firstList[v + 1],
+                      [&](std::uint32_t lhs, std::uint32_t rhs) -> bool {
+                          auto lhsHalf = half(lhs), rhsHalf = half(rhs);
+                          if (lhsHalf != rhsHalf)
+                              return lhsHalf < rhsHalf;
+                          return orient2d(center, mPointList[target(lhs)], mPointList[target(rhs)]) < 0;
+                      });
+        }
+
+        // Position of each diagonal in the list of its origin
+        SlotList positionList(mDiagonalList.size(), 0, mResource);
+        for (std::uint32_t i = 0; i < outgoingList.size(); ++i)
+            positionList[outgoingList[i] - N] = i;
+
+        // The next half-edge of a piece turns right as far as possible at the end of the current one
+        auto next = [&](std::uint32_t h) -> std::uint32_t {
+            auto v = target(h);
+            auto position = h < N ? firstList[v] : positionList[twin(h) - N] + 1;
+            return position < firstList[v + 1] ? outgoingList[position] : v;
+        };
+
+        ScratchVector<bool> visitedList(halfEdgeCount, false, mResource);
+        SlotList piece(mResource);
+        for (std::uint32_t first = 0; first < halfEdgeCount; ++first)
+        {
+            if (visitedList[first])
+                continue;
+
+            piece.clear();
+            auto h = first;
+            do
+            {
+                visitedList[h] = true;
+                piece.push_back(origin(h));
+                h = next(h);
+            } while (h != first);
+
+            triangulateMonotone(piece, result);
+        }
+    }
+
+    std::uint32_t twin(std::uint32_t h) const
+    {
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        return N + ((h - N) ^ 1u);
+    }
+
+    std::uint32_t origin(std::uint32_t h) const
+    {
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        return h < N ? h : mDiagonalList[h - N];
+    }
+
+    std::uint32_t target(std::uint32_t h) const
+    {
+        auto N = static_cast<std::uint32_t>(mIndexList.size());
+        return h < N ? mNextList[h] : mDiagonalList[twin(h) - N];
+    }
+
+    // Triangulate a y-monotone piece with counter-clockwise vertices in linear time, by walking down both chains
+    // from the top vertex and cutting off triangles as soon as they are inside the piece
+    template <class Index> void triangulateMonotone(SlotList const& piece, BasicIndexList<Index>& result)
+    {
+        auto n = static_cast<std::uint32_t>(piece.size());
+        if (n < 3)
+            return;
+
+        std::uint32_t top = 0, bottom = 0;
+        for (std::uint32_t i = 1; i < n; ++i)
+        {
+            if (isAbove(mPointList[piece[i]], mPointList[piece[top]]))
+                top = i;
+            if (isAbove(mPointList[piece[bottom]], mPointList[piece[i]]))
+                bottom = i;
+        }
+
+        // Merge both chains in sweep order. The left one follows the vertex order downwards.
+        mSequence.clear();
+        mSequence.emplace_back(piece[top], true);
+        auto left = (top + 1) % n, right = (top + n - 1) % n;
+        while (left != bottom || right != bottom)
+        {
+            if (left != bottom && (right == bottom || isAbove(mPointList[piece[left]], mPointList[piece[right]])))
+            {
+                mSequence.emplace_back(piece[left], true);
+                left = (left + 1) % n;
+            }
+            else
+            {
+                mSequence.emplace_back(piece[right], false);
+                right = (right + n - 1) % n;
+            }
+        }
+        mSequence.emplace_back(piece[bottom], true);
+
+        auto emit = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+            result.push_back(static_cast<Index>(mIndexList[a]));
+            result.push_back(static_cast<Index>(mIndexList[b]));
+            result.push_back(static_cast<Index>(mIndexList[c]));
+        };
+
+        // Connect u to all vertices on the stack, which are all on the other chain
+        auto fan = [&](std::uint32_t u, bool isLeft) {
+            for (std::size_t i = 0; i + 1 < mStack.size(); ++i)
+            {
+                if (isLeft)
+                    emit(u, mStack[i + 1].first, mStack[i].first);
+                else
+                    emit(u, mStack[i].first, mStack[i + 1].first);
+            }
+        };
+
+        mStack.clear();
+        mStack.push_back(mSequence[0]);
+        mStack.push_back(mSequence[1]);
+
+        for (std::uint32_t j = 2; j + 1 < n; ++j)
+        {
+            auto u = mSequence[j];
+            if (u.second != mStack.back().second)
+            {
+                fan(u.first, u.second);
+                mStack.clear();
+                mStack.push_back(mSequence[j - 1]);
+                mStack.push_back(u);
+                continue;
+            }
+
+            auto last = mStack.back();
+            mStack.pop_back();
+            while (!mStack.empty())
+            {
+                auto above = mStack.back().first;
+                if (u.second)
+                {
+                    if (orient2d(mPointList[above], mPointList[last.first], mPointList[u.first]) <= 0)
+                        break;
+                    emit(above, last.first, u.first);
+                }
+                else
+                {
+                    if (orient2d(mPointList[u.first], mPointList[last.first], mPointList[above]) <= 0)
+                        break;
+                    emit(u.first, last.first, above);
+                }
+                last = mStack.back();
+                mStack.pop_back();
+            }
+            mStack.push_back(last);
+            mStack.push_back(u);
+        }
+
+        // The bottom vertex is on both chains, and closes the remaining funnel
+        fan(mSequence[n - 1].first, !mStack.back().second);
+    }
+
+    MemoryResource& mResource;
+    ScratchVector<P> mPointList;
+    SlotList mIndexList;
+    SlotList mPrevList;
+    SlotList mNextList;
+    SlotList mDiagonalList;
+    ScratchVector<std::pair<std::uint32_t, bool>> mSequence;
+    ScratchVector<std::pair<std::uint32_t, bool>> mStack;
+    std::uint32_t mQuery = 0;
+    std::uint32_t mQueryVertex = 0;
+};
+
+template <class Points, class Index>
+void monotoneTriangulationImpl(Points const& pointList,
+                               BasicIndexList<Index> const& polygon,
+                               std::vector<BasicIndexList<Index>> const& holeList,
+                               BasicIndexList<Index>& result,
+                               MemoryResource& resource)
+{
+    if (polygon.size() < 3)
+        throw std::invalid_argument("Polygon needs at least 3 vertices");
+
+    std::size_t vertexCount = polygon.size(), ringCount = 1;
+    for (auto const& hole : holeList)
+    {
+        if (hole.empty())
+            continue;
+        if (hole.size() < 3)
+            throw std::invalid_argument("Holes need at least 3 vertices");
+        vertexCount += hole.size();
+        ++ringCount;
+    }
+
+    using ExactPoint = decltype(exactPoint(pointList, std::size_t()));
+    MonotoneSweep<ExactPoint> sweep(vertexCount, resource);
+    sweep.addRing(pointList, polygon);
+    for (auto const& hole : holeList)
+    {
+        if (!hole.empty())
+            sweep.addRing(pointList, hole);
+    }
+
+    // Each hole adds two triangles
+    result.clear();
+    result.reserve((vertexCount + 2 * ringCount - 4) * 3);
+    sweep.triangulate(result);
+}
+
+} // namespace
+
+template <class Index>
+BasicIndexList<Index> decomp::monotoneTriangulation(PointList const& pointList,
+                                                    BasicIndexList<Index> const& polygon,
+                                                    std::vector<BasicIndexList<Index>> const& holeList)
+{
+    BasicIndexList<Index> result;
+    monotoneTriangulation(pointList, polygon, holeList, result, newDeleteResource());
+    return result;
+}
+
+template <class Points, class Index>
+void decomp::monotoneTriangulation(Points const& pointList,
+                                   BasicIndexList<Index> const& polygon,
+                                   std::vector<BasicIndexList<Index>> const& holeList,
+                                   BasicIndexList<Index>& result,
+                                   MemoryResource& resource)
+{
+    monotoneTriangulationImpl(pointList, polygon, holeList, result, resource);
+}
+
+template IndexList decomp::monotoneTriangulation(PointList const&, IndexList const&, std::vector<IndexList> const&);
+template IndexList32
+decomp::monotoneTriangulation(PointList const&, IndexList32 const&, std::vector<IndexList32> const&);
+template void decomp::monotoneTriangulation(
+    PointList const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    PointList const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    FloatPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    FloatPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    PointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    PointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    FixedPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    FixedPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    IntegerPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::monotoneTriangulation(
+    IntegerPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
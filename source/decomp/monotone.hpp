@@ -0,0 +1,40 @@
+#ifndef LIB_DECOMP_MONOTONE
+#define LIB_DECOMP_MONOTONE
+
+#include "triangulation.hpp"
+
+namespace decomp
+{
+
+/** Triangulate a simple polygon with simple holes in O(n log n) time, by splitting it into y-monotone pieces
+    with a plane sweep, and triangulating each piece in linear time.
+    The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
+    Unlike earClipping, this takes the holes directly, so removeHoles is not needed. The triangles are
+    counter-clockwise, like the ones from earClipping, and can be passed on to buildHalfEdgeGraph.
+    Throws std::invalid_argument if the outer polygon or a hole has fewer than 3 vertices, while empty holes
+    are ignored. Input that is not simple may result in std::runtime_error.
+ */
+template <class Index>
+BasicIndexList<Index> monotoneTriangulation(PointList const& pointList,
+                                            BasicIndexList<Index> const& polygon,
+                                            std::vector<BasicIndexList<Index>> const& holeList = {});
+
+inline IndexList
+monotoneTriangulation(PointList const& pointList, IndexList const& polygon, std::vector<IndexList> const& holeList = {})
+{
+    return monotoneTriangulation<std::uint16_t>(pointList, polygon, holeList);
+}
+
+/** Same as above, but write into the given result to reuse its memory, and take all
+    temporary storage from the given resource.
+ */
+template <class Points, class Index>
+void monotoneTriangulation(Points const& pointList,
+                           BasicIndexList<Index> const& polygon,
+                           std::vector<BasicIndexList<Index>> const& holeList,
+                           BasicIndexList<Index>& result,
+                           MemoryResource& resource);
+
+} // namespace decomp
+
+#endif
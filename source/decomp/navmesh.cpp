@@ -0,0 +1,306 @@
+#include "navmesh.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DECOMP_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace decomp;
+
+namespace
+{
+
+char const navMeshMagic[4] = { 'D', 'N', 'A', 'V' };
+
+static_assert(sizeof(NavMeshHeader) % 8 == 0, "Sections after the header need to be aligned to 8 bytes");
+
+std::uint64_t padded(std::uint64_t size)
+{
+    return (size + 7) & ~std::uint64_t(7);
+}
+
+// Start of each section, relative to the end of the header
+struct Layout
+{
+    std::uint64_t pointList;
+    std::uint64_t ringOffsetList;
+    std::uint64_t ringIndexList;
+    std::uint64_t polygonOffsetList;
+    std::uint64_t polygonIndexList;
+    std::uint64_t neighborList;
+    std::uint64_t neighborSideList;
+    std::uint64_t size;
+};
+
+Layout computeLayout(NavMeshHeader const& header)
+{
+    auto const offsetSize = sizeof(std::uint32_t);
+
+    Layout layout;
+    layout.pointList = 0;
+    layout.ringOffsetList = layout.pointList + padded(std::uint64_t(header.pointCount) * 2 * sizeof(double));
+    layout.ringIndexList = layout.ringOffsetList + padded((std::uint64_t(header.ringCount) + 1) * offsetSize);
+    layout.polygonOffsetList = layout.ringIndexList + padded(std::uint64_t(header.ringIndexCount) * header.indexSize);
+    layout.polygonIndexList =
+        layout.polygonOffsetList + padded((std::uint64_t(header.polygonCount) + 1) * offsetSize);
+    layout.neighborList =
+        layout.polygonIndexList + padded(std::uint64_t(header.polygonIndexCount) * header.indexSize);
+    layout.neighborSideList = layout.neighborList;
+    layout.size = layout.neighborList;
+
+    if (header.flags & navMeshHasAdjacency)
+    {
+        layout.neighborSideList = layout.neighborList + padded(std::uint64_t(header.polygonIndexCount) * offsetSize);
+        layout.size = layout.neighborSideList + padded(std::uint64_t(header.polygonIndexCount) * offsetSize);
+    }
+    return layout;
+}
+
+// FNV-1a on 8-byte words instead of single bytes, with the high bits folded back in after each step.
+// This is fast enough to check each time a navmesh is loaded.
+std::uint64_t computeChecksum(std::uint64_t const* wordList, std::size_t count)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        hash = (hash ^ wordList[i]) * 1099511628211ull;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+template <class T> void copySection(unsigned char* payload, std::uint64_t offset, T const* data, std::size_t count)
+{
+    if (count > 0)
+        std::memcpy(payload + offset, data, count * sizeof(T));
+}
+
+} // namespace
+
+template <class Index>
+void decomp::writeNavMesh(std::ostream& out,
+                          PointView const& pointList,
+                          BasicIndexList<Index> const& simplePolygon,
+                          std::vector<BasicIndexList<Index>> const& holeList,
+                          BasicFlatPolygonList<Index> const& polygonList,
+                          PolygonAdjacency const* adjacency)
+{
+    auto const polygonCount = polygonList.size();
+    auto const polygonIndexCount = polygonList.indexList.size();
+    if (adjacency &&
+        (adjacency->polygonCount() != polygonCount || adjacency->neighborList.size() != polygonIndexCount ||
+         adjacency->neighborSideList.size() != polygonIndexCount))
+        throw std::invalid_argument("Adjacency does not match the polygons");
+
+    std::vector<std::uint32_t> ringOffsetList(1, 0);
+    ringOffsetList.push_back(static_cast<std::uint32_t>(simplePolygon.size()));
+    for (auto const& hole : holeList)
+        ringOffsetList.push_back(static_cast<std::uint32_t>(ringOffsetList.back() + hole.size()));
+
+    NavMeshHeader header;
+    std::memcpy(header.magic, navMeshMagic, sizeof(navMeshMagic));
+    header.endianTag = navMeshEndianTag;
+    header.version = navMeshVersion;
+    header.indexSize = sizeof(Index);
+    header.flags = adjacency ? navMeshHasAdjacency : 0;
+    header.pointCount = static_cast<std::uint32_t>(pointList.size());
+    header.ringCount = static_cast<std::uint32_t>(holeList.size() + 1);
+    header.ringIndexCount = ringOffsetList.back();
+    header.polygonCount = static_cast<std::uint32_t>(polygonCount);
+    header.polygonIndexCount = static_cast<std::uint32_t>(polygonIndexCount);
+
+    auto layout = computeLayout(header);
+    header.payloadSize = layout.size;
+
+    // Zeros in the padding keep the checksum the same for the same contents
+    std::vector<std::uint64_t> wordList(layout.size / 8, 0);
+    auto payload = reinterpret_cast<unsigned char*>(wordList.data());
+
+    auto pointData = reinterpret_cast<double*>(payload + layout.pointList);
+    for (std::size_t i = 0; i < pointList.size(); ++i)
+    {
+        auto point = pointList[i];
+        pointData[2 * i] = point[0];
+        pointData[2 * i + 1] = point[1];
+    }
+
+    copySection(payload, layout.ringOffsetList, ringOffsetList.data(), ringOffsetList.size());
+    auto ringIndexList = reinterpret_cast<Index*>(payload + layout.ringIndexList);
+    ringIndexList = std::copy(simplePolygon.begin(), simplePolygon.end(), ringIndexList);
+    for (auto const& hole : holeList)
+        ringIndexList = std::copy(hole.begin(), hole.end(), ringIndexList);
+
+    // A default-constructed list has no offsets at all
+    std::uint32_t const emptyOffset = 0;
+    if (polygonList.offsetList.empty())
+        copySection(payload, layout.polygonOffsetList, &emptyOffset, 1);
+    else
+        copySection(payload, layout.polygonOffsetList, polygonList.offsetList.data(), polygonList.offsetList.size());
+    copySection(payload, layout.polygonIndexList, polygonList.indexList.data(), polygonIndexCount);
+
+    if (adjacency)
+    {
+        copySection(payload, layout.neighborList, adjacency->neighborList.data(), polygonIndexCount);
+        copySection(payload, layout.neighborSideList, adjacency->neighborSideList.data(), polygonIndexCount);
+    }
+
+    header.checksum = computeChecksum(wordList.data(), wordList.size());
+
+    out.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    out.write(reinterpret_cast<char const*>(payload), static_cast<std::streamsize>(layout.size));
+    if (!out)
+        throw std::runtime_error("Could not write navmesh");
+}
+
+template <class Index>
+void decomp::writeNavMesh(std::ostream& out,
+                          PointView const& pointList,
+                          BasicIndexList<Index> const& simplePolygon,
+                          std::vector<BasicIndexList<Index>> const& holeList,
+                          std::vector<BasicIndexList<Index>> const& polygonList,
+                          PolygonAdjacency const* adjacency)
+{
+    BasicFlatPolygonList<Index> flatList;
+    BasicFlatPolygonSink<Index> sink(flatList);
+    for (auto const& polygon : polygonList)
+        sink.polygon(polygon.data(), polygon.size());
+
+    writeNavMesh(out, pointList, simplePolygon, holeList, flatList, adjacency);
+}
+
+decomp::NavMeshFile::NavMeshFile(std::string const& path)
+{
+#ifdef DECOMP_MMAP
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error("Could not open navmesh " + path);
+
+    struct stat status;
+    if (::fstat(file, &status) != 0)
+    {
+        ::close(file);
+        throw std::runtime_error("Could not open navmesh " + path);
+    }
+
+    // Mapping an empty file fails, and the view rejects it anyway
+    mSize = static_cast<std::size_t>(status.st_size);
+    if (mSize > 0)
+    {
+        void* data = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED)
+        {
+            mData = data;
+            mMapped = true;
+        }
+    }
+    ::close(file);
+
+    if (mMapped || mSize == 0)
+        return;
+#endif
+
+    // Read into 8-byte words, so the sections are aligned as in a mapped file
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+        throw std::runtime_error("Could not open navmesh " + path);
+
+    mSize = static_cast<std::size_t>(in.tellg());
+    mBuffer.resize((mSize + 7) / 8);
+    in.seekg(0);
+    in.read(reinterpret_cast<char*>(mBuffer.data()), static_cast<std::streamsize>(mSize));
+    if (!in)
+        throw std::runtime_error("Could not read navmesh " + path);
+
+    mData = mBuffer.data();
+}
+
+decomp::NavMeshFile::~NavMeshFile()
+{
+#ifdef DECOMP_MMAP
+    if (mMapped)
+        ::munmap(const_cast<void*>(mData), mSize);
+#endif
+}
+
+template <class Index>
+decomp::BasicNavMeshView<Index>::BasicNavMeshView(void const* data, std::size_t size, bool verifyChecksum)
+{
+    if (size < sizeof(NavMeshHeader))
+        throw std::runtime_error("Navmesh is too small");
+
+    if (reinterpret_cast<std::uintptr_t>(data) % 8 != 0)
+        throw std::runtime_error("Navmesh needs to be aligned to 8 bytes");
+
+    mHeader = static_cast<NavMeshHeader const*>(data);
+    if (std::memcmp(mHeader->magic, navMeshMagic, sizeof(navMeshMagic)) != 0)
+        throw std::runtime_error("Not a navmesh");
+
+    if (mHeader->endianTag != navMeshEndianTag)
+        throw std::runtime_error("Navmesh was written with a different byte order");
+
+    if (mHeader->version != navMeshVersion)
+        throw std::runtime_error("Navmesh version is not supported");
+
+    if (mHeader->indexSize != sizeof(Index))
+        throw std::runtime_error("Navmesh has a different index type");
+
+    auto layout = computeLayout(*mHeader);
+    if (mHeader->payloadSize != layout.size || size - sizeof(NavMeshHeader) < layout.size)
+        throw std::runtime_error("Navmesh is truncated");
+
+    auto payload = static_cast<unsigned char const*>(data) + sizeof(NavMeshHeader);
+    if (verifyChecksum &&
+        computeChecksum(reinterpret_cast<std::uint64_t const*>(payload), layout.size / 8) != mHeader->checksum)
+        throw std::runtime_error("Navmesh checksum does not match");
+
+    mPointData = reinterpret_cast<double const*>(payload + layout.pointList);
+    mRingOffsetList = reinterpret_cast<std::uint32_t const*>(payload + layout.ringOffsetList);
+    mRingIndexList = reinterpret_cast<Index const*>(payload + layout.ringIndexList);
+    mPolygonOffsetList = reinterpret_cast<std::uint32_t const*>(payload + layout.polygonOffsetList);
+    mPolygonIndexList = reinterpret_cast<Index const*>(payload + layout.polygonIndexList);
+    if (mHeader->flags & navMeshHasAdjacency)
+    {
+        mNeighborList = reinterpret_cast<std::uint32_t const*>(payload + layout.neighborList);
+        mNeighborSideList = reinterpret_cast<std::uint32_t const*>(payload + layout.neighborSideList);
+    }
+
+    // The offsets are only read on access, so at least their ends need to stay within the sections
+    if (mRingOffsetList[mHeader->ringCount] != mHeader->ringIndexCount ||
+        mPolygonOffsetList[mHeader->polygonCount] != mHeader->polygonIndexCount)
+        throw std::runtime_error("Navmesh offsets do not match its sizes");
+}
+
+template void decomp::writeNavMesh(std::ostream&,
+                                   PointView const&,
+                                   IndexList const&,
+                                   std::vector<IndexList> const&,
+                                   FlatPolygonList const&,
+                                   PolygonAdjacency const*);
+template void decomp::writeNavMesh(std::ostream&,
+                                   PointView const&,
+                                   IndexList32 const&,
+                                   std::vector<IndexList32> const&,
+                                   FlatPolygonList32 const&,
+                                   PolygonAdjacency const*);
+template void decomp::writeNavMesh(std::ostream&,
+                                   PointView const&,
+                                   IndexList const&,
+                                   std::vector<IndexList> const&,
+                                   std::vector<IndexList> const&,
+                                   PolygonAdjacency const*);
+template void decomp::writeNavMesh(std::ostream&,
+                                   PointView const&,
+                                   IndexList32 const&,
+                                   std::vector<IndexList32> const&,
+                                   std::vector<IndexList32> const&,
+                                   PolygonAdjacency const*);
+
+template class decomp::BasicNavMeshView<std::uint16_t>;
+template class decomp::BasicNavMeshView<std::uint32_t>;
@@ -0,0 +1,219 @@
+#ifndef LIB_DECOMP_NAVMESH
+#define LIB_DECOMP_NAVMESH
+
+#include "convex_decomposition.hpp"
+#include <ostream>
+#include <string>
+
+namespace decomp
+{
+
+/** Version of the binary navmesh format written by writeNavMesh. Views only accept this version.
+ */
+std::uint32_t const navMeshVersion = 1;
+
+/** Value of NavMeshHeader::endianTag in the byte order of the machine that wrote the navmesh.
+ */
+std::uint32_t const navMeshEndianTag = 0x01020304;
+
+/** Bit in NavMeshHeader::flags that is set if the navmesh has an adjacency section.
+ */
+std::uint32_t const navMeshHasAdjacency = 1;
+
+/** Header at the start of a binary navmesh. It is followed by these sections, each of which starts at a multiple
+    of 8 bytes, with zeros in between:
+    - the points, as pointCount pairs of doubles,
+    - the rings of the input, i.e. the outer polygon followed by the holes, as ringCount + 1 offsets of type
+      std::uint32_t and ringIndexCount indices,
+    - the convex polygons in the same layout, with polygonCount + 1 offsets and polygonIndexCount indices,
+    - if flags has navMeshHasAdjacency, the neighbor and the neighbor side of each side of the polygons, as two arrays
+      of polygonIndexCount std::uint32_t values, see PolygonAdjacency.
+    Indices have indexSize bytes. All values are in the byte order of the writer, which is checked with endianTag.
+ */
+struct NavMeshHeader
+{
+    char magic[4];
+    std::uint32_t endianTag;
+    std::uint32_t version;
+    std::uint32_t indexSize;
+    std::uint32_t flags;
+    std::uint32_t pointCount;
+    std::uint32_t ringCount;
+    std::uint32_t ringIndexCount;
+    std::uint32_t polygonCount;
+    std::uint32_t polygonIndexCount;
+
+    /** Number of bytes after the header.
+     */
+    std::uint64_t payloadSize;
+
+    /** Checksum of the bytes after the header, which is computed 8 bytes at a time.
+     */
+    std::uint64_t checksum;
+};
+
+/** Write a binary navmesh with the given points, the input rings and their convex polygons, and optionally their
+    adjacency, which needs to be for the same polygons. The result can be memory-mapped and used in place with
+    a BasicNavMeshView.
+    Throws std::invalid_argument if the adjacency does not match the polygons, and std::runtime_error if writing fails.
+ */
+template <class Index>
+void writeNavMesh(std::ostream& out,
+                  PointView const& pointList,
+                  BasicIndexList<Index> const& simplePolygon,
+                  std::vector<BasicIndexList<Index>> const& holeList,
+                  BasicFlatPolygonList<Index> const& polygonList,
+                  PolygonAdjacency const* adjacency = nullptr);
+
+/** Same as above, for polygons as returned by decompose.
+ */
+template <class Index>
+void writeNavMesh(std::ostream& out,
+                  PointView const& pointList,
+                  BasicIndexList<Index> const& simplePolygon,
+                  std::vector<BasicIndexList<Index>> const& holeList,
+                  std::vector<BasicIndexList<Index>> const& polygonList,
+                  PolygonAdjacency const* adjacency = nullptr);
+
+/** A binary navmesh file, kept in memory until destroyed. Where the platform supports it, the file is
+    memory-mapped, so only the parts that are used are read. Otherwise, it is read into memory all at once.
+ */
+class NavMeshFile
+{
+public:
+    /** Throws std::runtime_error if the file can not be read.
+     */
+    explicit NavMeshFile(std::string const& path);
+    ~NavMeshFile();
+
+    NavMeshFile(NavMeshFile const&) = delete;
+    NavMeshFile& operator=(NavMeshFile const&) = delete;
+
+    void const* data() const
+    {
+        return mData;
+    }
+
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+private:
+    void const* mData = nullptr;
+    std::size_t mSize = 0;
+    bool mMapped = false;
+    std::vector<std::uint64_t> mBuffer;
+};
+
+/** Zero-copy view of a binary navmesh written by writeNavMesh with the same index type.
+    Views do not own their memory, which needs to outlive them.
+ */
+template <class Index> class BasicNavMeshView
+{
+public:
+    /** View the navmesh in the given memory, e.g. a memory-mapped file, which needs to be aligned to 8 bytes.
+        Throws std::runtime_error if it is not a navmesh of this version and index type, if it was written with
+        a different byte order, or if its checksum does not match. Checking the checksum reads all of the memory,
+        so it can be skipped for memory that is already known to be intact.
+     */
+    BasicNavMeshView(void const* data, std::size_t size, bool verifyChecksum = true);
+
+    explicit BasicNavMeshView(NavMeshFile const& file, bool verifyChecksum = true)
+    : BasicNavMeshView(file.data(), file.size(), verifyChecksum)
+    {
+    }
+
+    NavMeshHeader const& header() const
+    {
+        return *mHeader;
+    }
+
+    /** The points, which can be passed to the algorithms directly.
+     */
+    PointView pointView() const
+    {
+        return PointView(mPointData, mPointData + 1, mHeader->pointCount, 2);
+    }
+
+    std::size_t ringCount() const
+    {
+        return mHeader->ringCount;
+    }
+
+    /** Ring 0 is the outer polygon, and the others are the holes.
+     */
+    Index const* ring(std::size_t ring) const
+    {
+        return mRingIndexList + mRingOffsetList[ring];
+    }
+
+    std::size_t ringSize(std::size_t ring) const
+    {
+        return mRingOffsetList[ring + 1] - mRingOffsetList[ring];
+    }
+
+    std::size_t polygonCount() const
+    {
+        return mHeader->polygonCount;
+    }
+
+    Index const* polygon(std::size_t polygon) const
+    {
+        return mPolygonIndexList + mPolygonOffsetList[polygon];
+    }
+
+    std::size_t polygonSize(std::size_t polygon) const
+    {
+        return mPolygonOffsetList[polygon + 1] - mPolygonOffsetList[polygon];
+    }
+
+    /** Start of each polygon in the polygon indices, followed by their total number, like
+        BasicFlatPolygonList::offsetList.
+     */
+    std::uint32_t const* polygonOffsetList() const
+    {
+        return mPolygonOffsetList;
+    }
+
+    Index const* polygonIndexList() const
+    {
+        return mPolygonIndexList;
+    }
+
+    bool hasAdjacency() const
+    {
+        return mNeighborList != nullptr;
+    }
+
+    /** Same as PolygonAdjacency::neighbor, only valid if hasAdjacency.
+     */
+    std::uint32_t neighbor(std::size_t polygon, std::size_t side) const
+    {
+        return mNeighborList[mPolygonOffsetList[polygon] + side];
+    }
+
+    /** Same as PolygonAdjacency::neighborSide, only valid if hasAdjacency.
+     */
+    std::uint32_t neighborSide(std::size_t polygon, std::size_t side) const
+    {
+        return mNeighborSideList[mPolygonOffsetList[polygon] + side];
+    }
+
+private:
+    NavMeshHeader const* mHeader;
+    double const* mPointData;
+    std::uint32_t const* mRingOffsetList;
+    Index const* mRingIndexList;
+    std::uint32_t const* mPolygonOffsetList;
+    Index const* mPolygonIndexList;
+    std::uint32_t const* mNeighborList = nullptr;
+    std::uint32_t const* mNeighborSideList = nullptr;
+};
+
+using NavMeshView = BasicNavMeshView<std::uint16_t>;
+using NavMeshView32 = BasicNavMeshView<std::uint32_t>;
+
+} // namespace decomp
+
+#endif
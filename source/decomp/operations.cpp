@@ -1,20 +1,21 @@
 #include "operations.hpp"
+#include <utility>
 
 using namespace decomp;
 
-IndexList Remapper::apply(IndexList const& indices)
+template <class Index> BasicIndexList<Index> BasicRemapper<Index>::apply(BasicIndexList<Index> const& indices)
 {
-    IndexList result;
+    BasicIndexList<Index> result;
     result.reserve(indices.size());
     for (auto each : indices)
     {
-        auto const inserted = mMapping.insert(std::make_pair(each, static_cast<std::uint16_t>(mMapping.size())));
+        auto const inserted = mMapping.insert(std::make_pair(each, static_cast<Index>(mMapping.size())));
         result.push_back(inserted.first->second);
     }
     return result;
 }
 
-PointList Remapper::mapped(PointList const& points)
+template <class Index> PointList BasicRemapper<Index>::mapped(PointList const& points)
 {
     PointList result;
     result.resize(mMapping.size());
@@ -24,3 +25,43 @@ PointList Remapper::mapped(PointList const& points)
     }
     return result;
 }
+
+template <class Index> double decomp::signedArea(PointList const& pointList, BasicIndexList<Index> const& polygon)
+{
+    double result = 0.0;
+    auto const N = polygon.size();
+    for (std::size_t i = 0, j = N - 1; i < N; j = i++)
+    {
+        auto const& a = pointList[polygon[j]];
+        auto const& b = pointList[polygon[i]];
+        result += a.x() * b.y() - a.y() * b.x();
+    }
+    return result * 0.5;
+}
+
+template <class Index>
+bool decomp::containsPoint(PointList const& pointList, BasicIndexList<Index> const& polygon, Point const& p)
+{
+    bool inside = false;
+    auto const N = polygon.size();
+    for (std::size_t i = 0, j = N - 1; i < N; j = i++)
+    {
+        auto a = pointList[polygon[i]];
+        auto b = pointList[polygon[j]];
+        if ((a.y() > p.y()) == (b.y() > p.y()))
+            continue;
+
+        if (b.y() < a.y())
+            std::swap(a, b);
+        if (p.x() < a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y()))
+            inside = !inside;
+    }
+    return inside;
+}
+
+template class decomp::BasicRemapper<std::uint16_t>;
+template class decomp::BasicRemapper<std::uint32_t>;
+template double decomp::signedArea(PointList const&, IndexList const&);
+template double decomp::signedArea(PointList const&, IndexList32 const&);
+template bool decomp::containsPoint(PointList const&, IndexList const&, Point const&);
+template bool decomp::containsPoint(PointList const&, IndexList32 const&, Point const&);
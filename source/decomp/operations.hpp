@@ -10,21 +10,34 @@ namespace decomp
 
 /** Utility to remove unused vertices from a point-list.
  */
-class Remapper
+template <class Index> class BasicRemapper
 {
 public:
     /** Successively use this to remap all your indices.
      */
-    IndexList apply(IndexList const& indices);
+    BasicIndexList<Index> apply(BasicIndexList<Index> const& indices);
 
     /** Once all indices are remapped, get the new mapped point list here.
      */
     PointList mapped(PointList const& points);
 
 private:
-    std::unordered_map<std::uint16_t, std::uint16_t> mMapping;
+    std::unordered_map<Index, Index> mMapping;
 };
 
+using Remapper = BasicRemapper<std::uint16_t>;
+using Remapper32 = BasicRemapper<std::uint32_t>;
+
+/** Signed area of a polygon, by the shoelace formula. It is positive for counter-clockwise polygons.
+ */
+template <class Index> double signedArea(PointList const& pointList, BasicIndexList<Index> const& polygon);
+
+/** Whether p is inside the given polygon, by the crossing number of a ray to the right. Each edge is interpolated
+    from its lower end, so the result does not depend on the direction of the polygon.
+ */
+template <class Index>
+bool containsPoint(PointList const& pointList, BasicIndexList<Index> const& polygon, Point const& p);
+
 } // namespace decomp
 
 #endif
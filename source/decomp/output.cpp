@@ -27,7 +27,8 @@ void writeSvgFooter(std::ostream& out)
     out << std::endl;
 }
 
-void writeSvgPolygon(std::ostream& svg, PointList const& points, IndexList const& indices, char const* color)
+template <class Index>
+void writeSvgPolygon(std::ostream& svg, PointList const& points, BasicIndexList<Index> const& indices, char const* color)
 {
     svg << "    <polygon points=\"";
 
@@ -71,10 +72,11 @@ template <class Container, class F> void writeJsonArray(std::ostream& out, Conta
 
 } // namespace
 
+template <class Index>
 void svg::writePolygon(std::ostream& svg,
                        PointList const& points,
-                       IndexList const& indices,
-                       std::vector<IndexList> const& holes)
+                       BasicIndexList<Index> const& indices,
+                       std::vector<BasicIndexList<Index>> const& holes)
 {
     Point min{ std::numeric_limits<float>::max() };
     Point max{ -std::numeric_limits<float>::max() };
@@ -100,7 +102,8 @@ void svg::writePolygon(std::ostream& svg,
     writeSvgFooter(svg);
 }
 
-void svg::writeTriangles(std::ostream& svg, PointList const& points, IndexList const& indices)
+template <class Index>
+void svg::writeTriangles(std::ostream& svg, PointList const& points, BasicIndexList<Index> const& indices)
 {
     Point min{ std::numeric_limits<float>::max() };
     Point max{ -std::numeric_limits<float>::max() };
@@ -139,7 +142,7 @@ void decomp::writePoints(std::ostream& out, PointList const& points)
     out << "}";
 }
 
-void decomp::writeIndices(std::ostream& out, std::vector<IndexList> const& indices)
+template <class Index> void decomp::writeIndices(std::ostream& out, std::vector<BasicIndexList<Index>> const& indices)
 {
     out << "{";
     for (auto const& list : indices)
@@ -150,7 +153,7 @@ void decomp::writeIndices(std::ostream& out, std::vector<IndexList> const& indic
     out << "}";
 }
 
-void decomp::writeIndices(std::ostream& out, IndexList const& indices)
+template <class Index> void decomp::writeIndices(std::ostream& out, BasicIndexList<Index> const& indices)
 {
     out << "{";
     for (auto const& index : indices)
@@ -158,11 +161,12 @@ void decomp::writeIndices(std::ostream& out, IndexList const& indices)
     out << "}";
 }
 
+template <class Index>
 std::ostream& json::dump(std::ostream& out,
                          PointList const& pointList,
-                         IndexList const& outerPolygon,
-                         std::vector<IndexList> const& holeList,
-                         std::vector<IndexList> const& convexPolygonList)
+                         BasicIndexList<Index> const& outerPolygon,
+                         std::vector<BasicIndexList<Index>> const& holeList,
+                         std::vector<BasicIndexList<Index>> const& convexPolygonList)
 {
     out << "{" << std::endl;
     out << "\"vertices\":" << std::endl;
@@ -170,17 +174,33 @@ std::ostream& json::dump(std::ostream& out,
     out << "," << std::endl;
     out << "\"input\": {" << std::endl;
     out << "\"outer\": " << std::endl;
-    writeJsonArray(out, outerPolygon, [](std::ostream& os, std::uint16_t const& p) { os << p; });
+    writeJsonArray(out, outerPolygon, [](std::ostream& os, Index const& p) { os << p; });
     out << "," << std::endl;
     out << "\"holes\": " << std::endl;
-    writeJsonArray(out, holeList, [](std::ostream& os, IndexList const& hole) {
-        writeJsonArray(os, hole, [](std::ostream& os, std::uint16_t index) { os << index; });
+    writeJsonArray(out, holeList, [](std::ostream& os, BasicIndexList<Index> const& hole) {
+        writeJsonArray(os, hole, [](std::ostream& os, Index index) { os << index; });
     });
     out << std::endl << "}," << std::endl;
     out << "\"output\":" << std::endl << "[";
-    writeJsonArray(out, convexPolygonList, [](std::ostream& os, IndexList const& hole) {
-        writeJsonArray(os, hole, [](std::ostream& os, std::uint16_t index) { os << index; });
+    writeJsonArray(out, convexPolygonList, [](std::ostream& os, BasicIndexList<Index> const& hole) {
+        writeJsonArray(os, hole, [](std::ostream& os, Index index) { os << index; });
     });
     out << "}" << std::endl;
     return out;
-}
\ No newline at end of file
+}
+
+template void svg::writePolygon(std::ostream&, PointList const&, IndexList const&, std::vector<IndexList> const&);
+template void svg::writePolygon(std::ostream&, PointList const&, IndexList32 const&, std::vector<IndexList32> const&);
+template void svg::writeTriangles(std::ostream&, PointList const&, IndexList const&);
+template void svg::writeTriangles(std::ostream&, PointList const&, IndexList32 const&);
+template void decomp::writeIndices(std::ostream&, IndexList const&);
+template void decomp::writeIndices(std::ostream&, IndexList32 const&);
+template void decomp::writeIndices(std::ostream&, std::vector<IndexList> const&);
+template void decomp::writeIndices(std::ostream&, std::vector<IndexList32> const&);
+template std::ostream& json::dump(
+    std::ostream&, PointList const&, IndexList const&, std::vector<IndexList> const&, std::vector<IndexList> const&);
+template std::ostream& json::dump(std::ostream&,
+                                  PointList const&,
+                                  IndexList32 const&,
+                                  std::vector<IndexList32> const&,
+                                  std::vector<IndexList32> const&);
@@ -11,14 +11,16 @@ namespace svg
 {
 /** Render the given polygon as SVG, mostly for debugging
  */
+template <class Index>
 void writePolygon(std::ostream& out,
                   PointList const& points,
-                  IndexList const& indices,
-                  std::vector<IndexList> const& holes);
+                  BasicIndexList<Index> const& indices,
+                  std::vector<BasicIndexList<Index>> const& holes);
 
 /** Render the given triangles as SVG, mostly for debugging
  */
-void writeTriangles(std::ostream& out, PointList const& points, IndexList const& indices);
+template <class Index>
+void writeTriangles(std::ostream& out, PointList const& points, BasicIndexList<Index> const& indices);
 
 } // namespace svg
 
@@ -26,11 +28,12 @@ namespace json
 {
 /** Convert the given inputs and output to a JSON text representation that is suitable for export and plotting.
  */
+template <class Index>
 std::ostream& dump(std::ostream& out,
                    PointList const& pointList,
-                   IndexList const& outerPolygon,
-                   std::vector<IndexList> const& holeList,
-                   std::vector<IndexList> const& convexPolygonList);
+                   BasicIndexList<Index> const& outerPolygon,
+                   std::vector<BasicIndexList<Index>> const& holeList,
+                   std::vector<BasicIndexList<Index>> const& convexPolygonList);
 } // namespace json
 
 /** Convert the given point list to a text representation that is suitable for initializer list usage.
@@ -39,11 +42,11 @@ void writePoints(std::ostream& out, PointList const& points);
 
 /** Convert the given index list to a text representation that is suitable for initializer list usage.
  */
-void writeIndices(std::ostream& out, IndexList const& indices);
+template <class Index> void writeIndices(std::ostream& out, BasicIndexList<Index> const& indices);
 
 /** Convert the given list of indexs list to a text representation that is suitable for initializer list usage.
  */
-void writeIndices(std::ostream& out, std::vector<IndexList> const& indices);
+template <class Index> void writeIndices(std::ostream& out, std::vector<BasicIndexList<Index>> const& indices);
 
 } // namespace decomp
 #endif
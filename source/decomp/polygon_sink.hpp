@@ -0,0 +1,211 @@
+#ifndef LIB_DECOMP_POLYGON_SINK
+#define LIB_DECOMP_POLYGON_SINK
+
+#include "triangulation.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace decomp
+{
+
+/** Receives the convex polygons of a decomposition one at a time, e.g. to write them into flat buffers
+    instead of one vector per polygon. Derive from this to plug in a custom output.
+ */
+template <class Index> class BasicPolygonSink
+{
+public:
+    virtual ~BasicPolygonSink() = default;
+
+    /** Take the next polygon, with its vertices in counter-clockwise order. The vertices are only valid
+        during the call.
+     */
+    void polygon(Index const* vertexList, std::size_t size)
+    {
+        doPolygon(vertexList, size);
+    }
+
+protected:
+    virtual void doPolygon(Index const* vertexList, std::size_t size) = 0;
+};
+
+using PolygonSink = BasicPolygonSink<std::uint16_t>;
+using PolygonSink32 = BasicPolygonSink<std::uint32_t>;
+
+/** Convex polygons in compressed sparse row layout, with the vertices of all polygons in one contiguous array.
+    The vertices of polygon p are indexList[offsetList[p]] up to indexList[offsetList[p + 1]], exclusive.
+    The offsets are the same as in a PolygonAdjacency of the same polygons.
+ */
+template <class Index> struct BasicFlatPolygonList
+{
+    BasicIndexList<Index> indexList;
+
+    /** Start of each polygon in the index list, followed by its total size.
+     */
+    std::vector<std::uint32_t> offsetList;
+
+    std::size_t size() const
+    {
+        return offsetList.empty() ? 0 : offsetList.size() - 1;
+    }
+
+    std::size_t size(std::size_t polygon) const
+    {
+        return offsetList[polygon + 1] - offsetList[polygon];
+    }
+
+    Index const* polygon(std::size_t polygon) const
+    {
+        return indexList.data() + offsetList[polygon];
+    }
+};
+
+using FlatPolygonList = BasicFlatPolygonList<std::uint16_t>;
+using FlatPolygonList32 = BasicFlatPolygonList<std::uint32_t>;
+
+/** Sink that replaces the contents of a BasicFlatPolygonList, keeping the memory it already has.
+ */
+template <class Index> class BasicFlatPolygonSink : public BasicPolygonSink<Index>
+{
+public:
+    explicit BasicFlatPolygonSink(BasicFlatPolygonList<Index>& result)
+    : mResult(result)
+    {
+        mResult.indexList.clear();
+        mResult.offsetList.assign(1, 0);
+    }
+
+protected:
+    void doPolygon(Index const* vertexList, std::size_t size) override
+    {
+        mResult.indexList.insert(mResult.indexList.end(), vertexList, vertexList + size);
+        mResult.offsetList.push_back(static_cast<std::uint32_t>(mResult.indexList.size()));
+    }
+
+private:
+    BasicFlatPolygonList<Index>& mResult;
+};
+
+using FlatPolygonSink = BasicFlatPolygonSink<std::uint16_t>;
+using FlatPolygonSink32 = BasicFlatPolygonSink<std::uint32_t>;
+
+/** Most polygons a decomposition of a polygon with holes can give, i.e. the number of triangles. The vertex count
+    includes the vertices of all holes, and empty holes do not count.
+ */
+inline std::size_t maxPolygonCount(std::size_t vertexCount, std::size_t holeCount)
+{
+    return vertexCount + 2 * holeCount - 2;
+}
+
+/** Most vertices of all polygons together, see maxPolygonCount.
+ */
+inline std::size_t maxIndexCount(std::size_t vertexCount, std::size_t holeCount)
+{
+    return 3 * maxPolygonCount(vertexCount, holeCount);
+}
+
+/** Sink that writes into caller-provided buffers in the layout of BasicFlatPolygonList, so the result needs no
+    allocation at all. The offset buffer needs room for one more entry than there are polygons.
+    Throws std::length_error if either buffer is too small, see maxIndexCount and maxPolygonCount.
+ */
+template <class Index> class BasicBufferSink : public BasicPolygonSink<Index>
+{
+public:
+    BasicBufferSink(Index* indexBuffer,
+                    std::size_t indexCapacity,
+                    std::uint32_t* offsetBuffer,
+                    std::size_t offsetCapacity)
+    : mIndexBuffer(indexBuffer)
+    , mIndexCapacity(indexCapacity)
+    , mOffsetBuffer(offsetBuffer)
+    , mOffsetCapacity(offsetCapacity)
+    {
+        if (mOffsetCapacity == 0)
+            throw std::length_error("Offset buffer is too small");
+
+        mOffsetBuffer[0] = 0;
+    }
+
+    std::size_t polygonCount() const
+    {
+        return mPolygonCount;
+    }
+
+    std::size_t indexCount() const
+    {
+        return mIndexCount;
+    }
+
+protected:
+    void doPolygon(Index const* vertexList, std::size_t size) override
+    {
+        if (mIndexCapacity - mIndexCount < size)
+            throw std::length_error("Index buffer is too small");
+
+        if (mPolygonCount + 2 > mOffsetCapacity)
+            throw std::length_error("Offset buffer is too small");
+
+        std::copy(vertexList, vertexList + size, mIndexBuffer + mIndexCount);
+        mIndexCount += size;
+        mOffsetBuffer[++mPolygonCount] = static_cast<std::uint32_t>(mIndexCount);
+    }
+
+private:
+    Index* mIndexBuffer;
+    std::size_t mIndexCapacity;
+    std::uint32_t* mOffsetBuffer;
+    std::size_t mOffsetCapacity;
+    std::size_t mIndexCount = 0;
+    std::size_t mPolygonCount = 0;
+};
+
+using BufferSink = BasicBufferSink<std::uint16_t>;
+using BufferSink32 = BasicBufferSink<std::uint32_t>;
+
+/** Sink that writes the vertices and offsets in the layout of BasicFlatPolygonList to a pair of output iterators,
+    e.g. std::back_inserter of the caller's own containers.
+ */
+template <class Index, class IndexIterator, class OffsetIterator>
+class IteratorSink : public BasicPolygonSink<Index>
+{
+public:
+    IteratorSink(IndexIterator indexOutput, OffsetIterator offsetOutput)
+    : mIndexOutput(indexOutput)
+    , mOffsetOutput(offsetOutput)
+    {
+        *mOffsetOutput++ = 0;
+    }
+
+    IndexIterator indexOutput() const
+    {
+        return mIndexOutput;
+    }
+
+    OffsetIterator offsetOutput() const
+    {
+        return mOffsetOutput;
+    }
+
+protected:
+    void doPolygon(Index const* vertexList, std::size_t size) override
+    {
+        mIndexOutput = std::copy(vertexList, vertexList + size, mIndexOutput);
+        mIndexCount += size;
+        *mOffsetOutput++ = static_cast<std::uint32_t>(mIndexCount);
+    }
+
+private:
+    IndexIterator mIndexOutput;
+    OffsetIterator mOffsetOutput;
+    std::size_t mIndexCount = 0;
+};
+
+template <class Index, class IndexIterator, class OffsetIterator>
+IteratorSink<Index, IndexIterator, OffsetIterator> makeIteratorSink(IndexIterator indexOutput,
+                                                                    OffsetIterator offsetOutput)
+{
+    return IteratorSink<Index, IndexIterator, OffsetIterator>(indexOutput, offsetOutput);
+}
+
+} // namespace decomp
+
+#endif
@@ -0,0 +1,330 @@
+#include "predicates.hpp"
+
+using namespace decomp;
+
+namespace
+{
+
+// Expansion arithmetic after Shewchuk. An expansion is a sum of doubles ordered by increasing magnitude,
+// where the components do not overlap, so it represents its sum exactly. This needs IEEE round-to-nearest
+// arithmetic without fused multiply-adds, which is why the library is built with -ffp-contract=off.
+
+double const epsilon = std::numeric_limits<double>::epsilon() / 2.0;
+double const splitter = 134217729.0; // 2^27 + 1
+double const resultErrorBound = (3.0 + 8.0 * epsilon) * epsilon;
+double const orientErrorBoundB = (2.0 + 12.0 * epsilon) * epsilon;
+double const orientErrorBoundC = (9.0 + 64.0 * epsilon) * epsilon * epsilon;
+
+// x + y = a + b exactly, for |a| >= |b|
+inline void fastTwoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    y = b - (x - a);
+}
+
+// x + y = a + b exactly
+inline void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    auto bVirtual = x - a;
+    auto aVirtual = x - bVirtual;
+    y = (a - aVirtual) + (b - bVirtual);
+}
+
+// Roundoff error y of x = a - b
+inline void twoDiffTail(double a, double b, double x, double& y)
+{
+    auto bVirtual = a - x;
+    auto aVirtual = x + bVirtual;
+    y = (a - aVirtual) + (bVirtual - b);
+}
+
+// x + y = a - b exactly
+inline void twoDiff(double a, double b, double& x, double& y)
+{
+    x = a - b;
+    twoDiffTail(a, b, x, y);
+}
+
+// a = high + low, where both halves have at most 26 significant bits
+inline void split(double a, double& high, double& low)
+{
+    auto c = splitter * a;
+    high = c - (c - a);
+    low = a - high;
+}
+
+// x + y = a * b exactly
+inline void twoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    double aHigh, aLow, bHigh, bLow;
+    split(a, aHigh, aLow);
+    split(b, bHigh, bLow);
+    auto error = ((x - aHigh * bHigh) - aLow * bHigh) - aHigh * bLow;
+    y = aLow * bLow - error;
+}
+
+// The four component expansion of (a1 + a0) - (b1 + b0)
+inline void twoTwoDiff(double a1, double a0, double b1, double b0, double* x)
+{
+    double i, j, k;
+    twoDiff(a0, b0, i, x[0]);
+    twoSum(a1, i, j, k);
+    twoDiff(k, b1, i, x[1]);
+    twoSum(j, i, x[3], x[2]);
+}
+
+// Sum of two expansions, leaving out zero components. Returns the length of the result.
+int expansionSum(int eLength, double const* e, int fLength, double const* f, double* h)
+{
+    int eIndex = 0, fIndex = 0, hIndex = 0;
+    auto eNext = [&] { return ++eIndex < eLength ? e[eIndex] : 0.0; };
+    auto fNext = [&] { return ++fIndex < fLength ? f[fIndex] : 0.0; };
+
+    double eNow = e[0], fNow = f[0];
+    double q, qNew, hh;
+    if ((fNow > eNow) == (fNow > -eNow))
+    {
+        q = eNow;
+        eNow = eNext();
+    }
+    else
+    {
+        q = fNow;
+        fNow = fNext();
+    }
+
+    if (eIndex < eLength && fIndex < fLength)
+    {
+        if ((fNow > eNow) == (fNow > -eNow))
+        {
+            fastTwoSum(eNow, q, qNew, hh);
+            eNow = eNext();
+        }
+        else
+        {
+            fastTwoSum(fNow, q, qNew, hh);
+            fNow = fNext();
+        }
+        q = qNew;
+        if (hh != 0.0)
+            h[hIndex++] = hh;
+
+        while (eIndex < eLength && fIndex < fLength)
+        {
+            if ((fNow > eNow) == (fNow > -eNow))
+            {
+                twoSum(q, eNow, qNew, hh);
+                eNow = eNext();
+            }
+            else
+            {
+                twoSum(q, fNow, qNew, hh);
+                fNow = fNext();
+            }
+            q = qNew;
+            if (hh != 0.0)
+                h[hIndex++] = hh;
+        }
+    }
+
+    while (eIndex < eLength)
+    {
+        twoSum(q, eNow, qNew, hh);
+        eNow = eNext();
+        q = qNew;
+        if (hh != 0.0)
+            h[hIndex++] = hh;
+    }
+
+    while (fIndex < fLength)
+    {
+        twoSum(q, fNow, qNew, hh);
+        fNow = fNext();
+        q = qNew;
+        if (hh != 0.0)
+            h[hIndex++] = hh;
+    }
+
+    if (q != 0.0 || hIndex == 0)
+        h[hIndex++] = q;
+
+    return hIndex;
+}
+
+// Expansion of (a1 + a0) * (b1 + b0) - (c1 + c0) * (d1 + d0), restricted to the given parts
+void crossTerm(double a, double b, double c, double d, double* result)
+{
+    double s1, s0, t1, t0;
+    twoProduct(a, b, s1, s0);
+    twoProduct(c, d, t1, t0);
+    twoTwoDiff(s1, s0, t1, t0, result);
+}
+
+// h = e * b, leaving out zero components. Returns the length of the result, which is at most 2 * eLength.
+int scaleExpansion(int eLength, double const* e, double b, double* h)
+{
+    int hIndex = 0;
+    double q, sum, hh, product1, product0;
+    twoProduct(e[0], b, q, hh);
+    if (hh != 0.0)
+        h[hIndex++] = hh;
+
+    for (int i = 1; i < eLength; ++i)
+    {
+        twoProduct(e[i], b, product1, product0);
+        twoSum(q, product0, sum, hh);
+        if (hh != 0.0)
+            h[hIndex++] = hh;
+        fastTwoSum(product1, sum, q, hh);
+        if (hh != 0.0)
+            h[hIndex++] = hh;
+    }
+
+    if (q != 0.0 || hIndex == 0)
+        h[hIndex++] = q;
+
+    return hIndex;
+}
+
+// Longest expansions in the exact incircle test: a lifted coordinate times a cross term, with 16 components each
+int const maxFactorLength = 16;
+int const maxProductLength = 2 * maxFactorLength * maxFactorLength;
+
+// h = e * f, for expansions of at most maxFactorLength components. Returns the length of the result.
+int multiplyExpansions(int eLength, double const* e, int fLength, double const* f, double* h)
+{
+    double scaled[2 * maxFactorLength], sum[maxProductLength];
+    auto hLength = scaleExpansion(eLength, e, f[0], h);
+    for (int i = 1; i < fLength; ++i)
+    {
+        auto scaledLength = scaleExpansion(eLength, e, f[i], scaled);
+        hLength = expansionSum(hLength, h, scaledLength, scaled, sum);
+        std::copy(sum, sum + hLength, h);
+    }
+    return hLength;
+}
+
+// Exact difference of two doubles, as an expansion of one or two components
+struct Difference
+{
+    double component[2];
+    int length;
+};
+
+Difference difference(double lhs, double rhs)
+{
+    Difference result;
+    double x, y;
+    twoDiff(lhs, rhs, x, y);
+    if (y == 0.0)
+    {
+        result.component[0] = x;
+        result.length = 1;
+    }
+    else
+    {
+        result.component[0] = y;
+        result.component[1] = x;
+        result.length = 2;
+    }
+    return result;
+}
+
+// h = a * b + sign * c * d
+int productSum(
+    Difference const& a, Difference const& b, double sign, Difference const& c, Difference const& d, double* h)
+{
+    double ab[8], cd[8];
+    auto abLength = multiplyExpansions(a.length, a.component, b.length, b.component, ab);
+    auto cdLength = multiplyExpansions(c.length, c.component, d.length, d.component, cd);
+    for (int i = 0; i < cdLength; ++i)
+        cd[i] *= sign;
+    return expansionSum(abLength, ab, cdLength, cd, h);
+}
+
+} // namespace
+
+double decomp::orient2dAdaptive(Point const& a, Point const& b, Point const& c, double detSum)
+{
+    auto acx = a[0] - c[0];
+    auto bcx = b[0] - c[0];
+    auto acy = a[1] - c[1];
+    auto bcy = b[1] - c[1];
+
+    // The determinant of the rounded differences, exactly
+    double B[4];
+    crossTerm(acx, bcy, acy, bcx, B);
+    auto det = B[0] + B[1] + B[2] + B[3];
+    auto errorBound = orientErrorBoundB * detSum;
+    if (det >= errorBound || -det >= errorBound)
+        return det;
+
+    // If the differences were exact, so is the determinant
+    double acxTail, bcxTail, acyTail, bcyTail;
+    twoDiffTail(a[0], c[0], acx, acxTail);
+    twoDiffTail(b[0], c[0], bcx, bcxTail);
+    twoDiffTail(a[1], c[1], acy, acyTail);
+    twoDiffTail(b[1], c[1], bcy, bcyTail);
+    if (acxTail == 0.0 && acyTail == 0.0 && bcxTail == 0.0 && bcyTail == 0.0)
+        return det;
+
+    // First order correction from the roundoff of the differences
+    errorBound = orientErrorBoundC * detSum + resultErrorBound * std::abs(det);
+    det += (acx * bcyTail + bcy * acxTail) - (acy * bcxTail + bcx * acyTail);
+    if (det >= errorBound || -det >= errorBound)
+        return det;
+
+    // Everything, exactly
+    double u[4], C1[8], C2[12], D[16];
+    crossTerm(acxTail, bcy, acyTail, bcx, u);
+    auto C1Length = expansionSum(4, B, 4, u, C1);
+    crossTerm(acx, bcyTail, acy, bcxTail, u);
+    auto C2Length = expansionSum(C1Length, C1, 4, u, C2);
+    crossTerm(acxTail, bcyTail, acyTail, bcxTail, u);
+    auto DLength = expansionSum(C2Length, C2, 4, u, D);
+    return D[DLength - 1];
+}
+
+bool decomp::segmentsIntersect(Point const& a, Point const& b, Point const& c, Point const& d)
+{
+    auto o1 = orient2d(a, b, c);
+    auto o2 = orient2d(a, b, d);
+    if (o1 == 0.0 && o2 == 0.0)
+        return false;
+
+    if ((o1 > 0.0 && o2 > 0.0) || (o1 < 0.0 && o2 < 0.0))
+        return false;
+
+    auto o3 = orient2d(c, d, a);
+    auto o4 = orient2d(c, d, b);
+    return !((o3 > 0.0 && o4 > 0.0) || (o3 < 0.0 && o4 < 0.0));
+}
+
+double decomp::incircleExact(Point const& a, Point const& b, Point const& c, Point const& d)
+{
+    Difference const delta[3][2] = { { difference(a[0], d[0]), difference(a[1], d[1]) },
+                                     { difference(b[0], d[0]), difference(b[1], d[1]) },
+                                     { difference(c[0], d[0]), difference(c[1], d[1]) } };
+
+    // Sum of the lifted coordinate of each point times the cross term of the other two
+    double term[3][maxProductLength];
+    int termLength[3];
+    for (int i = 0; i < 3; ++i)
+    {
+        auto const& p = delta[i];
+        auto const& q = delta[(i + 1) % 3];
+        auto const& r = delta[(i + 2) % 3];
+
+        double lift[maxFactorLength], cross[maxFactorLength];
+        auto liftLength = productSum(p[0], p[0], 1.0, p[1], p[1], lift);
+        auto crossLength = productSum(q[0], r[1], -1.0, r[0], q[1], cross);
+        termLength[i] = multiplyExpansions(liftLength, lift, crossLength, cross, term[i]);
+    }
+
+    double partial[2 * maxProductLength], det[3 * maxProductLength];
+    auto partialLength = expansionSum(termLength[0], term[0], termLength[1], term[1], partial);
+    auto detLength = expansionSum(partialLength, partial, termLength[2], term[2], det);
+    return det[detLength - 1];
+}
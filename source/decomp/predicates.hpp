@@ -0,0 +1,149 @@
+#ifndef LIB_DECOMP_PREDICATES
+#define LIB_DECOMP_PREDICATES
+
+#include "triangulation.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace decomp
+{
+
+/** Relative error bound of the floating-point orientation test in orient2d. If the absolute value of the computed
+    determinant is at least this times the sum of the absolute values of its two products, its sign is correct.
+ */
+constexpr double orientErrorBound =
+    (3.0 + 8.0 * std::numeric_limits<double>::epsilon()) * (std::numeric_limits<double>::epsilon() / 2.0);
+
+/** Exact orientation test for the cases the floating-point filter in orient2d can not decide.
+    detSum is the sum of the absolute values of the two products in the determinant.
+ */
+double orient2dAdaptive(Point const& a, Point const& b, Point const& c, double detSum);
+
+/** Orientation of the triangle abc: positive if a, b and c are in counter-clockwise order, negative if they are
+    clockwise, and zero if they are collinear. Only the sign is meaningful, and it is always exact.
+    Plain floating-point arithmetic decides almost all cases. Only nearly collinear points need extended precision,
+    which is computed adaptively, as described by Shewchuk in "Adaptive Precision Floating-Point Arithmetic
+    and Fast Robust Geometric Predicates".
+ */
+inline double orient2d(Point const& a, Point const& b, Point const& c)
+{
+    auto detLeft = (a[0] - c[0]) * (b[1] - c[1]);
+    auto detRight = (a[1] - c[1]) * (b[0] - c[0]);
+    auto det = detLeft - detRight;
+    auto detSum = std::abs(detLeft) + std::abs(detRight);
+    if (std::abs(det) >= orientErrorBound * detSum)
+        return det;
+
+    return orient2dAdaptive(a, b, c, detSum);
+}
+
+/** Same as above, for integer points within integerCoordinateLimit, where 64-bit integer arithmetic is exact.
+ */
+inline std::int64_t orient2d(IntegerPoint const& a, IntegerPoint const& b, IntegerPoint const& c)
+{
+    auto acx = std::int64_t(a[0]) - c[0];
+    auto acy = std::int64_t(a[1]) - c[1];
+    auto bcx = std::int64_t(b[0]) - c[0];
+    auto bcy = std::int64_t(b[1]) - c[1];
+    return acx * bcy - acy * bcx;
+}
+
+/** Relative error bound of the floating-point test in incircle, relative to the permanent of its determinant.
+ */
+constexpr double incircleErrorBound =
+    (10.0 + 96.0 * (std::numeric_limits<double>::epsilon() / 2.0)) * (std::numeric_limits<double>::epsilon() / 2.0);
+
+/** Exact incircle test, for the cases the floating-point filter in incircle can not decide.
+ */
+double incircleExact(Point const& a, Point const& b, Point const& c, Point const& d);
+
+/** Positive if d is inside the circle through a, b and c, which need to be in counter-clockwise order,
+    negative if it is outside, and zero if all four points are on a common circle. Like orient2d, only the sign
+    is meaningful, and it is always exact. Only nearly cocircular points need the exact computation.
+ */
+inline double incircle(Point const& a, Point const& b, Point const& c, Point const& d)
+{
+    auto adx = a[0] - d[0], ady = a[1] - d[1];
+    auto bdx = b[0] - d[0], bdy = b[1] - d[1];
+    auto cdx = c[0] - d[0], cdy = c[1] - d[1];
+
+    auto bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    auto cdxady = cdx * ady, adxcdy = adx * cdy;
+    auto adxbdy = adx * bdy, bdxady = bdx * ady;
+    auto aLift = adx * adx + ady * ady;
+    auto bLift = bdx * bdx + bdy * bdy;
+    auto cLift = cdx * cdx + cdy * cdy;
+
+    auto det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+    auto permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift + (std::abs(cdxady) + std::abs(adxcdy)) * bLift +
+                     (std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+    if (std::abs(det) > incircleErrorBound * permanent)
+        return det;
+
+    return incircleExact(a, b, c, d);
+}
+
+/** Same as above, for integer points within integerCoordinateLimit, which are exact as doubles.
+ */
+inline double incircle(IntegerPoint const& a, IntegerPoint const& b, IntegerPoint const& c, IntegerPoint const& d)
+{
+    return incircle(Point(a[0], a[1]), Point(b[0], b[1]), Point(c[0], c[1]), Point(d[0], d[1]));
+}
+
+/** Point i of the given list in the type the predicates compute with for it:
+    an IntegerPoint in the integer mode, and a Point otherwise.
+ */
+template <class Points> inline Point exactPoint(Points const& pointList, std::size_t i)
+{
+    return pointList[i];
+}
+
+inline IntegerPoint exactPoint(IntegerPointView const& pointList, std::size_t i)
+{
+    return pointList.at(i);
+}
+
+/** Key that orders the angle at center between the directions to a and b like its cosine does, as used for the
+    priorities of the ear and edge queues. For Points, this is the cosine itself.
+ */
+inline double angleKey(Point const& center, Point const& a, Point const& b)
+{
+    return dot(normalize(a - center), normalize(b - center));
+}
+
+/** Same as above, for integer points within integerCoordinateLimit. This is the squared cosine with the sign of
+    the cosine, which needs no square root. The dot products are exact, and only the last few steps are rounded,
+    by single IEEE operations, so the result is the same on all platforms.
+ */
+inline double angleKey(IntegerPoint const& center, IntegerPoint const& a, IntegerPoint const& b)
+{
+    auto ux = std::int64_t(a[0]) - center[0];
+    auto uy = std::int64_t(a[1]) - center[1];
+    auto vx = std::int64_t(b[0]) - center[0];
+    auto vy = std::int64_t(b[1]) - center[1];
+    auto cosine = static_cast<double>(ux * vx + uy * vy);
+    return cosine * std::abs(cosine) /
+           (static_cast<double>(ux * ux + uy * uy) * static_cast<double>(vx * vx + vy * vy));
+}
+
+/** angleKey of the smallest interior angle of the triangle abc, which is the largest key of its three corners.
+ */
+inline double minimumAngleKey(Point const& a, Point const& b, Point const& c)
+{
+    return minimumInteriorAngle(a, b, c);
+}
+
+inline double minimumAngleKey(IntegerPoint const& a, IntegerPoint const& b, IntegerPoint const& c)
+{
+    return std::max({ angleKey(a, b, c), angleKey(b, c, a), angleKey(c, a, b) });
+}
+
+/** Whether the segments ab and cd intersect, including their endpoints. Segments on a common line never
+    intersect, even if they overlap. Like orient2d, this is exact.
+ */
+bool segmentsIntersect(Point const& a, Point const& b, Point const& c, Point const& d);
+
+} // namespace decomp
+
+#endif
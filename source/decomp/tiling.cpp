@@ -0,0 +1,818 @@
+#include "tiling.hpp"
+#include "batch.hpp"
+#include "operations.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+using namespace decomp;
+
+namespace
+{
+
+// The sides of a tile, in counter-clockwise order
+enum Side
+{
+    Bottom,
+    Right,
+    Top,
+    Left
+};
+
+// An open rectangle, so points on a border are outside of the tiles on both sides.
+// This is the same as moving each border inward by an infinitesimal epsilon, which gets rid of all degenerate cases:
+// no point is ever exactly on a border, and edges cross borders in a well-defined order.
+struct Rect
+{
+    double x0, y0, x1, y1;
+};
+
+bool contains(Rect const& rect, Point const& p)
+{
+    return p.x() > rect.x0 && p.x() < rect.x1 && p.y() > rect.y0 && p.y() < rect.y1;
+}
+
+// Parameter along an edge where it crosses a border. The moved border adds epsilon * k to the parameter t.
+struct Crossing
+{
+    double t;
+    double k;
+    int side;
+};
+
+bool operator<(Crossing const& lhs, Crossing const& rhs)
+{
+    return std::tie(lhs.t, lhs.k) < std::tie(rhs.t, rhs.k);
+}
+
+// Liang-Barsky clipping of the edge from a to b against the moved borders.
+// Returns whether some part of the edge is inside, and where it enters and exits.
+bool clipEdge(Rect const& rect, Point const& a, Point const& b, Crossing& enter, Crossing& exit)
+{
+    enter = { 0.0, 0.0, -1 };
+    exit = { 1.0, 0.0, -1 };
+
+    auto clip = [&](double delta, double start, double lower, double upper, int lowerSide, int upperSide) {
+        if (delta == 0.0)
+            return start > lower && start < upper;
+
+        Crossing atLower{ (lower - start) / delta, 1.0 / delta, lowerSide };
+        Crossing atUpper{ (upper - start) / delta, -1.0 / delta, upperSide };
+        if (delta < 0.0)
+            std::swap(atLower, atUpper);
+
+        enter = std::max(enter, atLower);
+        exit = std::min(exit, atUpper);
+        return true;
+    };
+
+    if (!clip(b.x() - a.x(), a.x(), rect.x0, rect.x1, Left, Right))
+        return false;
+    if (!clip(b.y() - a.y(), a.y(), rect.y0, rect.y1, Bottom, Top))
+        return false;
+
+    return enter < exit;
+}
+
+// Coordinate `1 - axis` of the edge from a to b where coordinate `axis` is value.
+// Computed from the lexicographically smaller point, so both tiles at a border get the exact same result.
+double interpolate(Point a, Point b, int axis, double value)
+{
+    int const other = 1 - axis;
+    if (std::tie(b[axis], b[other]) < std::tie(a[axis], a[other]))
+        std::swap(a, b);
+
+    if (value == a[axis])
+        return a[other];
+    if (value == b[axis])
+        return b[other];
+    return a[other] + (value - a[axis]) * (b[other] - a[other]) / (b[axis] - a[axis]);
+}
+
+Point crossingPoint(Rect const& rect, Point const& a, Point const& b, int side)
+{
+    switch (side)
+    {
+    case Bottom:
+        return { std::min(std::max(interpolate(a, b, 1, rect.y0), rect.x0), rect.x1), rect.y0 };
+    case Top:
+        return { std::min(std::max(interpolate(a, b, 1, rect.y1), rect.x0), rect.x1), rect.y1 };
+    case Left:
+        return { rect.x0, std::min(std::max(interpolate(a, b, 0, rect.x0), rect.y0), rect.y1) };
+    default:
+        return { rect.x1, std::min(std::max(interpolate(a, b, 0, rect.x1), rect.y0), rect.y1) };
+    }
+}
+
+// Position on the tile border, counter-clockwise from the lower left corner.
+// Crossings at the same point are ordered by where they are on the moved border.
+struct BorderKey
+{
+    double s;
+    int side;
+    double offset;
+};
+
+bool operator<(BorderKey const& lhs, BorderKey const& rhs)
+{
+    return std::tie(lhs.s, lhs.side, lhs.offset) < std::tie(rhs.s, rhs.side, rhs.offset);
+}
+
+BorderKey borderKey(Rect const& rect, Point const& p, int side, Point const& direction)
+{
+    double const width = rect.x1 - rect.x0;
+    double const height = rect.y1 - rect.y0;
+    switch (side)
+    {
+    case Bottom:
+        return { p.x() - rect.x0, side, direction.x() / direction.y() };
+    case Right:
+        return { width + (p.y() - rect.y0), side, -direction.y() / direction.x() };
+    case Top:
+        return { width + height + (rect.x1 - p.x()), side, direction.x() / direction.y() };
+    default:
+        return { 2.0 * width + height + (rect.y1 - p.y()), side, -direction.y() / direction.x() };
+    }
+}
+
+// The corner at the end of the given side, after all crossings on that side
+Point cornerPoint(Rect const& rect, int side)
+{
+    switch (side)
+    {
+    case Bottom:
+        return { rect.x1, rect.y0 };
+    case Right:
+        return { rect.x1, rect.y1 };
+    case Top:
+        return { rect.x0, rect.y1 };
+    default:
+        return { rect.x0, rect.y0 };
+    }
+}
+
+BorderKey cornerKey(Rect const& rect, int side)
+{
+    double const width = rect.x1 - rect.x0;
+    double const height = rect.y1 - rect.y0;
+    double const s[] = { width, width + height, 2.0 * width + height, 2.0 * (width + height) };
+    return { s[side], side, std::numeric_limits<double>::infinity() };
+}
+
+struct PointHash
+{
+    std::size_t operator()(std::pair<double, double> const& p) const
+    {
+        std::uint64_t x, y;
+        std::memcpy(&x, &p.first, sizeof(x));
+        std::memcpy(&y, &p.second, sizeof(y));
+        return std::hash<std::uint64_t>()(x * 0x9e3779b97f4a7c15ull ^ y);
+    }
+};
+
+// Gives each distinct position one index, so points on the border are shared between chains
+class PointMerger
+{
+public:
+    explicit PointMerger(PointList& pointList)
+    : mPointList(pointList)
+    {
+        for (std::uint32_t i = 0; i < pointList.size(); ++i)
+            mIndexMap.emplace(key(pointList[i]), i);
+    }
+
+    std::uint32_t add(Point const& p)
+    {
+        auto inserted = mIndexMap.emplace(key(p), static_cast<std::uint32_t>(mPointList.size()));
+        if (inserted.second)
+            mPointList.push_back(p);
+        return inserted.first->second;
+    }
+
+private:
+    // Adding zero turns -0.0 into 0.0, so they are merged too
+    static std::pair<double, double> key(Point const& p)
+    {
+        return { p.x() + 0.0, p.y() + 0.0 };
+    }
+
+    PointList& mPointList;
+    std::unordered_map<std::pair<double, double>, std::uint32_t, PointHash> mIndexMap;
+};
+
+struct Piece
+{
+    IndexList32 simplePolygon;
+    std::vector<IndexList32> holeList;
+};
+
+// An edge of the input, as ring and index of its first vertex
+struct EdgeRef
+{
+    std::uint32_t ring;
+    std::uint32_t edge;
+};
+
+/** Clips the rings of a polygon with holes to one tile.
+    The parts of the rings inside the tile are collected as chains, each running from a border crossing into the tile
+    to the next crossing out of it. Walking the border counter-clockwise from each exit to the next entry links the
+    chains into the outlines of the clipped pieces.
+ */
+class TileClipper
+{
+public:
+    TileClipper(PointList const& pointList, std::vector<IndexList32 const*> const& ringList, Rect const& rect,
+                PointList& output)
+    : mPointList(pointList)
+    , mRingList(ringList)
+    , mRect(rect)
+    , mOutput(output)
+    , mMerger(output)
+    {
+    }
+
+    // Add the given edges of a ring. They need to be sorted, and include at least all edges touching the tile.
+    void addRing(std::uint32_t ring, EdgeRef const* begin, EdgeRef const* end)
+    {
+        auto const& indexList = *mRingList[ring];
+        auto const N = static_cast<std::uint32_t>(indexList.size());
+
+        mStepList.clear();
+        bool allInside = true;
+        for (auto i = begin; i != end; ++i)
+        {
+            Step step;
+            step.edge = i->edge;
+            auto const& a = mPointList[indexList[step.edge]];
+            auto const& b = mPointList[indexList[(step.edge + 1) % N]];
+            step.aInside = contains(mRect, a);
+            step.bInside = contains(mRect, b);
+            if (!(step.aInside && step.bInside) && !clipEdge(mRect, a, b, step.enter, step.exit))
+                continue;
+
+            allInside = allInside && step.aInside;
+            mStepList.push_back(step);
+        }
+
+        if (mStepList.empty())
+            return;
+
+        if (allInside)
+        {
+            if (mStepList.size() != N)
+                throw std::invalid_argument("Tile clipping needs all edges touching the tile");
+
+            IndexList32 inside;
+            for (auto index : indexList)
+                inside.push_back(mMerger.add(mPointList[index]));
+            if (ring == 0)
+                mInsideOuter = std::move(inside);
+            else
+                mInsideHoleList.push_back(std::move(inside));
+            return;
+        }
+
+        // Start outside, so every chain is complete
+        auto const M = mStepList.size();
+        std::size_t start = 0;
+        while (mStepList[start].aInside)
+            ++start;
+
+        for (std::size_t i = 0; i < M; ++i)
+        {
+            auto const& step = mStepList[(start + i) % M];
+            auto const& a = mPointList[indexList[step.edge]];
+            auto const& b = mPointList[indexList[(step.edge + 1) % N]];
+
+            if (!step.aInside)
+            {
+                mChainList.emplace_back();
+                auto p = crossingPoint(mRect, a, b, step.enter.side);
+                mChainList.back().entry = borderKey(mRect, p, step.enter.side, b - a);
+                mChainList.back().pointList.push_back(mMerger.add(p));
+            }
+
+            if (mChainList.empty())
+                throw std::invalid_argument("Tile clipping needs all edges touching the tile");
+            auto& chain = mChainList.back();
+
+            if (step.bInside)
+            {
+                chain.pointList.push_back(mMerger.add(b));
+            }
+            else
+            {
+                auto p = crossingPoint(mRect, a, b, step.exit.side);
+                chain.exit = borderKey(mRect, p, step.exit.side, b - a);
+                chain.pointList.push_back(mMerger.add(p));
+            }
+        }
+    }
+
+    // Whether finish needs to know if the tile's center is inside, because no ring crosses the border
+    bool needsCenter() const
+    {
+        return mInsideOuter.empty() && mChainList.empty();
+    }
+
+    // Link the chains into pieces. centerParity is the crossing number of a ray from the tile's center
+    // with all rings.
+    void finish(bool centerParity, std::vector<Piece>& pieceList)
+    {
+        std::vector<IndexList32> outerList;
+        if (!mInsideOuter.empty())
+        {
+            outerList.push_back(std::move(mInsideOuter));
+        }
+        else if (mChainList.empty())
+        {
+            // Holes inside the tile do not change whether the rest of it is inside
+            Point center((mRect.x0 + mRect.x1) * 0.5, (mRect.y0 + mRect.y1) * 0.5);
+            for (auto const& hole : mInsideHoleList)
+                centerParity = centerParity != containsPoint(mOutput, hole, center);
+            if (!centerParity)
+                return;
+
+            IndexList32 tile;
+            for (int side = Bottom; side <= Left; ++side)
+                tile.push_back(mMerger.add(cornerPoint(mRect, (side + 3) % 4)));
+            outerList.push_back(std::move(tile));
+        }
+        else
+        {
+            linkChains(outerList);
+        }
+
+        auto const first = pieceList.size();
+        for (auto& outer : outerList)
+        {
+            pieceList.emplace_back();
+            pieceList.back().simplePolygon = std::move(outer);
+        }
+
+        for (auto& hole : mInsideHoleList)
+        {
+            // Points not on the border are either strictly inside or outside of the pieces
+            auto test = mOutput[hole.front()];
+            for (auto index : hole)
+            {
+                auto const& p = mOutput[index];
+                if (contains(mRect, p))
+                {
+                    test = p;
+                    break;
+                }
+            }
+
+            for (auto i = first; i < pieceList.size(); ++i)
+            {
+                if (containsPoint(mOutput, pieceList[i].simplePolygon, test))
+                {
+                    pieceList[i].holeList.push_back(std::move(hole));
+                    break;
+                }
+            }
+        }
+    }
+
+private:
+    struct Step
+    {
+        std::uint32_t edge;
+        bool aInside;
+        bool bInside;
+        Crossing enter;
+        Crossing exit;
+    };
+
+    struct Chain
+    {
+        IndexList32 pointList;
+        BorderKey entry;
+        BorderKey exit;
+    };
+
+    void linkChains(std::vector<IndexList32>& outerList)
+    {
+        // Entries and exits alternate along the border, so each exit is followed by the entry of the next chain
+        struct Event
+        {
+            BorderKey key;
+            std::size_t chain;
+            bool entry;
+        };
+
+        std::vector<Event> eventList;
+        for (std::size_t i = 0; i < mChainList.size(); ++i)
+        {
+            eventList.push_back({ mChainList[i].entry, i, true });
+            eventList.push_back({ mChainList[i].exit, i, false });
+        }
+        std::stable_sort(eventList.begin(), eventList.end(),
+                         [](Event const& lhs, Event const& rhs) { return lhs.key < rhs.key; });
+
+        std::vector<std::size_t> nextChain(mChainList.size());
+        for (std::size_t i = 0; i < eventList.size(); ++i)
+        {
+            if (eventList[i].entry)
+                continue;
+
+            auto j = (i + 1) % eventList.size();
+            while (!eventList[j].entry)
+                j = (j + 1) % eventList.size();
+            nextChain[eventList[i].chain] = eventList[j].chain;
+        }
+
+        std::vector<bool> used(mChainList.size(), false);
+        for (std::size_t first = 0; first < mChainList.size(); ++first)
+        {
+            if (used[first])
+                continue;
+
+            IndexList32 outer;
+            auto current = first;
+            do
+            {
+                used[current] = true;
+                auto const& chain = mChainList[current];
+                outer.insert(outer.end(), chain.pointList.begin(), chain.pointList.end());
+
+                current = nextChain[current];
+                addCorners(chain.exit, mChainList[current].entry, outer);
+            } while (current != first);
+
+            addOutline(outer, outerList);
+        }
+    }
+
+    // Add the corners passed when walking counter-clockwise along the border
+    void addCorners(BorderKey const& from, BorderKey const& to, IndexList32& outer)
+    {
+        bool const wrap = to < from;
+        for (int side = Bottom; side <= Left; ++side)
+        {
+            auto key = cornerKey(mRect, side);
+            if (from < key && (key < to || wrap))
+                outer.push_back(mMerger.add(cornerPoint(mRect, side)));
+        }
+        if (!wrap)
+            return;
+
+        for (int side = Bottom; side <= Left; ++side)
+        {
+            auto key = cornerKey(mRect, side);
+            if (key < to && !(from < key))
+                outer.push_back(mMerger.add(cornerPoint(mRect, side)));
+        }
+    }
+
+    // Split an outline where it touches itself into simple loops. Counter-clockwise loops are pieces,
+    // clockwise loops are holes touching the border, and loops without area are dropped.
+    void addOutline(IndexList32 const& outline, std::vector<IndexList32>& outerList)
+    {
+        IndexList32 path;
+        for (auto index : outline)
+        {
+            auto found = std::find(path.begin(), path.end(), index);
+            if (found == path.end())
+            {
+                path.push_back(index);
+                continue;
+            }
+
+            addLoop(IndexList32(found, path.end()), outerList);
+            path.erase(found + 1, path.end());
+        }
+        addLoop(std::move(path), outerList);
+    }
+
+    void addLoop(IndexList32 loop, std::vector<IndexList32>& outerList)
+    {
+        if (loop.size() < 3)
+            return;
+
+        auto area = signedArea(mOutput, loop);
+        if (area > 0.0)
+            outerList.push_back(std::move(loop));
+        else if (area < 0.0)
+            mInsideHoleList.push_back(std::move(loop));
+    }
+
+    PointList const& mPointList;
+    std::vector<IndexList32 const*> const& mRingList;
+    Rect mRect;
+    PointList& mOutput;
+    PointMerger mMerger;
+    std::vector<Step> mStepList;
+    std::vector<Chain> mChainList;
+    IndexList32 mInsideOuter;
+    std::vector<IndexList32> mInsideHoleList;
+};
+
+std::vector<IndexList32 const*> makeRingList(IndexList32 const& simplePolygon, std::vector<IndexList32> const& holeList)
+{
+    std::vector<IndexList32 const*> ringList;
+    ringList.push_back(&simplePolygon);
+    for (auto const& hole : holeList)
+    {
+        if (!hole.empty())
+            ringList.push_back(&hole);
+    }
+    return ringList;
+}
+
+// Crossings of all ring edges with the horizontal line at y, sorted by x
+std::vector<double>
+lineCrossings(PointList const& pointList, std::vector<IndexList32 const*> const& ringList, double y)
+{
+    std::vector<double> result;
+    for (auto ring : ringList)
+    {
+        auto const N = ring->size();
+        for (std::size_t i = 0, j = N - 1; i < N; j = i++)
+        {
+            auto const& a = pointList[(*ring)[i]];
+            auto const& b = pointList[(*ring)[j]];
+            if ((a.y() > y) != (b.y() > y))
+                result.push_back(interpolate(a, b, 1, y));
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+// Both tiles at a border compute it with the same expression, so they agree on it exactly
+Rect tileRect(Point const& origin, double tileSize, int column, int row)
+{
+    return { origin.x() + column * tileSize, origin.y() + row * tileSize, origin.x() + (column + 1) * tileSize,
+             origin.y() + (row + 1) * tileSize };
+}
+
+// A polygon edge on a tile border, as interval along the border
+struct BorderEdge
+{
+    double from;
+    double to;
+    std::uint32_t polygon;
+    std::uint32_t side;
+};
+
+// Vertical or horizontal, and the column and row of the tile above or right of the border
+using BorderID = std::tuple<int, int, int>;
+
+bool isInside(std::vector<double> const& crossingList, double x)
+{
+    auto right = crossingList.end() - std::upper_bound(crossingList.begin(), crossingList.end(), x);
+    return right % 2 == 1;
+}
+
+} // namespace
+
+TiledDecomposition::TiledDecomposition(
+    Point const& origin, double tileSize, int columnCount, int rowCount, DecomposeOptions const& options)
+: mOrigin(origin)
+, mTileSize(tileSize)
+, mColumnCount(columnCount)
+, mRowCount(rowCount)
+, mOptions(options)
+, mTileList(static_cast<std::size_t>(std::max(columnCount, 0)) * static_cast<std::size_t>(std::max(rowCount, 0)))
+{
+    if (!(tileSize > 0.0) || columnCount <= 0 || rowCount <= 0)
+        throw std::invalid_argument("Tile grid needs a positive size");
+}
+
+void TiledDecomposition::build(PointList const& pointList,
+                               IndexList32 const& simplePolygon,
+                               std::vector<IndexList32> const& holeList,
+                               unsigned threadCount)
+{
+    auto const ringList = makeRingList(simplePolygon, holeList);
+
+    // Sort the edges into all tiles their bounding box could touch
+    auto cell = [this](double value, int axis, int count) {
+        auto i = std::floor((value - mOrigin[axis]) / mTileSize);
+        return static_cast<int>(std::min(std::max(i, -1.0), static_cast<double>(count)));
+    };
+
+    std::vector<std::vector<EdgeRef>> tileEdgeList(mTileList.size());
+    for (std::uint32_t ring = 0; ring < ringList.size(); ++ring)
+    {
+        auto const& indexList = *ringList[ring];
+        auto const N = static_cast<std::uint32_t>(indexList.size());
+        for (std::uint32_t edge = 0; edge < N; ++edge)
+        {
+            auto const& a = pointList[indexList[edge]];
+            auto const& b = pointList[indexList[(edge + 1) % N]];
+
+            // Widen by one, since rounding might put a point into the neighboring cell
+            auto column0 = std::max(cell(std::min(a.x(), b.x()), 0, mColumnCount) - 1, 0);
+            auto column1 = std::min(cell(std::max(a.x(), b.x()), 0, mColumnCount) + 1, mColumnCount - 1);
+            auto row0 = std::max(cell(std::min(a.y(), b.y()), 1, mRowCount) - 1, 0);
+            auto row1 = std::min(cell(std::max(a.y(), b.y()), 1, mRowCount) + 1, mRowCount - 1);
+            for (int row = row0; row <= row1; ++row)
+            {
+                for (int column = column0; column <= column1; ++column)
+                    tileEdgeList[row * mColumnCount + column].push_back({ ring, edge });
+            }
+        }
+    }
+
+    std::vector<DecompositionJob32> jobList;
+    std::vector<std::size_t> jobTileList;
+    for (int row = 0; row < mRowCount; ++row)
+    {
+        std::vector<double> crossingList;
+        bool haveCrossings = false;
+
+        for (int column = 0; column < mColumnCount; ++column)
+        {
+            auto const tileIndex = row * mColumnCount + column;
+            auto& tile = mTileList[tileIndex];
+            tile.pointList.clear();
+            tile.polygonList.clear();
+
+            auto const rect = tileRect(mOrigin, mTileSize, column, row);
+            TileClipper clipper(pointList, ringList, rect, tile.pointList);
+            auto const& edgeList = tileEdgeList[tileIndex];
+            for (auto begin = edgeList.begin(); begin != edgeList.end();)
+            {
+                auto end = begin;
+                while (end != edgeList.end() && end->ring == begin->ring)
+                    ++end;
+                clipper.addRing(begin->ring, &*begin, &*begin + (end - begin));
+                begin = end;
+            }
+
+            // Tiles without any crossing need to know whether they are inside. Those are decided per row.
+            bool centerParity = false;
+            if (clipper.needsCenter())
+            {
+                if (!haveCrossings)
+                {
+                    crossingList = lineCrossings(pointList, ringList, (rect.y0 + rect.y1) * 0.5);
+                    haveCrossings = true;
+                }
+                centerParity = isInside(crossingList, (rect.x0 + rect.x1) * 0.5);
+            }
+
+            std::vector<Piece> pieceList;
+            clipper.finish(centerParity, pieceList);
+            for (auto& piece : pieceList)
+            {
+                jobList.push_back(
+                    { &tile.pointList, std::move(piece.simplePolygon), std::move(piece.holeList), {}, mOptions });
+                jobTileList.push_back(tileIndex);
+            }
+        }
+    }
+
+    auto resultList = decomposeBatch(jobList, threadCount);
+    for (std::size_t i = 0; i < resultList.size(); ++i)
+    {
+        auto& polygonList = mTileList[jobTileList[i]].polygonList;
+        std::move(resultList[i].begin(), resultList[i].end(), std::back_inserter(polygonList));
+    }
+
+    stitch();
+}
+
+void TiledDecomposition::rebuildTile(int column,
+                                     int row,
+                                     PointList const& pointList,
+                                     IndexList32 const& simplePolygon,
+                                     std::vector<IndexList32> const& holeList)
+{
+    if (column < 0 || column >= mColumnCount || row < 0 || row >= mRowCount)
+        throw std::out_of_range("Tile is not in the grid");
+
+    auto const ringList = makeRingList(simplePolygon, holeList);
+    auto const rect = tileRect(mOrigin, mTileSize, column, row);
+
+    auto& tile = mTileList[row * mColumnCount + column];
+    tile.pointList.clear();
+    tile.polygonList.clear();
+
+    TileClipper clipper(pointList, ringList, rect, tile.pointList);
+    std::vector<EdgeRef> edgeList;
+    for (std::uint32_t ring = 0; ring < ringList.size(); ++ring)
+    {
+        edgeList.clear();
+        for (std::uint32_t edge = 0; edge < ringList[ring]->size(); ++edge)
+            edgeList.push_back({ ring, edge });
+        clipper.addRing(ring, edgeList.data(), edgeList.data() + edgeList.size());
+    }
+
+    bool centerParity = false;
+    if (clipper.needsCenter())
+    {
+        auto crossingList = lineCrossings(pointList, ringList, (rect.y0 + rect.y1) * 0.5);
+        centerParity = isInside(crossingList, (rect.x0 + rect.x1) * 0.5);
+    }
+
+    std::vector<Piece> pieceList;
+    clipper.finish(centerParity, pieceList);
+
+    for (auto const& piece : pieceList)
+    {
+        auto polygonList = decompose(tile.pointList, piece.simplePolygon, piece.holeList, {}, mOptions);
+        std::move(polygonList.begin(), polygonList.end(), std::back_inserter(tile.polygonList));
+    }
+
+    stitch();
+}
+
+void TiledDecomposition::stitch()
+{
+    mPointList.clear();
+    mPolygonList.clear();
+    mPolygonTileList.clear();
+    mPortalList.clear();
+
+    PointMerger merger(mPointList);
+
+    // The first list of each border has the edges of the tile below or left of it
+    std::map<BorderID, std::pair<std::vector<BorderEdge>, std::vector<BorderEdge>>> borderMap;
+    std::vector<std::uint32_t> indexMap;
+    for (int row = 0; row < mRowCount; ++row)
+    {
+        for (int column = 0; column < mColumnCount; ++column)
+        {
+            auto const tileIndex = static_cast<std::uint32_t>(row * mColumnCount + column);
+            auto const& tile = mTileList[tileIndex];
+            auto const rect = tileRect(mOrigin, mTileSize, column, row);
+
+            indexMap.resize(tile.pointList.size());
+            for (std::size_t i = 0; i < tile.pointList.size(); ++i)
+                indexMap[i] = merger.add(tile.pointList[i]);
+
+            for (auto const& polygon : tile.polygonList)
+            {
+                auto const polygonIndex = static_cast<std::uint32_t>(mPolygonList.size());
+                IndexList32 merged;
+                merged.reserve(polygon.size());
+                for (auto index : polygon)
+                    merged.push_back(indexMap[index]);
+                mPolygonList.push_back(std::move(merged));
+                mPolygonTileList.push_back(tileIndex);
+
+                auto const N = static_cast<std::uint32_t>(polygon.size());
+                for (std::uint32_t side = 0; side < N; ++side)
+                {
+                    auto const& a = tile.pointList[polygon[side]];
+                    auto const& b = tile.pointList[polygon[(side + 1) % N]];
+                    if (a == b)
+                        continue;
+
+                    BorderEdge vertical{ std::min(a.y(), b.y()), std::max(a.y(), b.y()), polygonIndex, side };
+                    BorderEdge horizontal{ std::min(a.x(), b.x()), std::max(a.x(), b.x()), polygonIndex, side };
+                    if (a.x() == rect.x0 && b.x() == rect.x0 && column > 0)
+                        borderMap[BorderID(0, column, row)].second.push_back(vertical);
+                    else if (a.x() == rect.x1 && b.x() == rect.x1 && column + 1 < mColumnCount)
+                        borderMap[BorderID(0, column + 1, row)].first.push_back(vertical);
+                    else if (a.y() == rect.y0 && b.y() == rect.y0 && row > 0)
+                        borderMap[BorderID(1, column, row)].second.push_back(horizontal);
+                    else if (a.y() == rect.y1 && b.y() == rect.y1 && row + 1 < mRowCount)
+                        borderMap[BorderID(1, column, row + 1)].first.push_back(horizontal);
+                }
+            }
+        }
+    }
+
+    // Edges on either side of a border do not need to line up, so connect all overlapping ones
+    auto byStart = [](BorderEdge const& lhs, BorderEdge const& rhs) { return lhs.from < rhs.from; };
+    for (auto& each : borderMap)
+    {
+        auto& lower = each.second.first;
+        auto& upper = each.second.second;
+        std::sort(lower.begin(), lower.end(), byStart);
+        std::sort(upper.begin(), upper.end(), byStart);
+
+        bool const vertical = std::get<0>(each.first) == 0;
+        auto const rect = tileRect(mOrigin, mTileSize, std::get<1>(each.first), std::get<2>(each.first));
+        auto onBorder = [&](double value) { return vertical ? Point(rect.x0, value) : Point(value, rect.y0); };
+
+        std::size_t i = 0;
+        std::size_t j = 0;
+        while (i < lower.size() && j < upper.size())
+        {
+            auto from = std::max(lower[i].from, upper[j].from);
+            auto to = std::min(lower[i].to, upper[j].to);
+            if (from < to)
+            {
+                mPortalList.push_back({ lower[i].polygon, lower[i].side, upper[j].polygon, upper[j].side,
+                                        onBorder(from), onBorder(to) });
+            }
+
+            if (lower[i].to < upper[j].to)
+                ++i;
+            else
+                ++j;
+        }
+    }
+}
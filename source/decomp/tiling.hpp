@@ -0,0 +1,128 @@
+#ifndef LIB_DECOMP_TILING
+#define LIB_DECOMP_TILING
+
+#include "convex_decomposition.hpp"
+
+namespace decomp
+{
+
+/** Convex decomposition of a large polygon with holes, cut into a regular grid of square tiles.
+    Each tile is decomposed on its own, so the tiles can be processed in parallel, and a single
+    tile can be rebuilt when the geometry inside it changes.
+    Tile (column, row) spans from x0 = origin.x + column * tileSize to x1 = x0 + tileSize, and likewise in y.
+    Geometry outside of the grid is dropped. Tile borders are always polygon edges, and the points
+    on them are computed the same way from both sides, so the tiles fit together exactly.
+    Indices are always 32 bits wide here, since clipping adds points.
+ */
+class TiledDecomposition
+{
+public:
+    /** Connection between two polygons in neighboring tiles, across a tile border.
+     */
+    struct Portal
+    {
+        /** Index into the polygon list, and the polygon's edge from vertex side to vertex side + 1.
+         */
+        std::uint32_t polygon;
+        std::uint32_t side;
+
+        /** The polygon on the other side of the border, and its edge.
+         */
+        std::uint32_t neighbor;
+        std::uint32_t neighborSide;
+
+        /** The part of the border shared by both edges.
+         */
+        Point from;
+        Point to;
+    };
+
+    /** All tiles are decomposed with the given options, when built as well as when rebuilt.
+     */
+    TiledDecomposition(Point const& origin,
+                       double tileSize,
+                       int columnCount,
+                       int rowCount,
+                       DecomposeOptions const& options = {});
+
+    /** Clip the given polygon with holes to all tiles, and decompose them on threadCount threads.
+        A threadCount of 0 uses one thread per hardware thread.
+        The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
+     */
+    void build(PointList const& pointList,
+               IndexList32 const& simplePolygon,
+               std::vector<IndexList32> const& holeList,
+               unsigned threadCount = 0);
+
+    /** Decompose a single tile again from changed geometry, which is given for the whole grid again.
+        All other tiles are kept as they are.
+     */
+    void rebuildTile(int column,
+                     int row,
+                     PointList const& pointList,
+                     IndexList32 const& simplePolygon,
+                     std::vector<IndexList32> const& holeList);
+
+    int columnCount() const
+    {
+        return mColumnCount;
+    }
+
+    int rowCount() const
+    {
+        return mRowCount;
+    }
+
+    /** Points of all tiles, with points on tile borders merged.
+     */
+    PointList const& pointList() const
+    {
+        return mPointList;
+    }
+
+    /** Convex polygons of all tiles, ordered by tile.
+     */
+    std::vector<IndexList32> const& polygonList() const
+    {
+        return mPolygonList;
+    }
+
+    /** The tile of each polygon, as row * columnCount + column.
+     */
+    std::vector<std::uint32_t> const& polygonTileList() const
+    {
+        return mPolygonTileList;
+    }
+
+    /** All connections across tile borders. Each one is only listed once.
+     */
+    std::vector<Portal> const& portalList() const
+    {
+        return mPortalList;
+    }
+
+private:
+    struct Tile
+    {
+        PointList pointList;
+        std::vector<IndexList32> polygonList;
+    };
+
+    void stitch();
+
+    Point mOrigin;
+    double mTileSize;
+    int mColumnCount;
+    int mRowCount;
+    DecomposeOptions mOptions;
+    std::vector<Tile> mTileList;
+
+    PointList mPointList;
+    std::vector<IndexList32> mPolygonList;
+    std::vector<std::uint32_t> mPolygonTileList;
+    std::vector<Portal> mPortalList;
+};
+
+} // namespace decomp
+
+#endif
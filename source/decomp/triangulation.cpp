@@ -1,9 +1,13 @@
 
 #include "triangulation.hpp"
+#include "indexed_heap.hpp"
+#include "kernels.hpp"
+#include "predicates.hpp"
 #include <algorithm>
 #include <cassert>
 #include <cmath>
-#include <set>
+#include <functional>
+#include <limits>
 #include <stdexcept>
 #include <ostream>
 
@@ -12,10 +16,11 @@ using namespace decomp;
 namespace
 {
 
-int findRightmostPoint(PointList const& pointList, IndexList const& polygon)
+template <class Points, class Index>
+int findRightmostPoint(Points const& pointList, BasicIndexList<Index> const& polygon)
 {
     assert(!polygon.empty());
-    auto leftOf = [&](std::uint16_t lhs, std::uint16_t rhs) { return pointList[lhs].x() < pointList[rhs].x(); };
+    auto leftOf = [&](Index lhs, Index rhs) { return pointList[lhs].x() < pointList[rhs].x(); };
     auto maxElement = std::max_element(
         polygon.begin(), polygon.end(),
         leftOf);
@@ -23,19 +28,9 @@ int findRightmostPoint(PointList const& pointList, IndexList const& polygon)
            polygon.begin());
 }
 
-inline double determinant(Point const& lhs, Point const& rhs)
-{
-    return lhs[0] * rhs[1] - lhs[1] * rhs[0];
-}
-
 bool isCounterClockwise(Point const& a, Point const& b, Point const& c)
 {
-    return determinant(b - a, c - a) > 0.0;
-}
-
-bool isClockwise(Point const& a, Point const& b, Point const& c)
-{
-    return determinant(b - a, c - a) <= 0.0;
+    return orient2d(a, b, c) > 0.0;
 }
 
 bool inCone(Point const& a, Point const& b, Point const& c, Point const& p)
@@ -46,92 +41,603 @@ bool inCone(Point const& a, Point const& b, Point const& c, Point const& p)
         return isCounterClockwise(a, b, p) || isCounterClockwise(b, c, p);
 }
 
-bool triangleContains(Point const& a, Point const& b, Point const& c, Point const& tested)
+// Candidate points or segments gathered for one call to the batch kernels
+std::size_t const blockSize = 16;
+
+struct PointBlock
 {
-    return isClockwise(a, tested, b) && isClockwise(b, tested, c) && isClockwise(c, tested, a);
-}
+    double x[blockSize];
+    double y[blockSize];
+    std::size_t size = 0;
+
+    void push(Point const& p)
+    {
+        x[size] = p[0];
+        y[size] = p[1];
+        ++size;
+    }
+};
 
-bool segmentsIntersect(Point const& a, Point const& b, Point const& c, Point const& d)
+// Visibility tests mostly stop at the first blocker, so segments are tested in smaller blocks
+std::size_t const segmentBlockSize = 4;
+
+struct SegmentBlock
 {
-    auto directionA = b - a;
-    auto directionB = c - d; // direction purposefully reversed
+    PointBlock start;
+    PointBlock end;
 
-    auto delta = c - a;
+    std::size_t size() const
+    {
+        return start.size;
+    }
 
-    auto denominator = determinant(directionA, directionB);
+    void push(Point const& a, Point const& b)
+    {
+        start.push(a);
+        end.push(b);
+    }
 
-    if (denominator == 0.0)
+    void clear()
+    {
+        start.size = end.size = 0;
+    }
+};
+
+// Uniform grid of line segments. Segments are stored in every cell they pass through,
+// so that queries along another segment only need to look at nearby segments.
+class SegmentGrid
+{
+public:
+    SegmentGrid(Point const& min, Point const& max, std::size_t segmentCount, MemoryResource& resource)
+    : mMin(min)
+    , mCells(resource)
+    , mEntries(resource)
+    , mVisited(resource)
+    {
+        auto width = std::max(max[0] - min[0], 1e-12);
+        auto height = std::max(max[1] - min[1], 1e-12);
+        auto cellCount = static_cast<double>(std::max<std::size_t>(segmentCount, 1));
+        mColumns = std::max(1, std::min(static_cast<int>(std::ceil(std::sqrt(cellCount * width / height))), 1 << 12));
+        mRows = std::max(1, std::min(static_cast<int>(std::ceil(cellCount / mColumns)), 1 << 12));
+        mCellSize[0] = width / mColumns;
+        mCellSize[1] = height / mRows;
+        mCells.assign(mColumns * mRows, none);
+        mEntries.reserve(segmentCount * 2);
+        mVisited.reserve(segmentCount);
+    }
+
+    void insert(std::uint32_t segment, Point const& a, Point const& b)
+    {
+        if (segment >= mVisited.size())
+            mVisited.resize(segment + 1, 0);
+
+        traverse(a, b, [&](int cell) {
+            mEntries.push_back({ segment, mCells[cell] });
+            mCells[cell] = static_cast<std::uint32_t>(mEntries.size() - 1);
+            return false;
+        });
+    }
+
+    // Call f once for each segment stored in a cell along the given segment until it returns true
+    template <class F> bool any(Point const& a, Point const& b, F f)
+    {
+        ++mQuery;
+        return traverse(a, b, [&](int cell) { return visitCell(cell, f); });
+    }
+
+    // Call f once for each segment stored in a cell overlapping the given box until it returns true
+    template <class F> bool anyInBox(Point const& min, Point const& max, F f)
+    {
+        ++mQuery;
+        int r0 = row(min[1]), r1 = row(max[1]);
+        for (int c = column(min[0]), c1 = column(max[0]); c <= c1; ++c)
+        {
+            for (int r = r0; r <= r1; ++r)
+            {
+                if (visitCell(r * mColumns + c, f))
+                    return true;
+            }
+        }
         return false;
+    }
 
-    auto lambda = (directionB[1] * delta[0] - directionB[0] * delta[1]) / denominator;
-    auto mu = (directionA[0] * delta[1] - directionA[1] * delta[0]) / denominator;
+    // The segment with the smallest value of hitX in the cells on the ray from the given point towards +x,
+    // or none if hitX returns infinity for all of them. The columns are visited from left to right, and only
+    // until no segment in a later one can be closer. The segment's hitX is written to nearestX.
+    template <class F> std::uint32_t nearestToTheRight(Point const& from, F hitX, double& nearestX)
+    {
+        ++mQuery;
+        auto nearest = none;
+        nearestX = std::numeric_limits<double>::infinity();
+        auto closer = [&](std::uint32_t segment) {
+            auto x = hitX(segment);
+            if (x < nearestX)
+            {
+                nearestX = x;
+                nearest = segment;
+            }
+            return false;
+        };
 
-    if (lambda < 0.0 || lambda > 1.0)
+        int r = row(from[1]);
+        for (int c = column(from[0]); c < mColumns; ++c)
+        {
+            visitCell(r * mColumns + c, closer);
+            if (nearestX <= mMin[0] + (c + 1) * mCellSize[0])
+                break;
+        }
+        return nearest;
+    }
+
+    static std::uint32_t const none = ~std::uint32_t(0);
+
+private:
+    // Call f for the segments in the given cell that were not visited in the current query yet
+    template <class F> bool visitCell(int cell, F& f)
+    {
+        for (auto entry = mCells[cell]; entry != none; entry = mEntries[entry].next)
+        {
+            auto segment = mEntries[entry].segment;
+            if (mVisited[segment] == mQuery)
+                continue;
+
+            mVisited[segment] = mQuery;
+            if (f(segment))
+                return true;
+        }
         return false;
+    }
+
+    // Visit all cells within a small margin of the segment, column by column
+    template <class F> bool traverse(Point const& a, Point const& b, F f) const
+    {
+        double const marginX = mCellSize[0] * 1e-6;
+        double const marginY = mCellSize[1] * 1e-6;
+        auto minY = std::min(a[1], b[1]);
+        auto maxY = std::max(a[1], b[1]);
+        auto dx = b[0] - a[0];
+
+        int c0 = column(std::min(a[0], b[0]) - marginX);
+        int c1 = column(std::max(a[0], b[0]) + marginX);
+        for (int c = c0; c <= c1; ++c)
+        {
+            // Vertical extent of the segment in this column
+            auto y0 = minY, y1 = maxY;
+            if (dx != 0.0 && c0 != c1)
+            {
+                auto left = std::max(std::min(a[0], b[0]), mMin[0] + c * mCellSize[0]);
+                auto right = std::min(std::max(a[0], b[0]), mMin[0] + (c + 1) * mCellSize[0]);
+                auto yLeft = a[1] + (left - a[0]) * (b[1] - a[1]) / dx;
+                auto yRight = a[1] + (right - a[0]) * (b[1] - a[1]) / dx;
+                y0 = std::max(minY, std::min(yLeft, yRight));
+                y1 = std::min(maxY, std::max(yLeft, yRight));
+            }
 
-    if (mu < 0.0 || mu > 1.0)
+            int r0 = row(y0 - marginY);
+            int r1 = row(y1 + marginY);
+            for (int r = r0; r <= r1; ++r)
+            {
+                if (f(r * mColumns + c))
+                    return true;
+            }
+        }
         return false;
+    }
 
-    return true;
-}
+    int column(double x) const
+    {
+        return std::max(0, std::min(static_cast<int>(std::floor((x - mMin[0]) / mCellSize[0])), mColumns - 1));
+    }
+
+    int row(double y) const
+    {
+        return std::max(0, std::min(static_cast<int>(std::floor((y - mMin[1]) / mCellSize[1])), mRows - 1));
+    }
+
+    struct Entry
+    {
+        std::uint32_t segment;
+        std::uint32_t next;
+    };
+
+    Point mMin;
+    double mCellSize[2];
+    int mColumns, mRows;
+    ScratchVector<std::uint32_t> mCells;
+    ScratchVector<Entry> mEntries;
+    ScratchVector<std::uint32_t> mVisited;
+    std::uint32_t mQuery = 0;
+};
+
+std::uint32_t const SegmentGrid::none;
 
-bool pointVisibleFrom(PointList const& pointList, IndexList const& indexList, int relativeIndex, Point const& from)
+// The outer polygon while holes are being merged into it, as a circular linked list
+// so that splicing in a hole only costs O(hole size). Each node also identifies the edge
+// starting at it, which is how the segment grid refers to edges.
+template <class Points> class Boundary
 {
-    int N = static_cast<int>(indexList.size());
-    auto target = pointList[indexList[relativeIndex]];
+public:
+    struct Node
+    {
+        std::uint32_t index;
+        std::uint32_t next;
+        std::uint32_t prev;
+    };
+
+    template <class Index>
+    Boundary(Points const& pointList,
+             BasicIndexList<Index> const& outer,
+             Point const& min,
+             Point const& max,
+             std::size_t edgeCount,
+             MemoryResource& resource)
+    : mPointList(pointList)
+    , mNodeList(resource)
+    , mGrid(min, max, edgeCount, resource)
+    {
+        mNodeList.reserve(edgeCount);
+        auto N = static_cast<std::uint32_t>(outer.size());
+        for (std::uint32_t i = 0; i < N; ++i)
+            mNodeList.push_back({ outer[i], (i + 1) % N, (i + N - 1) % N });
 
-    for (int i = 0; i < N; ++i)
+        for (std::uint32_t i = 0; i < N; ++i)
+            addEdge(i);
+    }
+
+    std::uint32_t head() const
     {
-        auto next = (i + 1) % N;
+        return mHead;
+    }
 
-        // Dont test edges connected to the relativ index
-        if (i == relativeIndex || next == relativeIndex)
-            continue;
+    std::size_t size() const
+    {
+        return mNodeList.size();
+    }
 
-        // Do we have an actual blocker?
-        if (segmentsIntersect(from, target, pointList[indexList[i]], pointList[indexList[next]]))
-            return false;
+    Node const& operator[](std::uint32_t node) const
+    {
+        return mNodeList[node];
     }
 
-    return true;
-}
+    Point point(std::uint32_t node) const
+    {
+        return mPointList[mNodeList[node].index];
+    }
 
-struct VertexNode;
+    SegmentGrid& grid()
+    {
+        return mGrid;
+    }
 
-struct EarLess
-{
-    bool operator()(VertexNode* lhs, VertexNode* rhs) const;
+    /** Connect the hole's vertex at rightmostPoint to the given node with a double edge.
+        Note that the clockwise ordering of the hole is correctly turned into
+        counter-clockwise here, since the polygon is semantically inverted.
+     */
+    template <class Index>
+    void splice(std::uint32_t node, BasicIndexList<Index> const& hole, std::size_t rightmostPoint)
+    {
+        auto first = static_cast<std::uint32_t>(mNodeList.size());
+        auto before = mNodeList[node].prev;
+
+        // A duplicate of the connected vertex, followed by the hole and a duplicate of its rightmost vertex.
+        // The edge into the duplicate is unchanged, all others are new.
+        mNodeList.push_back({ mNodeList[node].index, first + 1, before });
+        auto N = hole.size();
+        for (std::size_t i = 0; i <= N; ++i)
+        {
+            auto current = static_cast<std::uint32_t>(mNodeList.size());
+            mNodeList.push_back({ hole[(rightmostPoint + i) % N], current + 1, current - 1 });
+        }
+
+        auto last = static_cast<std::uint32_t>(mNodeList.size() - 1);
+        mNodeList[last].next = node;
+        mNodeList[before].next = first;
+        mNodeList[node].prev = last;
+
+        for (auto i = first; i <= last; ++i)
+            addEdge(i);
+
+        // The ring now starts at the connected vertex
+        mHead = node;
+    }
+
+    template <class Index> void indexList(BasicIndexList<Index>& result) const
+    {
+        result.clear();
+        result.reserve(mNodeList.size());
+        if (mNodeList.empty())
+            return;
+
+        auto node = mHead;
+        do
+        {
+            result.push_back(static_cast<Index>(mNodeList[node].index));
+            node = mNodeList[node].next;
+        } while (node != mHead);
+    }
+
+private:
+    void addEdge(std::uint32_t node)
+    {
+        mGrid.insert(node, point(node), point(mNodeList[node].next));
+    }
+
+    Points const& mPointList;
+    ScratchVector<Node> mNodeList;
+    std::uint32_t mHead = 0;
+    SegmentGrid mGrid;
 };
 
-// Using the order and iterator constancy of the set as
-// simple addressable priority queue
-using EarPriorityQueue = std::multiset<VertexNode*, EarLess>;
+template <class Points> bool pointVisibleFrom(Boundary<Points>& boundary, std::uint32_t node, Point const& from)
+{
+    auto const& target = boundary.point(node);
+
+    // Dont test edges connected to the node
+    auto previous = boundary[node].prev;
+
+    // Do we have an actual blocker?
+    auto const& kernels = batchKernels();
+    SegmentBlock block;
+    auto isBlocked = [&] {
+        auto count = block.size();
+        block.clear();
+        return count != 0 &&
+               kernels.firstIntersecting(from, target, block.start.x, block.start.y, block.end.x, block.end.y, count) <
+                   count;
+    };
+
+    return !boundary.grid().any(from, target, [&](std::uint32_t edge) {
+        if (edge == node || edge == previous)
+            return false;
+
+        block.push(boundary.point(edge), boundary.point(boundary[edge].next));
+        return block.size() == segmentBlockSize && isBlocked();
+    }) && !isBlocked();
+}
 
 struct VertexNode
 {
-    std::uint16_t index;
+    std::uint32_t index;
     VertexNode* next;
     VertexNode* prev;
-    bool isConvex;
-    bool isReflex;
+    bool isConvex = false;
+    bool isReflex = false;
     bool isEar = false;
-    double minimumInteriorAngle;
-    EarPriorityQueue::iterator queueNode;
+    double minimumAngleKey;
+
+    // Intrusive links into the reflex grid's cell lists
+    VertexNode* cellNext = nullptr;
+    VertexNode* cellPrev = nullptr;
+    int cell = -1;
 };
 
-inline bool EarLess::operator()(VertexNode* lhs, VertexNode* rhs) const
+// Addressable priority queue of the current ears, largest minimum interior angle first, i.e. smallest angleKey.
+// Ties are resolved in insertion order.
+class EarPriorityQueue
 {
-    return lhs->minimumInteriorAngle < rhs->minimumInteriorAngle;
-}
+public:
+    static bool const usesAngle = true;
+
+    EarPriorityQueue(ScratchVector<VertexNode>& nodeList, MemoryResource& resource)
+    : mNodeList(nodeList)
+    , mHeap(nodeList.size(), resource)
+    {
+    }
+
+    bool empty() const
+    {
+        return mHeap.empty();
+    }
+
+    void insert(VertexNode* node)
+    {
+        mHeap.push(slot(node), node->minimumAngleKey);
+    }
+
+    void erase(VertexNode* node)
+    {
+        mHeap.erase(slot(node));
+    }
+
+    VertexNode* extract()
+    {
+        return &mNodeList[mHeap.pop()];
+    }
+
+private:
+    std::uint32_t slot(VertexNode* node) const
+    {
+        return static_cast<std::uint32_t>(node - mNodeList.data());
+    }
+
+    ScratchVector<VertexNode>& mNodeList;
+    IndexedHeap<double> mHeap;
+};
 
-void updateNodeType(VertexNode* node, PointList const& pointList)
+// Queue of the current ears in the order they were found, as in classic ear clipping.
+// Erased ears stay in the buffer and are skipped once they come up, so every operation takes constant time.
+// Each vertex is queued at most once at a time, so the buffer holds at most one entry per vertex and clip.
+class EarFifoQueue
 {
-    node->isConvex =
-        isCounterClockwise(pointList[node->prev->index], pointList[node->index], pointList[node->next->index]);
-    node->isReflex = isClockwise(pointList[node->prev->index], pointList[node->index], pointList[node->next->index]);
+public:
+    static bool const usesAngle = false;
+
+    EarFifoQueue(ScratchVector<VertexNode>& nodeList, MemoryResource& resource)
+    : mNodeList(nodeList)
+    , mBuffer(resource)
+    , mQueuedList(nodeList.size(), false, resource)
+    {
+        mBuffer.reserve(nodeList.size() * 3);
+    }
+
+    bool empty()
+    {
+        // Drop the entries of vertices that stopped being ears
+        while (mHead != mBuffer.size() && !mBuffer[mHead]->isEar)
+            mQueuedList[slot(mBuffer[mHead++])] = false;
+
+        return mHead == mBuffer.size();
+    }
+
+    void insert(VertexNode* node)
+    {
+        if (mQueuedList[slot(node)])
+            return;
+
+        mQueuedList[slot(node)] = true;
+        mBuffer.push_back(node);
+    }
+
+    void erase(VertexNode*)
+    {
+    }
+
+    VertexNode* extract()
+    {
+        auto node = mBuffer[mHead++];
+        mQueuedList[slot(node)] = false;
+        return node;
+    }
+
+private:
+    std::uint32_t slot(VertexNode* node) const
+    {
+        return static_cast<std::uint32_t>(node - mNodeList.data());
+    }
+
+    ScratchVector<VertexNode>& mNodeList;
+    ScratchVector<VertexNode*> mBuffer;
+    ScratchVector<bool> mQueuedList;
+    std::size_t mHead = 0;
+};
+
+// Uniform grid of the remaining reflex vertices, so that an ear test only has to look
+// at the reflex vertices in the cells overlapped by the ear's bounding box.
+template <class Points> class ReflexGrid
+{
+public:
+    ReflexGrid(Points const& pointList, MemoryResource& resource)
+    : mPointList(pointList)
+    , mCells(resource)
+    {
+    }
+
+    void build(ScratchVector<VertexNode>& nodeList)
+    {
+        mMin = mMax = mPointList[nodeList.front().index];
+        int reflexCount = 0;
+        for (auto const& node : nodeList)
+        {
+            auto const& p = mPointList[node.index];
+            for (int i = 0; i < 2; ++i)
+            {
+                mMin[i] = std::min(mMin[i], p[i]);
+                mMax[i] = std::max(mMax[i], p[i]);
+            }
+            if (node.isReflex)
+                ++reflexCount;
+        }
+
+        // Aim for roughly one reflex vertex per cell, with cells as square as possible
+        auto width = std::max(mMax[0] - mMin[0], 1e-12);
+        auto height = std::max(mMax[1] - mMin[1], 1e-12);
+        auto cellCount = static_cast<double>(std::max(reflexCount, 1));
+        mColumns = std::max(1, std::min(static_cast<int>(std::ceil(std::sqrt(cellCount * width / height))), 1 << 12));
+        mRows = std::max(1, std::min(static_cast<int>(std::ceil(cellCount / mColumns)), 1 << 12));
+        mScale[0] = mColumns / width;
+        mScale[1] = mRows / height;
+        mCells.assign(mColumns * mRows, nullptr);
+
+        for (auto& node : nodeList)
+        {
+            if (node.isReflex)
+                insert(&node);
+        }
+    }
+
+    void insert(VertexNode* node)
+    {
+        assert(node->cell < 0);
+        auto const& p = mPointList[node->index];
+        node->cell = row(p[1]) * mColumns + column(p[0]);
+        node->cellPrev = nullptr;
+        node->cellNext = mCells[node->cell];
+        if (node->cellNext)
+            node->cellNext->cellPrev = node;
+        mCells[node->cell] = node;
+    }
+
+    void erase(VertexNode* node)
+    {
+        assert(node->cell >= 0);
+        if (node->cellPrev)
+            node->cellPrev->cellNext = node->cellNext;
+        else
+            mCells[node->cell] = node->cellNext;
+        if (node->cellNext)
+            node->cellNext->cellPrev = node->cellPrev;
+        node->cell = -1;
+    }
+
+    // Call f on all vertices in cells overlapping the given box until it returns true
+    template <class F> bool any(Point const& min, Point const& max, F f) const
+    {
+        int x0 = column(min[0]), x1 = column(max[0]);
+        int y0 = row(min[1]), y1 = row(max[1]);
+        for (int y = y0; y <= y1; ++y)
+        {
+            for (int x = x0; x <= x1; ++x)
+            {
+                for (auto node = mCells[y * mColumns + x]; node != nullptr; node = node->cellNext)
+                {
+                    if (f(node))
+                        return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    int column(double x) const
+    {
+        return std::max(0, std::min(static_cast<int>((x - mMin[0]) * mScale[0]), mColumns - 1));
+    }
+
+    int row(double y) const
+    {
+        return std::max(0, std::min(static_cast<int>((y - mMin[1]) * mScale[1]), mRows - 1));
+    }
+
+    Points const& mPointList;
+    Point mMin, mMax;
+    double mScale[2];
+    int mColumns, mRows;
+    ScratchVector<VertexNode*> mCells;
+};
+
+// Below this size, scanning the ring is faster than maintaining a grid
+int const reflexGridThreshold = 64;
+
+template <class Points> void updateNodeType(VertexNode* node, Points const& pointList, ReflexGrid<Points>* grid)
+{
+    bool wasReflex = node->isReflex;
+    auto orientation = orient2d(exactPoint(pointList, node->prev->index), exactPoint(pointList, node->index),
+                                exactPoint(pointList, node->next->index));
+    node->isConvex = orientation > 0;
+    node->isReflex = !node->isConvex;
+
+    if (grid && wasReflex != node->isReflex)
+    {
+        if (node->isReflex)
+            grid->insert(node);
+        else
+            grid->erase(node);
+    }
 }
 
-bool containsOtherVertex(VertexNode* node, PointList const& pointList)
+template <class Points>
+bool containsOtherVertex(VertexNode* node, Points const& pointList, ReflexGrid<Points> const* grid)
 {
     auto i = node->prev->index;
     auto j = node->index;
@@ -141,33 +647,56 @@ bool containsOtherVertex(VertexNode* node, PointList const& pointList)
     auto const& b(pointList[j]);
     auto const& c(pointList[k]);
 
+    // Candidates are tested in blocks
+    auto const& kernels = batchKernels();
+    PointBlock block;
+    auto isAnyInside = [&] {
+        auto count = block.size;
+        block.size = 0;
+        return count != 0 && kernels.firstInTriangle(a, b, c, block.x, block.y, count) < count;
+    };
+
+    // Own vertices can touch, but are not inside
+    auto addCandidate = [&](VertexNode* current) {
+        auto currentIndex = current->index;
+        if (currentIndex == i || currentIndex == j || currentIndex == k)
+            return false;
+
+        block.push(pointList[currentIndex]);
+        return block.size == blockSize && isAnyInside();
+    };
+
+    if (grid)
+    {
+        Point min(std::min({ a[0], b[0], c[0] }), std::min({ a[1], b[1], c[1] }));
+        Point max(std::max({ a[0], b[0], c[0] }), std::max({ a[1], b[1], c[1] }));
+        return grid->any(min, max, [&](VertexNode* current) {
+            if (current == node || current == node->prev || current == node->next)
+                return false;
+            return addCandidate(current);
+        }) || isAnyInside();
+    }
+
     for (auto current = node->next->next; current != node->prev; current = current->next)
     {
         // Only need to consider reflex vertices
         if (!current->isReflex)
             continue;
 
-        auto currentIndex = current->index;
-
-        // Own vertices can touch, but are not inside
-        if (currentIndex == i || currentIndex == j || currentIndex == k)
-            continue;
-
-        if (triangleContains(a, b, c, pointList[currentIndex]))
-        {
+        if (addCandidate(current))
             return true;
-        }
     }
 
-    return false;
+    return isAnyInside();
 }
 
-void updateEarState(VertexNode* node, PointList const& pointList, EarPriorityQueue& queue)
+template <class Points, class Queue>
+void updateEarState(VertexNode* node, Points const& pointList, Queue& queue, ReflexGrid<Points> const* grid)
 {
     // Start by erasing this node's entry in the priority queue
     // If the node is still an ear, we will reinsert it later
     if (node->isEar)
-        queue.erase(node->queueNode);
+        queue.erase(node);
 
     // A vertex is an ear iff it's convex and no vertices are inside the attached ear
     // It is sufficient to test only for reflex vertices, as any vertex in the ear implies
@@ -178,199 +707,312 @@ void updateEarState(VertexNode* node, PointList const& pointList, EarPriorityQue
         return;
     }
 
-    if (containsOtherVertex(node, pointList))
+    if (containsOtherVertex(node, pointList, grid))
     {
         node->isEar = false;
         return;
     }
 
-    auto const& a(pointList[node->prev->index]);
-    auto const& b(pointList[node->index]);
-    auto const& c(pointList[node->next->index]);
-    node->minimumInteriorAngle = minimumInteriorAngle(a, b, c);
+    if (Queue::usesAngle)
+    {
+        node->minimumAngleKey = minimumAngleKey(exactPoint(pointList, node->prev->index),
+                                                exactPoint(pointList, node->index),
+                                                exactPoint(pointList, node->next->index));
+    }
     node->isEar = true;
-    node->queueNode = queue.insert(node);
+    queue.insert(node);
 }
 
-VertexNode* findEar(EarPriorityQueue& queue)
+template <class Queue> VertexNode* findEar(Queue& queue)
 {
     if (queue.empty())
         return nullptr;
 
-    // Get top and pop
-    auto result = *queue.begin();
-    queue.erase(queue.begin());
-    return result;
+    return queue.extract();
 }
 
-VertexNode* clipEar(IndexList& resultList, VertexNode* ear, PointList const& pointList, EarPriorityQueue& queue)
+template <class Points, class Index, class Queue>
+VertexNode* clipEar(BasicIndexList<Index>& resultList,
+                    VertexNode* ear,
+                    Points const& pointList,
+                    Queue& queue,
+                    ReflexGrid<Points>* grid)
 {
-    resultList.insert(resultList.end(), { ear->prev->index, ear->index, ear->next->index });
+    resultList.insert(resultList.end(), { static_cast<Index>(ear->prev->index), static_cast<Index>(ear->index),
+                                          static_cast<Index>(ear->next->index) });
     ear->prev->next = ear->next;
     ear->next->prev = ear->prev;
-    updateNodeType(ear->prev, pointList);
-    updateNodeType(ear->next, pointList);
-    updateEarState(ear->prev, pointList, queue);
-    updateEarState(ear->next, pointList, queue);
+    updateNodeType(ear->prev, pointList, grid);
+    updateNodeType(ear->next, pointList, grid);
+    updateEarState(ear->prev, pointList, queue, grid);
+    updateEarState(ear->next, pointList, queue, grid);
     return ear->next;
 }
 
-void extractRightmostHole(PointList const& pointList,
-                          std::vector<IndexList>& holeList,
-                          IndexList& hole,
-                          int& rightmostPoint)
+// Node on the outer polygon that a hole might connect to
+struct Candidate
 {
-    // Find the rightmost hole point
-    auto rightmostHole = holeList.end();
+    double angle;
+    std::uint32_t position;
+    std::uint32_t node;
+};
 
-    for (auto i = holeList.begin(); i != holeList.end(); ++i)
-    {
-        int localRightmost = findRightmostPoint(pointList, *i);
+// Whether a node is a candidate to connect to, and if so, add it with its angle to the idealDirection
+template <class Points>
+void addCandidate(Boundary<Points> const& boundary,
+                  std::uint32_t node,
+                  std::uint32_t position,
+                  Point const& from,
+                  Point const& idealDirection,
+                  ScratchVector<Candidate>& candidateList)
+{
+    auto const& rimPoint = boundary.point(node);
 
-        if (rightmostHole == holeList.end() ||
-            pointList[(*rightmostHole)[rightmostPoint]].x() < pointList[(*i)[localRightmost]].x())
-        {
-            rightmostHole = i;
-            rightmostPoint = localRightmost;
-        }
+    // Look for points to the right side of our 'from'
+    // Simple visibility test - can give false positives, hence the more detailed test later
+    if (rimPoint.x() > from.x() &&
+        inCone(boundary.point(boundary[node].prev), rimPoint, boundary.point(boundary[node].next), from))
+    {
+        candidateList.push_back({ dot(normalize(rimPoint - from), idealDirection), position, node });
     }
-
-    hole = std::move(*rightmostHole);
-    holeList.erase(rightmostHole);
 }
 
-int findVisiblePoint(PointList const& pointList,
-                     IndexList const& indexList,
-                     Point const& from,
-                     Point const& idealDirection)
+// Try the candidates from smallest angle with the idealDirection, preferring later positions on ties
+template <class Points>
+std::uint32_t firstVisibleCandidate(Boundary<Points>& boundary,
+                                    Point const& from,
+                                    ScratchVector<Candidate>& candidateList)
 {
-    auto getPoint = [&](int i) { return pointList[indexList[i]]; };
+    std::sort(candidateList.begin(), candidateList.end(), [](Candidate const& lhs, Candidate const& rhs) {
+        return lhs.angle != rhs.angle ? lhs.angle > rhs.angle : lhs.position > rhs.position;
+    });
 
-    int bestPoint = -1;
-    int N = static_cast<int>(indexList.size());
-    for (int i = 0; i < N; ++i)
+    // Make sure the point is not occluded by other edges
+    // This is the most expensive test, hence performed last
+    for (auto const& candidate : candidateList)
     {
-        // Look for points to the right side of our 'from'
-        if (pointList[indexList[i]].x() <= from.x())
-            continue;
-
-        int const next = (i + 1) % N;
-        int const previous = (i + N - 1) % N;
-
-        auto const& rimPoint = getPoint(i);
+        if (pointVisibleFrom(boundary, candidate.node, from))
+            return candidate.node;
+    }
+    return SegmentGrid::none;
+}
 
-        // Simple visibility test - can give false positives, hence the more detailed test later
-        if (!inCone(getPoint(previous), rimPoint, getPoint(next), from))
-        {
-            continue;
-        }
+// Candidates near the first edge hit by the ray from 'from' towards +x. If the end of that edge with the
+// larger x is not visible, some reflex vertex inside the triangle of 'from', the hit and that end is,
+// so the nodes in the cells around that triangle always contain a visible one for valid input.
+template <class Points>
+std::uint32_t findLocalVisiblePoint(Boundary<Points>& boundary,
+                                    Point const& from,
+                                    Point const& idealDirection,
+                                    ScratchVector<Candidate>& candidateList)
+{
+    auto& grid = boundary.grid();
+    double hitX;
+    auto edge = grid.nearestToTheRight(
+        from,
+        [&](std::uint32_t edge) {
+            auto const& a = boundary.point(edge);
+            auto const& b = boundary.point(boundary[edge].next);
+            if (std::min(a.y(), b.y()) > from.y() || std::max(a.y(), b.y()) < from.y())
+                return std::numeric_limits<double>::infinity();
+
+            auto x = a.y() == b.y() ? std::min(a.x(), b.x())
+                                    : a.x() + (from.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+            return x > from.x() ? x : std::numeric_limits<double>::infinity();
+        },
+        hitX);
+
+    if (edge == SegmentGrid::none)
+        return SegmentGrid::none;
+
+    auto const& a = boundary.point(edge);
+    auto const& b = boundary.point(boundary[edge].next);
+    auto const& end = a.x() > b.x() ? a : b;
+    Point min(from.x(), std::min(from.y(), end.y()));
+    Point max(std::max(hitX, end.x()), std::max(from.y(), end.y()));
+
+    // Each node starts an edge, which is stored in the cell of the node
+    candidateList.clear();
+    grid.anyInBox(min, max, [&](std::uint32_t node) {
+        auto const& p = boundary.point(node);
+        if (p.x() <= max.x() && p.y() >= min.y() && p.y() <= max.y())
+            addCandidate(boundary, node, node, from, idealDirection, candidateList);
+        return false;
+    });
 
-        // Try from smallest angle with the idealDirection
-        if (bestPoint >= 0)
-        {
-            if (dot(normalize(rimPoint - from), idealDirection) <
-                dot(normalize(getPoint(bestPoint) - from), idealDirection))
-            {
-                continue;
-            }
-        }
+    return firstVisibleCandidate(boundary, from, candidateList);
+}
 
-        // Make sure the point is not occluded by other edges
-        // This is the most expensive test, hence performed last
-        if (!pointVisibleFrom(pointList, indexList, i, from))
-        {
-            continue;
-        }
+template <class Points>
+std::uint32_t findVisiblePoint(Boundary<Points>& boundary,
+                               Point const& from,
+                               Point const& idealDirection,
+                               ScratchVector<Candidate>& candidateList)
+{
+    auto local = findLocalVisiblePoint(boundary, from, idealDirection, candidateList);
+    if (local != SegmentGrid::none)
+        return local;
 
-        bestPoint = i;
-    }
+    // Degenerate input, e.g. a hole touching the boundary, can leave the ray without a usable hit.
+    // Collect all candidates together with their angle to the idealDirection and position on the ring.
+    candidateList.clear();
 
-    if (bestPoint == -1)
+    std::uint32_t position = 0;
+    auto node = boundary.head();
+    do
     {
-        throw std::runtime_error("Unable to find visible point on outer polygon");
-    }
+        addCandidate(boundary, node, position, from, idealDirection, candidateList);
+        ++position;
+        node = boundary[node].next;
+    } while (node != boundary.head());
 
-    return bestPoint;
+    auto result = firstVisibleCandidate(boundary, from, candidateList);
+    if (result != SegmentGrid::none)
+        return result;
+
+    throw std::runtime_error("Unable to find visible point on outer polygon");
 }
 
-Point bestDirectionFor(int point, PointList const& pointList, IndexList const& hole)
+template <class Points, class Index>
+Point bestDirectionFor(int point, Points const& pointList, BasicIndexList<Index> const& hole)
 {
     auto N = hole.size();
-    auto& previous = pointList[hole[(point + 1) % N]];
-    auto& current = pointList[hole[point]];
-    auto& next = pointList[hole[(point + N - 1) % N]];
+    auto const& previous = pointList[hole[(point + 1) % N]];
+    auto const& current = pointList[hole[point]];
+    auto const& next = pointList[hole[(point + N - 1) % N]];
     auto previousDirection = normalize(current - previous);
     auto nextDirection = normalize(next - current);
     auto tangent = normalize(previousDirection + nextDirection);
     return Point(tangent[1], -tangent[0]);
 }
 
-void removeHole(PointList const& pointList, IndexList& indexList, std::vector<IndexList>& holeList)
+template <class Points, class Index>
+void removeHole(Points const& pointList,
+                Boundary<Points>& boundary,
+                BasicIndexList<Index> const& hole,
+                int rightmostPoint,
+                ScratchVector<Candidate>& candidateList)
 {
-    // Find the rightmost hole point
-    int rightmostPoint = 0;
-    IndexList hole;
-    extractRightmostHole(pointList, holeList, hole, rightmostPoint);
-
     auto holePoint = pointList[hole[rightmostPoint]];
     auto bestDirection = bestDirectionFor(rightmostPoint, pointList, hole);
 
     // Find a point to connect that to
-    int bestPoint = findVisiblePoint(pointList, indexList, holePoint, bestDirection);
-
-    // Splice the hole vertex into the outer polygon by first rotating
-    // the insertion point to the end and then adding the hole vertices plus
-    // the additional two edges.
-    // Note that the clockwise ordering of the hole is correctly turned into
-    // counter-clockwise here, since the polygon is semantically inverted.
-    std::rotate(indexList.begin(), indexList.begin() + bestPoint, indexList.end());
-    indexList.push_back(indexList.front());
-    indexList.insert(indexList.end(), hole.begin() + rightmostPoint, hole.end());
-    indexList.insert(indexList.end(), hole.begin(), hole.begin() + rightmostPoint + 1);
-}
+    auto bestPoint = findVisiblePoint(boundary, holePoint, bestDirection, candidateList);
+
+    boundary.splice(bestPoint, hole, rightmostPoint);
 }
 
-double decomp::minimumInteriorAngle(Point const& a, Point const& b, Point const& c)
+template <class Points, class Index>
+void removeHolesImpl(Points const& pointList,
+                     BasicIndexList<Index> const& indexList,
+                     std::vector<BasicIndexList<Index>> const& holeList,
+                     BasicIndexList<Index>& result,
+                     MemoryResource& resource)
 {
-    auto x = normalize(b - a);
-    auto y = normalize(c - b);
-    auto z = normalize(a - c);
+    // Remove empty/degenerate holes, and find the rightmost point of the others
+    using SortedHole = std::pair<int, BasicIndexList<Index> const*>;
+    ScratchVector<SortedHole> sortedHoleList(resource);
+    sortedHoleList.reserve(holeList.size());
+    for (auto const& hole : holeList)
+    {
+        if (!hole.empty())
+            sortedHoleList.emplace_back(findRightmostPoint(pointList, hole), &hole);
+    }
 
-    auto alpha = -dot(z, x);
-    auto beta = -dot(x, y);
-    auto gamma = -dot(y, z);
+    if (sortedHoleList.empty())
+    {
+        result.assign(indexList.begin(), indexList.end());
+        return;
+    }
 
-    return std::max({ alpha, beta, gamma });
+    // Setup the grid to cover all edges that will eventually be part of the polygon
+    std::size_t edgeCount = indexList.size();
+    Point min(std::numeric_limits<double>::max()), max(-std::numeric_limits<double>::max());
+    auto extend = [&](BasicIndexList<Index> const& polygon) {
+        for (auto index : polygon)
+        {
+            for (int i = 0; i < 2; ++i)
+            {
+                min[i] = std::min(min[i], pointList[index][i]);
+                max[i] = std::max(max[i], pointList[index][i]);
+            }
+        }
+    };
+    extend(indexList);
+    for (auto const& hole : sortedHoleList)
+    {
+        extend(*hole.second);
+        edgeCount += hole.second->size() + 2;
+    }
+
+    Boundary<Points> boundary(pointList, indexList, min, max, edgeCount, resource);
+
+    // Remove actual holes, starting with the one that has the rightmost point. Ties keep the order of the hole list,
+    // which the pointers into it give without the temporary buffer of a stable sort.
+    auto rightmostX = [&](SortedHole const& hole) {
+        return pointList[(*hole.second)[hole.first]].x();
+    };
+    std::sort(sortedHoleList.begin(), sortedHoleList.end(), [&](SortedHole const& lhs, SortedHole const& rhs) {
+        auto lhsX = rightmostX(lhs), rhsX = rightmostX(rhs);
+        if (lhsX != rhsX)
+            return lhsX > rhsX;
+        return std::less<BasicIndexList<Index> const*>()(lhs.second, rhs.second);
+    });
+
+    ScratchVector<Candidate> candidateList(resource);
+    for (auto const& hole : sortedHoleList)
+        removeHole(pointList, boundary, *hole.second, hole.first, candidateList);
+
+    boundary.indexList(result);
 }
 
-IndexList decomp::removeHoles(PointList const& pointList, IndexList indexList, std::vector<IndexList> holeList)
+template <class Queue, class Points, class Index>
+void clipEars(Points const& pointList,
+              ScratchVector<VertexNode>& nodeList,
+              ReflexGrid<Points>* grid,
+              BasicIndexList<Index>& resultList,
+              MemoryResource& resource)
 {
-    // Remove empty/degenerate holes
-    holeList.erase(std::remove_if(holeList.begin(), holeList.end(), [](IndexList const& hole)
-    {
-        return hole.empty();
-    }), holeList.end());
+    Queue queue(nodeList, resource);
 
-    // Remove actual holes
-    while (!holeList.empty())
+    // Check which are ears - note that this
+    // needs reflex and convex flags set up correctly
+    for (auto& node : nodeList)
+        updateEarState(&node, pointList, queue, grid);
+
+    // Clip off ears while the polygon still has any
+    auto N = nodeList.size();
+    auto current = &nodeList.front();
+    while (N >= 3)
     {
-        removeHole(pointList, indexList, holeList);
+        current = findEar(queue);
+        if (current == nullptr)
+            throw std::invalid_argument("Polygon is not simple");
+
+        current = clipEar(resultList, current, pointList, queue, grid);
+        --N;
     }
 
-    return indexList;
+    // Only a line segment left now
+    assert(current->next->next == current);
 }
 
-IndexList decomp::earClipping(PointList const& pointList, IndexList const& indexList)
+template <class Points, class Index>
+void earClippingImpl(Points const& pointList,
+                     BasicIndexList<Index> const& indexList,
+                     BasicIndexList<Index>& resultList,
+                     MemoryResource& resource,
+                     EarOrder order)
 {
-    std::vector<VertexNode> nodeList(indexList.size());
-    IndexList resultList;
-
     int N = static_cast<int>(indexList.size());
     if (N < 3)
         throw std::invalid_argument("Polygon needs at least 3 vertices");
 
+    ScratchVector<VertexNode> nodeList(indexList.size(), VertexNode(), resource);
+
     // Simple polygons with N vertices are decomposed
     // into N-2 triangles of 3 indices each
+    resultList.clear();
     resultList.reserve((N - 2) * 3);
 
     // Setup an initial circular linked list of all vertices
@@ -389,43 +1031,42 @@ IndexList decomp::earClipping(PointList const& pointList, IndexList const& index
 
     // Figure out which nodes are initially reflex and convex
     for (auto& node : nodeList)
-        updateNodeType(&node, pointList);
+        updateNodeType<Points>(&node, pointList, nullptr);
 
-    EarPriorityQueue queue;
-
-    // Check which are ears - note that this
-    // needs reflex and convex flags set up correctly
-    for (auto& node : nodeList)
-        updateEarState(&node, pointList, queue);
-
-    // Clip off ears while the polygon still has any
-    auto current = &nodeList.front();
-    while (N >= 3)
+    // Large polygons keep their reflex vertices in a grid to speed up the ear tests
+    ReflexGrid<Points> reflexGrid(pointList, resource);
+    ReflexGrid<Points>* grid = nullptr;
+    if (N >= reflexGridThreshold)
     {
-        current = findEar(queue);
-        if (current == nullptr)
-            throw std::invalid_argument("Polygon is not simple");
-
-        current = clipEar(resultList, current, pointList, queue);
-        --N;
+        reflexGrid.build(nodeList);
+        grid = &reflexGrid;
     }
 
-    // Only a line segment left now
-    assert(current->next->next == current);
-
-    return resultList;
+    if (order == EarOrder::Fifo)
+        clipEars<EarFifoQueue>(pointList, nodeList, grid, resultList, resource);
+    else
+        clipEars<EarPriorityQueue>(pointList, nodeList, grid, resultList, resource);
 }
 
-decomp::Winding decomp::computeWinding(PointList const& pointList, IndexList const& polygon)
+template <class Points, class Index>
+Winding computeWindingImpl(Points const& pointList, BasicIndexList<Index> const& polygon)
 {
-    // Compute the signed area using the shoelace algorithm
-    auto N = static_cast<int>(polygon.size());
+    // Compute the signed area using the shoelace algorithm, on blocks of the ring that overlap by one point
+    auto const& kernels = batchKernels();
+    auto const N = polygon.size();
     double signedArea = 0.0;
+    PointBlock block;
 
-    for (int i = 0; i < N; ++i)
+    for (std::size_t first = 0; first < N; first += blockSize - 1)
     {
-        int j = (i + 1) % N;
-        signedArea += determinant(pointList[polygon[i]], pointList[polygon[j]]);
+        block.size = 0;
+        for (auto i = first; i < N && block.size < blockSize; ++i)
+            block.push(pointList[polygon[i]]);
+
+        if (block.size < blockSize)
+            block.push(pointList[polygon[0]]);
+
+        signedArea += kernels.shoelaceSum(block.x, block.y, block.size);
     }
 
     if (signedArea < 0.0)
@@ -433,7 +1074,144 @@ decomp::Winding decomp::computeWinding(PointList const& pointList, IndexList con
     else // (signedArea>0.0)
         return Winding::CounterClockwise;
 }
+}
+
+double decomp::minimumInteriorAngle(Point const& a, Point const& b, Point const& c)
+{
+    auto x = normalize(b - a);
+    auto y = normalize(c - b);
+    auto z = normalize(a - c);
+
+    auto alpha = -dot(z, x);
+    auto beta = -dot(x, y);
+    auto gamma = -dot(y, z);
+
+    return std::max({ alpha, beta, gamma });
+}
+
+template <class Index>
+BasicIndexList<Index> decomp::removeHoles(PointList const& pointList,
+                                          BasicIndexList<Index> indexList,
+                                          std::vector<BasicIndexList<Index>> holeList)
+{
+    auto isEmpty = [](BasicIndexList<Index> const& hole) { return hole.empty(); };
+    if (std::all_of(holeList.begin(), holeList.end(), isEmpty))
+        return indexList;
+
+    BasicIndexList<Index> result;
+    removeHoles(pointList, indexList, holeList, result, newDeleteResource());
+    return result;
+}
+
+template <class Points, class Index>
+void decomp::removeHoles(Points const& pointList,
+                         BasicIndexList<Index> const& indexList,
+                         std::vector<BasicIndexList<Index>> const& holeList,
+                         BasicIndexList<Index>& result,
+                         MemoryResource& resource)
+{
+    removeHolesImpl(pointList, indexList, holeList, result, resource);
+}
+
+template <class Index>
+BasicIndexList<Index> decomp::earClipping(PointList const& pointList, BasicIndexList<Index> const& indexList)
+{
+    BasicIndexList<Index> resultList;
+    earClipping(pointList, indexList, resultList, newDeleteResource());
+    return resultList;
+}
+
+template <class Points, class Index>
+void decomp::earClipping(Points const& pointList,
+                         BasicIndexList<Index> const& indexList,
+                         BasicIndexList<Index>& resultList,
+                         MemoryResource& resource,
+                         EarOrder order)
+{
+    earClippingImpl(pointList, indexList, resultList, resource, order);
+}
+
+template <class Points, class Index>
+decomp::Winding decomp::computeWinding(Points const& pointList, BasicIndexList<Index> const& polygon)
+{
+    return computeWindingImpl(pointList, polygon);
+}
+
+decomp::IntegerPointView::IntegerPointView(std::int32_t const* x,
+                                           std::int32_t const* y,
+                                           std::size_t size,
+                                           std::size_t stride)
+: mView(x, y, size, stride)
+{
+    checkRange();
+}
+
+decomp::IntegerPointView::IntegerPointView(BasicPointList<std::int32_t> const& pointList)
+: mView(pointList)
+{
+    checkRange();
+}
+
+void decomp::IntegerPointView::checkRange() const
+{
+    auto inRange = [](std::int32_t value) {
+        return -integerCoordinateLimit <= value && value <= integerCoordinateLimit;
+    };
+    for (std::size_t i = 0; i < mView.size(); ++i)
+    {
+        auto p = mView.at(i);
+        if (!inRange(p.x()) || !inRange(p.y()))
+            throw std::invalid_argument("Integer coordinates are out of range");
+    }
+}
 
 std::ostream& decomp::operator<<(std::ostream &out, Point const &p) {
     return out << '{' << p[0] << ',' << p[1] << '}';
 }
+
+template IndexList decomp::removeHoles(PointList const&, IndexList, std::vector<IndexList>);
+template IndexList32 decomp::removeHoles(PointList const&, IndexList32, std::vector<IndexList32>);
+template void
+decomp::removeHoles(PointList const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::removeHoles(
+    PointList const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template IndexList decomp::earClipping(PointList const&, IndexList const&);
+template IndexList32 decomp::earClipping(PointList const&, IndexList32 const&);
+template void decomp::earClipping(PointList const&, IndexList const&, IndexList&, MemoryResource&, EarOrder);
+template void decomp::earClipping(PointList const&, IndexList32 const&, IndexList32&, MemoryResource&, EarOrder);
+template decomp::Winding decomp::computeWinding(PointList const&, IndexList const&);
+template decomp::Winding decomp::computeWinding(PointList const&, IndexList32 const&);
+
+template void decomp::removeHoles(
+    FloatPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::removeHoles(
+    FloatPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::removeHoles(
+    PointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::removeHoles(
+    PointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::removeHoles(
+    FixedPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::removeHoles(
+    FixedPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::earClipping(FloatPointView const&, IndexList const&, IndexList&, MemoryResource&, EarOrder);
+template void decomp::earClipping(FloatPointView const&, IndexList32 const&, IndexList32&, MemoryResource&, EarOrder);
+template void decomp::earClipping(PointView const&, IndexList const&, IndexList&, MemoryResource&, EarOrder);
+template void decomp::earClipping(PointView const&, IndexList32 const&, IndexList32&, MemoryResource&, EarOrder);
+template void decomp::earClipping(FixedPointView const&, IndexList const&, IndexList&, MemoryResource&, EarOrder);
+template void decomp::earClipping(FixedPointView const&, IndexList32 const&, IndexList32&, MemoryResource&, EarOrder);
+template decomp::Winding decomp::computeWinding(FloatPointView const&, IndexList const&);
+template decomp::Winding decomp::computeWinding(FloatPointView const&, IndexList32 const&);
+template decomp::Winding decomp::computeWinding(PointView const&, IndexList const&);
+template decomp::Winding decomp::computeWinding(PointView const&, IndexList32 const&);
+template decomp::Winding decomp::computeWinding(FixedPointView const&, IndexList const&);
+template decomp::Winding decomp::computeWinding(FixedPointView const&, IndexList32 const&);
+
+template void decomp::removeHoles(
+    IntegerPointView const&, IndexList const&, std::vector<IndexList> const&, IndexList&, MemoryResource&);
+template void decomp::removeHoles(
+    IntegerPointView const&, IndexList32 const&, std::vector<IndexList32> const&, IndexList32&, MemoryResource&);
+template void decomp::earClipping(IntegerPointView const&, IndexList const&, IndexList&, MemoryResource&, EarOrder);
+template void decomp::earClipping(IntegerPointView const&, IndexList32 const&, IndexList32&, MemoryResource&, EarOrder);
+template decomp::Winding decomp::computeWinding(IntegerPointView const&, IndexList const&);
+template decomp::Winding decomp::computeWinding(IntegerPointView const&, IndexList32 const&);
@@ -1,40 +1,45 @@
 #ifndef LIB_DECOMP_TRIANGULATION
 #define LIB_DECOMP_TRIANGULATION
 
+#include "memory_resource.hpp"
 #include <cmath>
 #include <cstdint>
 #include <vector>
 #include <iosfwd>
+#include <utility>
 
 namespace decomp
 {
 
-class Point
+/** 2D point with coordinates of type T. The algorithms compute in double precision, so other coordinate types
+    are only used for storage, see BasicPointView.
+ */
+template <class T> class BasicPoint
 {
 public:
-    explicit Point(double v = 0.0)
+    explicit BasicPoint(T v = T())
     {
         data[0] = v;
         data[1] = v;
     }
 
-    Point(double x, double y)
+    BasicPoint(T x, T y)
     {
         data[0] = x;
         data[1] = y;
     }
 
-    double& operator[](int i)
+    T& operator[](int i)
     {
         return data[i];
     }
 
-    double operator[](int i) const
+    T operator[](int i) const
     {
         return data[i];
     }
 
-    Point& operator+=(Point const& rhs)
+    BasicPoint& operator+=(BasicPoint const& rhs)
     {
         for (int i = 0; i < 2; ++i)
             data[i] += rhs.data[i];
@@ -42,7 +47,7 @@ public:
         return *this;
     }
 
-    Point& operator-=(Point const& rhs)
+    BasicPoint& operator-=(BasicPoint const& rhs)
     {
         for (int i = 0; i < 2; ++i)
             data[i] -= rhs.data[i];
@@ -50,28 +55,30 @@ public:
         return *this;
     }
 
-    double x() const
+    T x() const
     {
         return data[0];
     }
-    double y() const
+    T y() const
     {
         return data[1];
     }
 
 private:
-    double data[2];
+    T data[2];
 };
 
-inline Point operator+(Point const& lhs, Point const& rhs)
+using Point = BasicPoint<double>;
+
+template <class T> inline BasicPoint<T> operator+(BasicPoint<T> const& lhs, BasicPoint<T> const& rhs)
 {
-    Point result(lhs);
+    BasicPoint<T> result(lhs);
     return result += rhs;
 }
 
-inline Point operator-(Point const& lhs, Point const& rhs)
+template <class T> inline BasicPoint<T> operator-(BasicPoint<T> const& lhs, BasicPoint<T> const& rhs)
 {
-    Point result(lhs);
+    BasicPoint<T> result(lhs);
     return result -= rhs;
 }
 
@@ -91,15 +98,126 @@ inline double dot(Point const& lhs, Point const& rhs)
     return lhs[0] * rhs[0] + lhs[1] * rhs[1];
 }
 
-inline bool operator==(Point const& lhs, Point const& rhs)
+template <class T> inline bool operator==(BasicPoint<T> const& lhs, BasicPoint<T> const& rhs)
 {
     return lhs[0] == rhs[0] && lhs[1] == rhs[1];
 }
 
 std::ostream& operator<<(std::ostream& out, Point const& p);
 
-using PointList = std::vector<Point>;
-using IndexList = std::vector<std::uint16_t>;
+template <class T> using BasicPointList = std::vector<BasicPoint<T>>;
+using PointList = BasicPointList<double>;
+
+/** Read-only view of points stored as float, double or 32-bit fixed-point coordinates, either in separate
+    x and y arrays (structure of arrays) or interleaved in a BasicPointList. Points are converted to Point
+    when read, which is exact for all three types, so the result of an algorithm on a view is the same
+    as on a PointList with the converted points. The scale of fixed-point coordinates does not matter,
+    so they can be passed in as is.
+    Views do not own their points, which need to outlive them.
+ */
+template <class T> class BasicPointView
+{
+public:
+    /** View size points, where the coordinates of point i are x[i * stride] and y[i * stride].
+     */
+    BasicPointView(T const* x, T const* y, std::size_t size, std::size_t stride = 1)
+    : mX(x)
+    , mY(y)
+    , mSize(size)
+    , mStride(stride)
+    {
+    }
+
+    BasicPointView(BasicPointList<T> const& pointList)
+    : mX(reinterpret_cast<T const*>(pointList.data()))
+    , mY(mX + 1)
+    , mSize(pointList.size())
+    , mStride(sizeof(BasicPoint<T>) / sizeof(T))
+    {
+        static_assert(sizeof(BasicPoint<T>) == 2 * sizeof(T), "Points need to be tightly packed");
+    }
+
+    std::size_t size() const
+    {
+        return mSize;
+    }
+
+    Point operator[](std::size_t i) const
+    {
+        return { static_cast<double>(mX[i * mStride]), static_cast<double>(mY[i * mStride]) };
+    }
+
+    /** Point i with its coordinates as stored, without converting them.
+     */
+    BasicPoint<T> at(std::size_t i) const
+    {
+        return { mX[i * mStride], mY[i * mStride] };
+    }
+
+private:
+    T const* mX;
+    T const* mY;
+    std::size_t mSize;
+    std::size_t mStride;
+};
+
+using FloatPointView = BasicPointView<float>;
+using PointView = BasicPointView<double>;
+using FixedPointView = BasicPointView<std::int32_t>;
+
+using IntegerPoint = BasicPoint<std::int32_t>;
+
+/** Largest absolute value of a coordinate in an IntegerPointView. Differences of such coordinates have at most
+    31 bits, so all determinants and dot products of them are exact in 64-bit integers.
+ */
+std::int32_t const integerCoordinateLimit = (1 << 30) - 1;
+
+/** View of points on an integer grid, which selects the integer mode of the pipeline.
+    Unlike with a FixedPointView, the orientation tests are then computed with exact 64-bit integer arithmetic,
+    and the angle priorities of the ear and edge queues without square roots. The result is only determined
+    by the input, and is the same on all platforms.
+    All coordinates need to be within integerCoordinateLimit, otherwise the constructors throw
+    std::invalid_argument. Like other views, this does not own its points.
+ */
+class IntegerPointView
+{
+public:
+    IntegerPointView(std::int32_t const* x, std::int32_t const* y, std::size_t size, std::size_t stride = 1);
+
+    IntegerPointView(BasicPointList<std::int32_t> const& pointList);
+
+    std::size_t size() const
+    {
+        return mView.size();
+    }
+
+    Point operator[](std::size_t i) const
+    {
+        return mView[i];
+    }
+
+    IntegerPoint at(std::size_t i) const
+    {
+        return mView.at(i);
+    }
+
+private:
+    void checkRange() const;
+
+    FixedPointView mView;
+};
+
+/** Polygons and triangles are lists of indices into a point list.
+    All functions taking index lists are templates on the index type, and are instantiated
+    for 16-bit and 32-bit indices. Non-template overloads for 16-bit indices are provided,
+    so calls with braced initializer lists keep working.
+    Functions that are also templates on the type of their Points accept a PointList, a FloatPointView,
+    PointView or FixedPointView, or an IntegerPointView, which selects the integer mode, and are instantiated
+    for each of them. Other point lists need to be wrapped in one of these views first.
+ */
+template <class Index> using BasicIndexList = std::vector<Index>;
+using IndexList = BasicIndexList<std::uint16_t>;
+using IndexList32 = BasicIndexList<std::uint32_t>;
 
 enum class Winding
 {
@@ -111,15 +229,69 @@ enum class Winding
     adding a double edge from each hole connecting it to the outer polygon.
     The outer polygon's vertex order needs to be counter-clockwise, while all holes need to be clockwise.
 */
-IndexList removeHoles(PointList const& pointList, IndexList indexList, std::vector<IndexList> holeList);
+template <class Index>
+BasicIndexList<Index>
+removeHoles(PointList const& pointList, BasicIndexList<Index> indexList, std::vector<BasicIndexList<Index>> holeList);
+
+inline IndexList removeHoles(PointList const& pointList, IndexList indexList, std::vector<IndexList> holeList)
+{
+    return removeHoles<std::uint16_t>(pointList, std::move(indexList), std::move(holeList));
+}
+
+/** Same as above, but write into the given result to reuse its memory, and take all
+    temporary storage from the given resource.
+ */
+template <class Points, class Index>
+void removeHoles(Points const& pointList,
+                 BasicIndexList<Index> const& indexList,
+                 std::vector<BasicIndexList<Index>> const& holeList,
+                 BasicIndexList<Index>& result,
+                 MemoryResource& resource);
+
+/** Order in which earClipping clips the ears of a polygon.
+ */
+enum class EarOrder
+{
+    /** Always clip the ear with the largest minimum interior angle next, which avoids slivers. Keeping the ears
+        in a priority queue adds O(log n) to every clip.
+     */
+    LargestAngle,
+
+    /** Clip the ears in the order they were found, like classic ear clipping. Each queue operation takes constant
+        time, but the triangles tend to fan out from a few vertices.
+     */
+    Fifo
+};
 
 /** Triangulate a simple polygon using ear-clipping.
  */
-IndexList earClipping(PointList const& pointList, IndexList const& polygon);
+template <class Index>
+BasicIndexList<Index> earClipping(PointList const& pointList, BasicIndexList<Index> const& polygon);
+
+inline IndexList earClipping(PointList const& pointList, IndexList const& polygon)
+{
+    return earClipping<std::uint16_t>(pointList, polygon);
+}
+
+/** Same as above, but write into the given result to reuse its memory, and take all
+    temporary storage from the given resource. The ears are clipped in the given order.
+ */
+template <class Points, class Index>
+void earClipping(Points const& pointList,
+                 BasicIndexList<Index> const& polygon,
+                 BasicIndexList<Index>& result,
+                 MemoryResource& resource,
+                 EarOrder order = EarOrder::LargestAngle);
 
 /** Figure out the winding of a simple polygon.
  */
-Winding computeWinding(PointList const& pointList, IndexList const& polygon);
+template <class Points, class Index>
+Winding computeWinding(Points const& pointList, BasicIndexList<Index> const& polygon);
+
+inline Winding computeWinding(PointList const& pointList, IndexList const& polygon)
+{
+    return computeWinding<PointList, std::uint16_t>(pointList, polygon);
+}
 
 /** Compute the cosine of the minimum interior angle in a triangle.
  */
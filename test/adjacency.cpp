@@ -0,0 +1,113 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+
+using namespace decomp;
+
+namespace
+{
+
+// Check that the adjacency matches the polygons, that neighbors point back at each other across the same edge,
+// and that exactly the edges of the rings are left without a neighbor
+void checkAdjacency(std::vector<IndexList> const& polygonList,
+                    PolygonAdjacency const& adjacency,
+                    std::size_t boundarySideCount)
+{
+    REQUIRE(adjacency.polygonCount() == polygonList.size());
+    REQUIRE(adjacency.offsetList.front() == 0);
+
+    std::size_t boundaryCount = 0;
+    for (std::size_t polygon = 0; polygon < polygonList.size(); ++polygon)
+    {
+        auto const& vertexList = polygonList[polygon];
+        auto const N = vertexList.size();
+        REQUIRE(adjacency.offsetList[polygon + 1] - adjacency.offsetList[polygon] == N);
+
+        for (std::size_t side = 0; side < N; ++side)
+        {
+            auto neighbor = adjacency.neighbor(polygon, side);
+            auto neighborSide = adjacency.neighborSide(polygon, side);
+            if (neighbor == PolygonAdjacency::none)
+            {
+                REQUIRE(neighborSide == PolygonAdjacency::none);
+                ++boundaryCount;
+                continue;
+            }
+
+            REQUIRE(neighbor != polygon);
+            REQUIRE(adjacency.neighbor(neighbor, neighborSide) == polygon);
+            REQUIRE(adjacency.neighborSide(neighbor, neighborSide) == side);
+
+            auto const& other = polygonList[neighbor];
+            REQUIRE(other[neighborSide] == vertexList[(side + 1) % N]);
+            REQUIRE(other[(neighborSide + 1) % other.size()] == vertexList[side]);
+        }
+    }
+    REQUIRE(boundaryCount == boundarySideCount);
+}
+
+} // namespace
+
+TEST_CASE("adjacency of two triangles with a fixed edge")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    IndexList triangleList = { 0, 1, 2, 0, 2, 3 };
+    auto mesh = buildHalfEdgeGraph(triangleList, { { 0, 2 } });
+
+    std::vector<IndexList> result;
+    PolygonAdjacency adjacency;
+    hertelMehlhorn(pointList, mesh, result, adjacency, newDeleteResource());
+    REQUIRE(result == std::vector<IndexList>{ { 0, 1, 2 }, { 0, 2, 3 } });
+    REQUIRE(adjacency.offsetList == std::vector<std::uint32_t>{ 0, 3, 6 });
+    REQUIRE(adjacency.neighborList ==
+            std::vector<std::uint32_t>{ PolygonAdjacency::none, PolygonAdjacency::none, 1, 0, PolygonAdjacency::none,
+                                        PolygonAdjacency::none });
+    REQUIRE(adjacency.neighbor(1, 0) == 0);
+    REQUIRE(adjacency.neighborSide(1, 0) == 2);
+}
+
+TEST_CASE("adjacency of a decomposition with holes")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    // Hole bridges are inner edges, so only the rings are on the boundary
+    auto boundarySideCount = outer.size();
+    for (auto const& hole : holeList)
+        boundarySideCount += hole.size();
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+
+    IntegerPointView view(pointList);
+    Decomposer decomposer;
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone })
+    {
+        for (auto tier : { Tier::Fast, Tier::Quality })
+        {
+            DecomposeOptions options;
+            options.triangulator = triangulator;
+            options.tier = tier;
+
+            PolygonAdjacency adjacency;
+            auto result = decompose(view, outer, holeList, {}, adjacency, options);
+            REQUIRE(result == decompose(view, outer, holeList, {}, options));
+            checkAdjacency(result, adjacency, boundarySideCount);
+
+            std::vector<IndexList> decomposerResult;
+            PolygonAdjacency decomposerAdjacency;
+            decomposer.decompose(view, outer, holeList, {}, decomposerResult, decomposerAdjacency, options);
+            REQUIRE(decomposerResult == result);
+            REQUIRE(decomposerAdjacency.neighborList == adjacency.neighborList);
+            REQUIRE(decomposerAdjacency.neighborSideList == adjacency.neighborSideList);
+
+            PolygonAdjacency convertedAdjacency;
+            REQUIRE(decompose(converted, outer, holeList, {}, convertedAdjacency, options) == result);
+            REQUIRE(convertedAdjacency.offsetList == adjacency.offsetList);
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <decomp/batch.hpp>
+#include <stdexcept>
+
+using namespace decomp;
+
+namespace
+{
+
+// Stars of different sizes, so the jobs have very different costs
+std::vector<DecompositionJob> makeJobList(PointList& pointList)
+{
+    std::vector<DecompositionJob> jobList;
+    for (int job = 0; job < 24; ++job)
+    {
+        int const N = 8 + ((job * 7) % 11) * 40;
+        double const cx = 300.0 * job;
+
+        IndexList outer;
+        for (int i = 0; i < N; ++i)
+        {
+            double angle = 2.0 * 3.14159265358979323846 * i / N;
+            double radius = (i % 2 == 0) ? 100.0 : 60.0 + job;
+            outer.push_back(static_cast<std::uint16_t>(pointList.size()));
+            pointList.emplace_back(cx + radius * std::cos(angle), radius * std::sin(angle));
+        }
+
+        IndexList hole;
+        for (auto const& corner : { Point(cx - 5, 5), Point(cx + 5, 5), Point(cx + 5, -5), Point(cx - 5, -5) })
+        {
+            hole.push_back(static_cast<std::uint16_t>(pointList.size()));
+            pointList.push_back(corner);
+        }
+
+        jobList.push_back({ &pointList, outer, { hole }, {}, DecomposeOptions{} });
+    }
+    return jobList;
+}
+
+} // namespace
+
+TEST_CASE("batch decomposition matches sequential decomposition")
+{
+    PointList pointList;
+    auto jobList = makeJobList(pointList);
+
+    std::vector<std::vector<IndexList>> expected;
+    for (auto const& job : jobList)
+        expected.push_back(decompose(*job.pointList, job.simplePolygon, job.holeList, job.fixedEdges));
+
+    REQUIRE(decomposeBatch(jobList, 1) == expected);
+    REQUIRE(decomposeBatch(jobList, 4) == expected);
+    REQUIRE(decomposeBatch(jobList) == expected);
+    REQUIRE(decomposeBatch(std::vector<DecompositionJob>{}, 4).empty());
+}
+
+TEST_CASE("batch decomposition uses the options of each job")
+{
+    PointList pointList;
+    auto jobList = makeJobList(pointList);
+    for (std::size_t i = 0; i < jobList.size(); ++i)
+    {
+        jobList[i].options.triangulator = static_cast<Triangulator>(i % 3);
+        jobList[i].options.tier = static_cast<Tier>((i / 3) % 3);
+    }
+
+    std::vector<std::vector<IndexList>> expected;
+    for (auto const& job : jobList)
+        expected.push_back(decompose(*job.pointList, job.simplePolygon, job.holeList, job.fixedEdges, job.options));
+
+    REQUIRE(decomposeBatch(jobList, 4) == expected);
+}
+
+TEST_CASE("batch decomposition reports failing jobs")
+{
+    PointList pointList;
+    auto jobList = makeJobList(pointList);
+
+    // A polygon with less than three vertices can not be decomposed
+    jobList[5].simplePolygon.resize(2);
+    jobList[5].holeList.clear();
+
+    REQUIRE_THROWS_AS(decomposeBatch(jobList, 4), std::invalid_argument);
+}
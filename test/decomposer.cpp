@@ -0,0 +1,216 @@
+#include <atomic>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <cstdlib>
+#include <decomp/decomposer.hpp>
+#include <new>
+
+using namespace decomp;
+
+// Counts all allocations from the global heap, including those that bypass the memory resources,
+// like the temporary buffers of the standard algorithms
+static std::atomic<std::size_t> globalAllocationCount(0);
+
+void* operator new(std::size_t bytes)
+{
+    ++globalAllocationCount;
+    if (auto pointer = std::malloc(bytes ? bytes : 1))
+        return pointer;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t bytes, std::nothrow_t const&) noexcept
+{
+    ++globalAllocationCount;
+    return std::malloc(bytes ? bytes : 1);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::nothrow_t const&) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+
+// Counts the allocations passed on to the global heap
+class CountingResource : public MemoryResource
+{
+public:
+    std::size_t allocationCount = 0;
+    std::size_t liveCount = 0;
+
+protected:
+    void* doAllocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocationCount;
+        ++liveCount;
+        return newDeleteResource().allocate(bytes, alignment);
+    }
+
+    void doDeallocate(void* pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        --liveCount;
+        newDeleteResource().deallocate(pointer, bytes, alignment);
+    }
+};
+
+// Star with a few square holes, large enough to use the acceleration grids
+void makeStarWithHoles(PointList& pointList, IndexList& outer, std::vector<IndexList>& holeList)
+{
+    int const N = 200;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 2.0 * 3.14159265358979323846 * i / N;
+        double radius = (i % 2 == 0) ? 100.0 : 70.0;
+        outer.push_back(static_cast<std::uint16_t>(pointList.size()));
+        pointList.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        double x = -30.0 + 20.0 * i;
+        IndexList hole;
+        for (auto const& corner : { Point(x, 5.0), Point(x + 5.0, 5.0), Point(x + 5.0, 0.0), Point(x, 0.0) })
+        {
+            hole.push_back(static_cast<std::uint16_t>(pointList.size()));
+            pointList.push_back(corner);
+        }
+        holeList.push_back(hole);
+    }
+}
+
+} // namespace
+
+TEST_CASE("decomposer gives the same result as decompose")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStarWithHoles(pointList, outer, holeList);
+
+    Decomposer decomposer;
+    auto expected = decompose(pointList, outer, holeList);
+
+    REQUIRE(decomposer.decompose(pointList, outer, holeList) == expected);
+    REQUIRE(decomposer.decompose(pointList, outer, holeList) == expected);
+
+    // A small polygon in between does not disturb later calls
+    PointList squarePointList = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    REQUIRE(decomposer.decompose(squarePointList, { 0, 1, 2, 3 }).size() == 1);
+    REQUIRE(decomposer.decompose(pointList, outer, holeList) == expected);
+}
+
+TEST_CASE("decomposer does not allocate temporary storage once warmed up")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStarWithHoles(pointList, outer, holeList);
+
+    CountingResource upstream;
+    {
+        Decomposer decomposer(upstream);
+        std::vector<IndexList> result;
+
+        decomposer.decompose(pointList, outer, holeList, {}, result);
+        auto const warmedUp = upstream.allocationCount;
+        REQUIRE(warmedUp > 0);
+        REQUIRE(upstream.liveCount == 1);
+
+        decomposer.decompose(pointList, outer, holeList, {}, result);
+        decomposer.decompose(pointList, outer, holeList, {}, result);
+        REQUIRE(upstream.allocationCount == warmedUp);
+        REQUIRE(result == decompose(pointList, outer, holeList));
+    }
+    REQUIRE(upstream.liveCount == 0);
+}
+
+TEST_CASE("decomposer does not allocate from the global heap once warmed up")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStarWithHoles(pointList, outer, holeList);
+
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone, Triangulator::ConstrainedDelaunay })
+    {
+        for (auto tier : { Tier::Fast, Tier::Balanced, Tier::Quality })
+        {
+            DecomposeOptions options;
+            options.triangulator = triangulator;
+            options.tier = tier;
+
+            Decomposer decomposer;
+            std::vector<IndexList> result;
+            decomposer.decompose(pointList, outer, holeList, {}, result, options);
+
+            auto const warmedUp = globalAllocationCount.load();
+            decomposer.decompose(pointList, outer, holeList, {}, result, options);
+            decomposer.decompose(pointList, outer, holeList, {}, result, options);
+            REQUIRE(globalAllocationCount.load() == warmedUp);
+        }
+    }
+}
+
+TEST_CASE("arena reuses its memory after release")
+{
+    CountingResource upstream;
+    ArenaResource arena(upstream, 64);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ScratchVector<double> list(arena);
+        for (int j = 0; j < 1000; ++j)
+            list.push_back(j);
+        REQUIRE(list[999] == 999.0);
+        arena.release();
+    }
+
+    // The blocks of the first round were merged into one
+    REQUIRE(upstream.liveCount == 1);
+    auto const allocationCount = upstream.allocationCount;
+
+    ScratchVector<double> list(1000, 0.0, arena);
+    REQUIRE(upstream.allocationCount == allocationCount);
+}
+
+TEST_CASE("decomposer writing into buffers does not allocate at all once warmed up")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStarWithHoles(pointList, outer, holeList);
+
+    auto vertexCount = outer.size();
+    for (auto const& hole : holeList)
+        vertexCount += hole.size();
+
+    std::vector<std::uint16_t> indexBuffer(maxIndexCount(vertexCount, holeList.size()));
+    std::vector<std::uint32_t> offsetBuffer(maxPolygonCount(vertexCount, holeList.size()) + 1);
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone, Triangulator::ConstrainedDelaunay })
+    {
+        DecomposeOptions options;
+        options.triangulator = triangulator;
+
+        Decomposer decomposer;
+        BufferSink warmUpSink(indexBuffer.data(), indexBuffer.size(), offsetBuffer.data(), offsetBuffer.size());
+        decomposer.decompose(pointList, outer, holeList, {}, warmUpSink, options);
+
+        auto const warmedUp = globalAllocationCount.load();
+        BufferSink sink(indexBuffer.data(), indexBuffer.size(), offsetBuffer.data(), offsetBuffer.size());
+        decomposer.decompose(pointList, outer, holeList, {}, sink, options);
+        REQUIRE(globalAllocationCount.load() == warmedUp);
+        REQUIRE(sink.polygonCount() == warmUpSink.polygonCount());
+    }
+}
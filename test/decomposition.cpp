@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <catch2/catch.hpp>
+#include <cmath>
 #include <decomp/convex_decomposition.hpp>
 
 using namespace decomp;
@@ -21,7 +22,7 @@ bool isInternallyConvex(Point const& a, Point const& b, Point const& c)
     return right[0] * left[1] >= right[1] * left[0];
 }
 
-bool isConvex(PointList const& pointList, IndexList const& polygon)
+template <class Index> bool isConvex(PointList const& pointList, BasicIndexList<Index> const& polygon)
 {
     auto N = static_cast<int>(polygon.size());
     for (int i = 0; i < N; ++i)
@@ -36,7 +37,7 @@ bool isConvex(PointList const& pointList, IndexList const& polygon)
     return true;
 }
 
-bool allConvex(PointList const& pointList, std::vector<IndexList> const& polygonList)
+template <class Index> bool allConvex(PointList const& pointList, std::vector<BasicIndexList<Index>> const& polygonList)
 {
     for (auto&& polygon : polygonList)
     {
@@ -211,3 +212,90 @@ TEST_CASE("complete decomposition")
     auto decomposed = decompose(pointList, outerPolygon, holeList);
     REQUIRE(allConvex(pointList, decomposed));
 }
+
+TEST_CASE("merge order of edges with the same priority")
+{
+    // Removing the edges in the order of their half-edge slots after the flips gives 7 polygons here,
+    // where removing them in the order of the triangles before the flips gave 8.
+    PointList pointList = { { 9.04, 1.45 },   { 7.32, 3.19 },  { 5.19, 8.69 },  { 3.13, 7.68 },  { -0.01, 10.47 },
+                            { -6.27, 8.33 },  { -7.08, 4.2 },  { -6.28, 2.24 }, { -10.4, -2.26 }, { -9.05, -6.04 },
+                            { -5.59, -6.5 },  { -1.07, -8.93 }, { 1.66, -9.87 }, { 4.91, -8.09 },  { 8.58, -5.98 },
+                            { 10.24, -3.44 }, { 2.72, -2.65 }, { 0.75, -2.07 }, { 2.05, -1 },     { 2.95, 1.88 },
+                            { 1.24, 1.01 },   { 0.9, 2.02 },   { 2.14, 2.84 } };
+    IndexList outer = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    std::vector<IndexList> holeList = { { 16, 17, 18 }, { 19, 20, 21, 22 } };
+
+    std::vector<IndexList> expected = { { 15, 0, 1, 19, 18, 16, 14 },   { 8, 9, 10 },
+                                        { 7, 8, 10, 11, 17, 20, 21 },   { 19, 20, 17, 18 },
+                                        { 13, 14, 16, 17, 11, 12 },     { 4, 5, 6, 7, 21, 22, 3 },
+                                        { 1, 2, 3, 22, 19 } };
+    REQUIRE(decompose(pointList, outer, holeList) == expected);
+}
+
+TEST_CASE("decomposition with 32-bit indices")
+{
+    // Place the polygon behind more points than 16-bit indices can address
+    std::uint32_t const offset = 70000;
+    std::vector<Point> pointList(offset);
+    pointList.insert(pointList.end(), {
+        { -4, 0 }, { -3, -2 }, { 3, -2 }, { 4, 0 },  { 3, 2 }, { -3, 2 }, // points on the outer polygon
+        { -3, 0 }, { -2, -1 }, { -1, 0 }, { -2, 1 },                      // points on the left hole
+        { 1, 0 },  { 2, -1 },  { 3, 0 },  { 2, 1 }                        // points on the right hole
+    });
+
+    IndexList32 outerPolygon = { 0, 1, 2, 3, 4, 5 };
+    std::vector<IndexList32> holeList = { { 13, 12, 11, 10 }, { 9, 8, 7, 6 } };
+
+    for (auto& index : outerPolygon)
+        index += offset;
+    for (auto& hole : holeList)
+    {
+        for (auto& index : hole)
+            index += offset;
+    }
+
+    auto decomposed = decompose(pointList, outerPolygon, holeList);
+    REQUIRE(!decomposed.empty());
+
+    for (auto const& polygon : decomposed)
+    {
+        for (auto index : polygon)
+            REQUIRE(index >= offset);
+    }
+
+    REQUIRE(allConvex(pointList, decomposed));
+}
+
+TEST_CASE("decomposition of more vertices than 16-bit indices can address")
+{
+    // A star with 100000 vertices, whose last vertices need 17 bits
+    std::uint32_t const N = 100000;
+    PointList pointList;
+    IndexList32 outerPolygon;
+    for (std::uint32_t i = 0; i < N; ++i)
+    {
+        double angle = 6.283185307179586 * i / N;
+        double radius = (i % 2 == 0) ? 100.0 : 99.0;
+        pointList.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        outerPolygon.push_back(i);
+    }
+
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone })
+    {
+        DecomposeOptions options;
+        options.triangulator = triangulator;
+        auto decomposed = decompose(pointList, outerPolygon, {}, {}, options);
+        REQUIRE(allConvex(pointList, decomposed));
+
+        // Every vertex is used, and any convex partition needs more than half as many polygons as there are reflex
+        // vertices, which are every second one
+        std::vector<bool> usedList(N, false);
+        for (auto const& polygon : decomposed)
+        {
+            for (auto index : polygon)
+                usedList[index] = true;
+        }
+        REQUIRE(std::count(usedList.begin(), usedList.end(), false) == 0);
+        REQUIRE(decomposed.size() > N / 4);
+    }
+}
@@ -0,0 +1,201 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include <decomp/delaunay.hpp>
+#include <decomp/predicates.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+#include <map>
+
+using namespace decomp;
+
+namespace
+{
+
+// A square with a regular grid of points on its border, and a few square holes, so that many points are cocircular
+void makeGrid(BasicPointList<std::int32_t>& pointList, IndexList& outer, std::vector<IndexList>& holeList)
+{
+    auto add = [&](std::int32_t x, std::int32_t y) {
+        pointList.emplace_back(x, y);
+        return static_cast<std::uint16_t>(pointList.size() - 1);
+    };
+
+    std::int32_t const size = 40;
+    for (std::int32_t i = 0; i < size; ++i)
+        outer.push_back(add(i, 0));
+    for (std::int32_t i = 0; i < size; ++i)
+        outer.push_back(add(size, i));
+    for (std::int32_t i = size; i > 0; --i)
+        outer.push_back(add(i, size));
+    for (std::int32_t i = size; i > 0; --i)
+        outer.push_back(add(0, i));
+
+    for (std::int32_t x = 5; x < size - 5; x += 10)
+    {
+        for (std::int32_t y = 5; y < size - 5; y += 10)
+            holeList.push_back({ add(x, y), add(x, y + 4), add(x + 4, y + 4), add(x + 4, y) });
+    }
+}
+
+// Check that the triangles cover the polygon, and that no point is inside the circumcircle of a neighboring triangle
+void checkDelaunay(BasicPointList<std::int32_t> const& pointList,
+                   IndexList const& outer,
+                   std::vector<IndexList> const& holeList,
+                   IndexList const& triangleList)
+{
+    auto expected = doubleArea(pointList, outer);
+    for (auto const& hole : holeList)
+        expected += doubleArea(pointList, hole);
+
+    // Opposite vertex of each directed edge
+    std::map<std::pair<std::uint16_t, std::uint16_t>, std::uint16_t> oppositeMap;
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < triangleList.size(); i += 3)
+    {
+        IndexList triangle(triangleList.begin() + i, triangleList.begin() + i + 3);
+        auto area = doubleArea(pointList, triangle);
+        REQUIRE(area > 0);
+        total += area;
+        for (int j = 0; j < 3; ++j)
+        {
+            auto edge = std::make_pair(triangle[j], triangle[(j + 1) % 3]);
+            REQUIRE(oppositeMap.emplace(edge, triangle[(j + 2) % 3]).second);
+        }
+    }
+    REQUIRE(total == expected);
+
+    for (auto const& each : oppositeMap)
+    {
+        auto partner = oppositeMap.find({ each.first.second, each.first.first });
+        if (partner == oppositeMap.end())
+            continue;
+
+        auto const& a = pointList[each.first.first];
+        auto const& b = pointList[each.first.second];
+        REQUIRE(incircle(a, b, pointList[each.second], pointList[partner->second]) <= 0);
+    }
+}
+
+} // namespace
+
+TEST_CASE("constrained delaunay triangulation of a grid with holes")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeGrid(pointList, outer, holeList);
+
+    IndexList triangleList;
+    constrainedDelaunay(IntegerPointView(pointList), outer, holeList, triangleList, newDeleteResource());
+    REQUIRE(triangleList.size() == (pointList.size() - 2 + 2 * holeList.size()) * 3);
+    checkDelaunay(pointList, outer, holeList, triangleList);
+}
+
+TEST_CASE("constrained delaunay triangulation of a star")
+{
+    int const N = 300;
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 6.283185307179586 * i / N;
+        double radius = (i % 2 == 0) ? 10000.0 : 6000.0;
+        pointList.emplace_back(static_cast<std::int32_t>(std::lround(radius * std::cos(angle))),
+                               static_cast<std::int32_t>(std::lround(radius * std::sin(angle))));
+        outer.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+
+    auto triangleList = constrainedDelaunay(converted, outer);
+    checkDelaunay(pointList, outer, {}, triangleList);
+
+    IndexList integerResult;
+    constrainedDelaunay(IntegerPointView(pointList), outer, {}, integerResult, newDeleteResource());
+    REQUIRE(integerResult == triangleList);
+}
+
+TEST_CASE("constrained delaunay triangulation of a comb with long spikes")
+{
+    // The spikes are much longer than they are apart, so their edges cross many edges of the unconstrained
+    // triangulation
+    int const N = 100;
+    BasicPointList<std::int32_t> pointList = { { 0, -10 }, { 10 * N, -10 } };
+    for (int i = N - 1; i >= 0; --i)
+    {
+        pointList.emplace_back(10 * i + 9, 0);
+        pointList.emplace_back(10 * i + 5, 500 + (i * 37) % 23);
+        pointList.emplace_back(10 * i + 1, 0);
+    }
+
+    IndexList outer;
+    for (std::size_t i = 0; i < pointList.size(); ++i)
+        outer.push_back(static_cast<std::uint16_t>(i));
+
+    IndexList triangleList;
+    constrainedDelaunay(IntegerPointView(pointList), outer, {}, triangleList, newDeleteResource());
+    REQUIRE(triangleList.size() == (pointList.size() - 2) * 3);
+    checkDelaunay(pointList, outer, {}, triangleList);
+}
+
+TEST_CASE("constrained delaunay triangulation rejects invalid rings")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 2.0, 2.0 }, { 2.0, 0.0 }, { 0.0, 2.0 }, { 1.0, 1.0 } };
+    REQUIRE_THROWS_AS(constrainedDelaunay(pointList, IndexList{ 0, 1 }), std::invalid_argument);
+    REQUIRE_THROWS_AS(constrainedDelaunay(pointList, { 0, 2, 3 }, { { 4, 1 } }), std::invalid_argument);
+
+    // A bow tie, whose first and third edges cross
+    REQUIRE_THROWS_AS(constrainedDelaunay(pointList, IndexList{ 0, 1, 2, 3 }), std::invalid_argument);
+}
+
+TEST_CASE("delaunay flips keep fixed edges")
+{
+    // A thin rhombus, where the delaunay triangulation uses the short diagonal
+    PointList pointList = { { 0.0, 0.0 }, { 4.0, -1.0 }, { 8.0, 0.0 }, { 4.0, 1.0 } };
+    IndexList triangleList = { 0, 1, 2, 0, 2, 3 };
+
+    auto mesh = buildHalfEdgeGraph(triangleList, { { 0, 2 } });
+    REQUIRE(delaunayFlip(pointList, mesh) == 0);
+
+    mesh = buildHalfEdgeGraph(triangleList, {});
+    REQUIRE(delaunayFlip(pointList, mesh) == 1);
+    REQUIRE(delaunayFlip(pointList, mesh) == 0);
+}
+
+TEST_CASE("decompose with the constrained delaunay triangulator")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeGrid(pointList, outer, holeList);
+
+    DecomposeOptions options;
+    options.triangulator = Triangulator::ConstrainedDelaunay;
+
+    IntegerPointView view(pointList);
+    auto result = decompose(view, outer, holeList, {}, options);
+
+    auto expected = doubleArea(pointList, outer);
+    for (auto const& hole : holeList)
+        expected += doubleArea(pointList, hole);
+
+    std::int64_t total = 0;
+    for (auto const& polygon : result)
+    {
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+        {
+            auto const& a = pointList[polygon[i]];
+            auto const& b = pointList[polygon[(i + 1) % polygon.size()]];
+            auto const& c = pointList[polygon[(i + 2) % polygon.size()]];
+            REQUIRE(orient2d(a, b, c) >= 0);
+        }
+        total += doubleArea(pointList, polygon);
+    }
+    REQUIRE(total == expected);
+
+    Decomposer decomposer;
+    std::vector<IndexList> decomposerResult;
+    decomposer.decompose(view, outer, holeList, {}, decomposerResult, options);
+    REQUIRE(decomposerResult == result);
+}
@@ -0,0 +1,216 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <decomp/dynamic.hpp>
+#include "test_helpers.hpp"
+#include <set>
+
+using namespace decomp;
+
+namespace
+{
+
+// Checks that all polygons are convex, and that every edge is either shared with a neighbor
+// or part of the given outlines. Returns the total area.
+double checkedArea(DynamicDecomposition const& decomposition, std::vector<IndexList32> const& outlineList)
+{
+    std::set<std::pair<std::uint32_t, std::uint32_t>> edgeSet;
+    for (auto const& outline : outlineList)
+    {
+        for (std::size_t i = 0; i < outline.size(); ++i)
+            edgeSet.emplace(outline[(i + 1) % outline.size()], outline[i]);
+    }
+
+    double total = 0.0;
+    for (auto const& polygon : decomposition.polygonList())
+    {
+        REQUIRE(isConvex(decomposition.pointList(), polygon));
+        total += signedArea(decomposition.pointList(), polygon);
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+            edgeSet.emplace(polygon[i], polygon[(i + 1) % polygon.size()]);
+    }
+
+    for (auto const& edge : edgeSet)
+        REQUIRE(edgeSet.count({ edge.second, edge.first }) == 1);
+    return total;
+}
+
+PointList square(double x, double y, double size)
+{
+    // Clockwise, as needed for obstacles
+    return { { x, y }, { x, y + size }, { x + size, y + size }, { x + size, y } };
+}
+
+IndexList32 outlineOf(DynamicDecomposition const& decomposition, PointList const& points)
+{
+    IndexList32 result;
+    for (auto const& p : points)
+    {
+        auto const& pointList = decomposition.pointList();
+        for (std::uint32_t i = 0; i < pointList.size(); ++i)
+        {
+            if (pointList[i] == p)
+                result.push_back(i);
+        }
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("obstacles can be added and removed")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+    DynamicDecomposition decomposition(pointList, outer);
+    REQUIRE(checkedArea(decomposition, { outer }) == Approx(100.0));
+
+    auto first = decomposition.addObstacle(square(2.0, 2.0, 2.0));
+    auto firstOutline = outlineOf(decomposition, square(2.0, 2.0, 2.0));
+    REQUIRE(checkedArea(decomposition, { outer, firstOutline }) == Approx(96.0));
+
+    auto second = decomposition.addObstacle(square(6.0, 5.0, 3.0));
+    auto secondOutline = outlineOf(decomposition, square(6.0, 5.0, 3.0));
+    REQUIRE(second != first);
+    REQUIRE(checkedArea(decomposition, { outer, firstOutline, secondOutline }) == Approx(87.0));
+
+    decomposition.removeObstacle(first);
+    REQUIRE(checkedArea(decomposition, { outer, secondOutline }) == Approx(91.0));
+
+    // The id and points of the removed obstacle are reused
+    auto const pointCount = decomposition.pointList().size();
+    REQUIRE(decomposition.addObstacle(square(1.0, 6.0, 1.0)) == first);
+    REQUIRE(decomposition.pointList().size() == pointCount);
+
+    decomposition.removeObstacle(first);
+    decomposition.removeObstacle(second);
+    REQUIRE(checkedArea(decomposition, { outer }) == Approx(100.0));
+    REQUIRE_THROWS_AS(decomposition.removeObstacle(second), std::out_of_range);
+}
+
+TEST_CASE("holes given up front are obstacles too")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 },
+                            { 4.0, 4.0 }, { 4.0, 6.0 },  { 6.0, 6.0 },   { 6.0, 4.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+    DynamicDecomposition decomposition(pointList, outer, { { 4, 5, 6, 7 } });
+    REQUIRE(checkedArea(decomposition, { outer, { 4, 5, 6, 7 } }) == Approx(96.0));
+
+    decomposition.removeObstacle(0);
+    REQUIRE(checkedArea(decomposition, { outer }) == Approx(100.0));
+}
+
+TEST_CASE("invalid obstacles leave the decomposition unchanged")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 },
+                            { 4.0, 4.0 }, { 4.0, 6.0 },  { 6.0, 6.0 },   { 6.0, 4.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+    DynamicDecomposition decomposition(pointList, outer, { { 4, 5, 6, 7 } });
+    auto const polygonList = decomposition.polygonList();
+
+    // Crossing the outer polygon, overlapping the hole, inside the hole, outside, and counter-clockwise
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(8.0, 8.0, 4.0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(5.0, 5.0, 2.0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(4.5, 4.5, 1.0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(20.0, 20.0, 1.0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(decomposition.addObstacle({ { 1.0, 1.0 }, { 2.0, 1.0 }, { 2.0, 2.0 } }), std::invalid_argument);
+
+    REQUIRE(decomposition.polygonList() == polygonList);
+    REQUIRE(checkedArea(decomposition, { outer, { 4, 5, 6, 7 } }) == Approx(96.0));
+}
+
+TEST_CASE("obstacles enclosing other obstacles are rejected")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 100.0, 0.0 }, { 100.0, 100.0 }, { 0.0, 100.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+    DynamicDecomposition decomposition(pointList, outer);
+
+    decomposition.addObstacle(square(40.0, 40.0, 20.0));
+    auto const innerOutline = outlineOf(decomposition, square(40.0, 40.0, 20.0));
+    auto const polygonList = decomposition.polygonList();
+
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(30.0, 30.0, 40.0)), std::invalid_argument);
+    REQUIRE(decomposition.polygonList() == polygonList);
+
+    // Enclosing the obstacle and some more, and then with a given hole instead of an added one
+    REQUIRE_THROWS_AS(decomposition.addObstacle(square(10.0, 10.0, 80.0)), std::invalid_argument);
+    REQUIRE(checkedArea(decomposition, { outer, innerOutline }) == Approx(9600.0));
+
+    decomposition.addObstacle(square(10.0, 10.0, 10.0));
+    REQUIRE(checkedArea(decomposition, { outer, innerOutline, outlineOf(decomposition, square(10.0, 10.0, 10.0)) }) ==
+            Approx(9500.0));
+
+    pointList.insert(pointList.end(), { { 40.0, 40.0 }, { 40.0, 60.0 }, { 60.0, 60.0 }, { 60.0, 40.0 } });
+    DynamicDecomposition withHole(pointList, outer, { { 4, 5, 6, 7 } });
+    REQUIRE_THROWS_AS(withHole.addObstacle(square(30.0, 30.0, 40.0)), std::invalid_argument);
+}
+
+TEST_CASE("many obstacles keep the mesh consistent")
+{
+    PointList pointList;
+    IndexList32 outer;
+    int const N = 64;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 2.0 * 3.14159265358979323846 * i / N;
+        double radius = (i % 2 == 0) ? 100.0 : 90.0;
+        outer.push_back(static_cast<std::uint32_t>(pointList.size()));
+        pointList.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    DynamicDecomposition decomposition(pointList, outer);
+    double const total = signedArea(pointList, outer);
+
+    // A grid of obstacles, removed in a different order
+    std::vector<std::uint32_t> obstacleList;
+    std::vector<PointList> shapeList;
+    for (int y = -5; y < 5; ++y)
+    {
+        for (int x = -5; x < 5; ++x)
+        {
+            shapeList.push_back(square(x * 12.0 + 1.0 + (y & 1) * 3.0, y * 12.0 + 2.0, 5.0));
+            obstacleList.push_back(decomposition.addObstacle(shapeList.back()));
+        }
+    }
+
+    auto outlineList = [&] {
+        std::vector<IndexList32> result = { outer };
+        for (std::size_t i = 0; i < shapeList.size(); ++i)
+        {
+            if (obstacleList[i] != ~0u)
+                result.push_back(outlineOf(decomposition, shapeList[i]));
+        }
+        return result;
+    };
+    REQUIRE(checkedArea(decomposition, outlineList()) == Approx(total - 100 * 25.0));
+
+    for (std::size_t i = 0; i < obstacleList.size(); i += 3)
+    {
+        decomposition.removeObstacle(obstacleList[i]);
+        obstacleList[i] = ~0u;
+    }
+    REQUIRE(checkedArea(decomposition, outlineList()) == Approx(total - 66 * 25.0));
+}
+
+TEST_CASE("decomposition and updates use the given options")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 },
+                            { 4.0, 4.0 }, { 4.0, 6.0 },  { 6.0, 6.0 },   { 6.0, 4.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone, Triangulator::ConstrainedDelaunay })
+    {
+        DecomposeOptions options;
+        options.triangulator = triangulator;
+        options.tier = Tier::Fast;
+        DynamicDecomposition decomposition(pointList, outer, { { 4, 5, 6, 7 } }, options);
+        REQUIRE(decomposition.polygonList() == decompose(pointList, outer, { { 4, 5, 6, 7 } }, {}, options));
+
+        auto added = decomposition.addObstacle(square(1.0, 1.0, 2.0));
+        auto addedOutline = outlineOf(decomposition, square(1.0, 1.0, 2.0));
+        REQUIRE(checkedArea(decomposition, { outer, { 4, 5, 6, 7 }, addedOutline }) == Approx(92.0));
+
+        decomposition.removeObstacle(added);
+        decomposition.removeObstacle(0);
+        REQUIRE(checkedArea(decomposition, { outer }) == Approx(100.0));
+    }
+}
@@ -1,5 +1,6 @@
 #include <decomp/triangulation.hpp>
 #include <catch2/catch.hpp>
+#include <cmath>
 
 using namespace decomp;
 
@@ -16,3 +17,40 @@ TEST_CASE("can ear-clip a non-simple polygon")
     REQUIRE(triangleList.size() == 8*3);
 }
 
+TEST_CASE("can ear-clip a large polygon")
+{
+    // Large enough to use the reflex vertex grid
+    int const N = 500;
+    std::vector<Point> pointList;
+    std::vector<std::uint16_t> indexList;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 6.283185307179586 * i / N;
+        double radius = (i % 2 == 0) ? 10.0 : 6.0;
+        pointList.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+        indexList.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    auto triangleList = earClipping(pointList, indexList);
+    REQUIRE(triangleList.size() == (N - 2) * 3);
+
+    // All triangles are counter-clockwise and cover exactly the polygon's area
+    auto signedArea = [&](std::uint16_t a, std::uint16_t b, std::uint16_t c) {
+        auto u = pointList[b] - pointList[a];
+        auto v = pointList[c] - pointList[a];
+        return 0.5 * (u[0] * v[1] - u[1] * v[0]);
+    };
+
+    double polygonArea = 0.0;
+    for (int i = 1; i + 1 < N; ++i)
+        polygonArea += signedArea(0, static_cast<std::uint16_t>(i), static_cast<std::uint16_t>(i + 1));
+
+    double triangleArea = 0.0;
+    for (std::size_t i = 0; i < triangleList.size(); i += 3)
+    {
+        auto area = signedArea(triangleList[i], triangleList[i + 1], triangleList[i + 2]);
+        REQUIRE(area >= 0.0);
+        triangleArea += area;
+    }
+    REQUIRE(triangleArea == Approx(polygonArea));
+}
@@ -3,29 +3,36 @@
 
 using namespace decomp;
 
+namespace
+{
+std::uint32_t findEdgeStartingAt(HalfEdgeMesh const& mesh, std::uint16_t vertex)
+{
+    for (std::uint32_t edge = 0; edge < mesh.size(); ++edge)
+    {
+        if (mesh[edge].vertex == vertex)
+            return edge;
+    }
+    return HalfEdgeMesh::none;
+}
+} // namespace
+
 TEST_CASE("flip edges for better triangles")
 {
     std::vector<Point> pointList = { { -3.0, 0.0 }, { 0.0, -1.0 }, { 3.0, 0.0 }, { 0.0, 1.0 } };
     std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3 };
 
-    auto graph = buildHalfEdgeGraph(triangleList, {});
-    edgeFlip(pointList, graph);
-
-    auto one = std::find_if(graph.begin(), graph.end(), [](std::unique_ptr<HalfEdge> const& edge) { return edge->vertex == 0; });
-    REQUIRE(one != graph.end());
+    auto mesh = buildHalfEdgeGraph(triangleList, {});
+    edgeFlip(pointList, mesh);
 
-    auto edgeOne = one->get();
-    REQUIRE(edgeOne->vertex == 0);
-    REQUIRE(edgeOne->next->vertex == 1);
-    REQUIRE(edgeOne->next->next->vertex == 3);
+    auto edgeOne = findEdgeStartingAt(mesh, 0);
+    REQUIRE(edgeOne != HalfEdgeMesh::none);
+    REQUIRE(mesh[HalfEdgeMesh::next(edgeOne)].vertex == 1);
+    REQUIRE(mesh[HalfEdgeMesh::prev(edgeOne)].vertex == 3);
 
-    auto two = std::find_if(graph.begin(), graph.end(), [](std::unique_ptr<HalfEdge> const& edge) { return edge->vertex == 2; });
-    REQUIRE(two != graph.end());
-
-    auto edgeTwo = two->get();
-    REQUIRE(edgeTwo->vertex == 2);
-    REQUIRE(edgeTwo->next->vertex == 3);
-    REQUIRE(edgeTwo->next->next->vertex == 1);
+    auto edgeTwo = findEdgeStartingAt(mesh, 2);
+    REQUIRE(edgeTwo != HalfEdgeMesh::none);
+    REQUIRE(mesh[HalfEdgeMesh::next(edgeTwo)].vertex == 3);
+    REQUIRE(mesh[HalfEdgeMesh::prev(edgeTwo)].vertex == 1);
 }
 
 TEST_CASE("do not flip edges that are fixed")
@@ -34,22 +41,56 @@ TEST_CASE("do not flip edges that are fixed")
     std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3 };
     std::vector<EdgeID> fixedEdges = { {0, 2} };
 
-    auto graph = buildHalfEdgeGraph(triangleList, fixedEdges);
-    edgeFlip(pointList, graph);
+    auto mesh = buildHalfEdgeGraph(triangleList, fixedEdges);
+    edgeFlip(pointList, mesh);
+
+    auto edgeOne = findEdgeStartingAt(mesh, 1);
+    REQUIRE(edgeOne != HalfEdgeMesh::none);
+    REQUIRE(mesh[HalfEdgeMesh::next(edgeOne)].vertex == 2);
+    REQUIRE(mesh[HalfEdgeMesh::prev(edgeOne)].vertex == 0);
+
+    auto edgeTwo = findEdgeStartingAt(mesh, 3);
+    REQUIRE(edgeTwo != HalfEdgeMesh::none);
+    REQUIRE(mesh[HalfEdgeMesh::next(edgeTwo)].vertex == 0);
+    REQUIRE(mesh[HalfEdgeMesh::prev(edgeTwo)].vertex == 2);
+}
+
+TEST_CASE("flipping keeps the mesh consistent")
+{
+    // A fan of thin triangles around vertex 0 that gets flipped several times
+    std::vector<Point> pointList = { { 0.0, 0.0 }, { 10.0, -1.0 }, { 10.0, 1.0 }, { 0.0, 2.0 }, { -10.0, 1.0 },
+                                     { -10.0, -1.0 } };
+    std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5 };
+
+    auto mesh = buildHalfEdgeGraph(triangleList, {});
+    edgeFlip(pointList, mesh);
+
+    for (std::uint32_t edge = 0; edge < mesh.size(); ++edge)
+    {
+        auto partner = mesh[edge].partner;
+        if (partner == HalfEdgeMesh::none)
+            continue;
+
+        REQUIRE(mesh[partner].partner == edge);
+        REQUIRE(mesh[partner].vertex == mesh[HalfEdgeMesh::next(edge)].vertex);
+        REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == mesh[edge].vertex);
+    }
+}
+
+TEST_CASE("edge flip reports the number of flips")
+{
+    std::vector<Point> pointList = { { -3.0, 0.0 }, { 0.0, -1.0 }, { 3.0, 0.0 }, { 0.0, 1.0 } };
+    std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3 };
 
-    auto one = std::find_if(graph.begin(), graph.end(), [](std::unique_ptr<HalfEdge> const& edge) { return edge->vertex == 1; });
-    REQUIRE(one != graph.end());
+    auto mesh = buildHalfEdgeGraph(triangleList, {});
+    REQUIRE(edgeFlip(pointList, mesh) == 1);
 
-    auto edgeOne = one->get();
-    REQUIRE(edgeOne->vertex == 1);
-    REQUIRE(edgeOne->next->vertex == 2);
-    REQUIRE(edgeOne->next->next->vertex == 0);
+    // Already optimal, so nothing left to do
+    REQUIRE(edgeFlip(pointList, mesh) == 0);
 
-    auto two = std::find_if(graph.begin(), graph.end(), [](std::unique_ptr<HalfEdge> const& edge) { return edge->vertex == 3; });
-    REQUIRE(two != graph.end());
+    auto fixedMesh = buildHalfEdgeGraph(triangleList, { { 0, 2 } });
+    REQUIRE(edgeFlip(pointList, fixedMesh) == 0);
 
-    auto edgeTwo = two->get();
-    REQUIRE(edgeTwo->vertex == 3);
-    REQUIRE(edgeTwo->next->vertex == 0);
-    REQUIRE(edgeTwo->next->next->vertex == 2);
+    auto limitedMesh = buildHalfEdgeGraph(triangleList, {});
+    REQUIRE(edgeFlip(pointList, limitedMesh, 0) == 0);
 }
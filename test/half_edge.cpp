@@ -8,32 +8,33 @@ TEST_CASE("can build a correct half-edge graph")
     std::vector<Point> pointList = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
     std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3 };
 
-    auto graph = buildHalfEdgeGraph(triangleList, {});
+    auto mesh = buildHalfEdgeGraph(triangleList, {});
 
-    REQUIRE(graph.size() == 6);
+    REQUIRE(mesh.size() == 6);
 
-    for (auto&& edge : graph)
+    for (std::uint32_t edge = 0; edge < mesh.size(); ++edge)
     {
-        REQUIRE(edge->next != nullptr);
-        REQUIRE(edge->fixed == false);
+        auto next = HalfEdgeMesh::next(edge);
+        auto partner = mesh[edge].partner;
+        REQUIRE(mesh[edge].fixed == false);
 
-        if (edge->vertex == 2 && edge->next->vertex == 0)
+        if (mesh[edge].vertex == 2 && mesh[next].vertex == 0)
         {
-            REQUIRE(edge->partner);
-            REQUIRE(edge->partner->partner == edge.get());
-            REQUIRE(edge->partner->vertex == 0);
-            REQUIRE(edge->partner->next->vertex == 2);
+            REQUIRE(partner != HalfEdgeMesh::none);
+            REQUIRE(mesh[partner].partner == edge);
+            REQUIRE(mesh[partner].vertex == 0);
+            REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == 2);
         }
-        else if (edge->vertex == 0 && edge->next->vertex == 2)
+        else if (mesh[edge].vertex == 0 && mesh[next].vertex == 2)
         {
-            REQUIRE(edge->partner);
-            REQUIRE(edge->partner->partner == edge.get());
-            REQUIRE(edge->partner->vertex == 2);
-            REQUIRE(edge->partner->next->vertex == 0);
+            REQUIRE(partner != HalfEdgeMesh::none);
+            REQUIRE(mesh[partner].partner == edge);
+            REQUIRE(mesh[partner].vertex == 2);
+            REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == 0);
         }
         else
         {
-            REQUIRE(edge->partner == nullptr);
+            REQUIRE(partner == HalfEdgeMesh::none);
         }
     }
 }
@@ -44,34 +45,79 @@ TEST_CASE("can mark edges as fixed")
     std::vector<std::uint16_t> triangleList = { 0, 1, 2, 0, 2, 3 };
     std::vector<EdgeID> fixedEdges = { {0, 2} };
 
-    auto graph = buildHalfEdgeGraph(triangleList, fixedEdges);
+    auto mesh = buildHalfEdgeGraph(triangleList, fixedEdges);
 
-    REQUIRE(graph.size() == 6);
+    REQUIRE(mesh.size() == 6);
 
-    for (auto&& edge : graph)
+    for (std::uint32_t edge = 0; edge < mesh.size(); ++edge)
     {
-        REQUIRE(edge->next != nullptr);
+        auto next = HalfEdgeMesh::next(edge);
+        auto partner = mesh[edge].partner;
 
-        if (edge->vertex == 2 && edge->next->vertex == 0)
+        if (mesh[edge].vertex == 2 && mesh[next].vertex == 0)
         {
-            REQUIRE(edge->partner);
-            REQUIRE(edge->partner->partner == edge.get());
-            REQUIRE(edge->partner->vertex == 0);
-            REQUIRE(edge->partner->next->vertex == 2);
-            REQUIRE(edge->fixed == true);
+            REQUIRE(partner != HalfEdgeMesh::none);
+            REQUIRE(mesh[partner].partner == edge);
+            REQUIRE(mesh[partner].vertex == 0);
+            REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == 2);
+            REQUIRE(mesh[edge].fixed == true);
         }
-        else if (edge->vertex == 0 && edge->next->vertex == 2)
+        else if (mesh[edge].vertex == 0 && mesh[next].vertex == 2)
         {
-            REQUIRE(edge->partner);
-            REQUIRE(edge->partner->partner == edge.get());
-            REQUIRE(edge->partner->vertex == 2);
-            REQUIRE(edge->partner->next->vertex == 0);
-            REQUIRE(edge->fixed == true);
+            REQUIRE(partner != HalfEdgeMesh::none);
+            REQUIRE(mesh[partner].partner == edge);
+            REQUIRE(mesh[partner].vertex == 2);
+            REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == 0);
+            REQUIRE(mesh[edge].fixed == true);
         }
         else
         {
-            REQUIRE(edge->partner == nullptr);
-            REQUIRE(edge->fixed == false);
+            REQUIRE(partner == HalfEdgeMesh::none);
+            REQUIRE(mesh[edge].fixed == false);
         }
     }
 }
+
+TEST_CASE("can pair the edges of a large mesh")
+{
+    // Triangulated grid, large enough for vertex indices to need more than one byte
+    int const size = 40;
+    std::vector<std::uint16_t> triangleList;
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            auto a = static_cast<std::uint16_t>(y * (size + 1) + x);
+            auto b = static_cast<std::uint16_t>(a + 1);
+            auto c = static_cast<std::uint16_t>(a + size + 2);
+            auto d = static_cast<std::uint16_t>(a + size + 1);
+            triangleList.insert(triangleList.end(), { a, b, c, a, c, d });
+        }
+    }
+
+    std::vector<EdgeID> fixedEdges = { { 42, 0 } };
+    auto mesh = buildHalfEdgeGraph(triangleList, fixedEdges);
+
+    std::size_t boundaryCount = 0;
+    std::size_t fixedCount = 0;
+    for (std::uint32_t edge = 0; edge < mesh.size(); ++edge)
+    {
+        auto next = HalfEdgeMesh::next(edge);
+        auto partner = mesh[edge].partner;
+        if (mesh[edge].fixed)
+            ++fixedCount;
+
+        if (partner == HalfEdgeMesh::none)
+        {
+            ++boundaryCount;
+            continue;
+        }
+
+        REQUIRE(mesh[partner].partner == edge);
+        REQUIRE(mesh[partner].vertex == mesh[next].vertex);
+        REQUIRE(mesh[HalfEdgeMesh::next(partner)].vertex == mesh[edge].vertex);
+    }
+
+    REQUIRE(boundaryCount == 4 * size);
+    REQUIRE(fixedCount == 2);
+}
@@ -0,0 +1,43 @@
+#include <decomp/indexed_heap.hpp>
+#include <catch2/catch.hpp>
+
+using namespace decomp;
+
+TEST_CASE("indexed heap extracts by priority and insertion order")
+{
+    IndexedHeap<double> heap(5);
+    heap.push(3, 2.0);
+    heap.push(0, 1.0);
+    heap.push(4, 2.0);
+    heap.push(1, 0.5);
+    heap.push(2, 2.0);
+
+    REQUIRE(heap.size() == 5);
+    REQUIRE(heap.pop() == 1);
+    REQUIRE(heap.pop() == 0);
+    REQUIRE(heap.pop() == 3);
+    REQUIRE(heap.pop() == 4);
+    REQUIRE(heap.pop() == 2);
+    REQUIRE(heap.empty());
+}
+
+TEST_CASE("indexed heap can update and erase slots")
+{
+    IndexedHeap<double> heap(4);
+    for (std::uint32_t i = 0; i < 4; ++i)
+        heap.push(i, double(i));
+
+    heap.update(3, -1.0);
+    heap.update(0, 2.0);
+    heap.erase(1);
+
+    REQUIRE(!heap.contains(1));
+    REQUIRE(heap.contains(0));
+    REQUIRE(heap.priority(0) == 2.0);
+
+    // Updated to an existing priority, so slot 0 now comes after slot 2
+    REQUIRE(heap.pop() == 3);
+    REQUIRE(heap.pop() == 2);
+    REQUIRE(heap.pop() == 0);
+    REQUIRE(heap.empty());
+}
@@ -0,0 +1,80 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include <decomp/predicates.hpp>
+#include "test_helpers.hpp"
+
+using namespace decomp;
+
+namespace
+{
+
+// A comb on a grid, with many collinear points along its base, and a rectangular hole in each tooth
+int const combTeeth = 20;
+std::int32_t const combWidth = 8 * combTeeth - 4;
+
+void makeGridComb(std::int32_t scale,
+                  BasicPointList<std::int32_t>& pointList,
+                  IndexList& outer,
+                  std::vector<IndexList>& holeList)
+{
+    auto add = [&](std::int32_t x, std::int32_t y) {
+        pointList.emplace_back(x * scale, y * scale);
+        return static_cast<std::uint16_t>(pointList.size() - 1);
+    };
+
+    for (std::int32_t x = 0; x <= combWidth; x += 4)
+        outer.push_back(add(x, 0));
+
+    for (std::int32_t x = combWidth - 4; x >= 0; x -= 8)
+    {
+        for (auto y : { 4, 20 })
+            outer.push_back(add(x + 4, y));
+        for (auto y : { 20, 4 })
+            outer.push_back(add(x, y));
+
+        holeList.push_back({ add(x + 1, 8), add(x + 1, 12), add(x + 3, 12), add(x + 3, 8) });
+    }
+}
+
+} // namespace
+
+TEST_CASE("integer mode rejects coordinates out of range")
+{
+    BasicPointList<std::int32_t> pointList = { { 0, 0 }, { integerCoordinateLimit, -integerCoordinateLimit } };
+    REQUIRE_NOTHROW(IntegerPointView(pointList));
+
+    pointList.emplace_back(0, integerCoordinateLimit + 1);
+    REQUIRE_THROWS_AS(IntegerPointView(pointList), std::invalid_argument);
+
+    std::int32_t x[] = { 0, -integerCoordinateLimit - 1 };
+    std::int32_t y[] = { 0, 0 };
+    REQUIRE_THROWS_AS(IntegerPointView(x, y, 2), std::invalid_argument);
+}
+
+TEST_CASE("integer mode decomposes grid maps into convex polygons")
+{
+    for (std::int32_t scale : { 1, 1000, integerCoordinateLimit / combWidth })
+    {
+        BasicPointList<std::int32_t> pointList;
+        IndexList outer;
+        std::vector<IndexList> holeList;
+        makeGridComb(scale, pointList, outer, holeList);
+
+        IntegerPointView view(pointList);
+        checkDecomposition(pointList, outer, holeList, decompose(view, outer, holeList));
+    }
+}
+
+TEST_CASE("decomposer gives the same result in integer mode")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeGridComb(7, pointList, outer, holeList);
+
+    IntegerPointView view(pointList);
+    Decomposer decomposer;
+    std::vector<IndexList> result;
+    decomposer.decompose(view, outer, holeList, {}, result);
+    REQUIRE(result == decompose(view, outer, holeList));
+}
@@ -0,0 +1,156 @@
+#include <catch2/catch.hpp>
+#include <decomp/kernels.hpp>
+
+using namespace decomp;
+
+namespace
+{
+
+// Small integer coordinates, so there are many collinear and coincident points
+class Random
+{
+public:
+    double next()
+    {
+        mState = mState * 1664525u + 1013904223u;
+        return static_cast<double>((mState >> 16) % 9) - 4.0;
+    }
+
+private:
+    std::uint32_t mState = 1;
+};
+
+// Exact for the small integer coordinates used here
+std::int64_t orientation(Point const& a, Point const& b, Point const& c)
+{
+    auto u0 = static_cast<std::int64_t>(b[0] - a[0]), u1 = static_cast<std::int64_t>(b[1] - a[1]);
+    auto v0 = static_cast<std::int64_t>(c[0] - a[0]), v1 = static_cast<std::int64_t>(c[1] - a[1]);
+    return u0 * v1 - u1 * v0;
+}
+
+bool triangleContains(Point const& a, Point const& b, Point const& c, Point const& tested)
+{
+    return orientation(a, tested, b) <= 0 && orientation(b, tested, c) <= 0 && orientation(c, tested, a) <= 0;
+}
+
+bool segmentsIntersect(Point const& a, Point const& b, Point const& c, Point const& d)
+{
+    auto o1 = orientation(a, b, c), o2 = orientation(a, b, d);
+    auto o3 = orientation(c, d, a), o4 = orientation(c, d, b);
+    if (o1 == 0 && o2 == 0)
+        return false;
+    return !((o1 > 0 && o2 > 0) || (o1 < 0 && o2 < 0)) && !((o3 > 0 && o4 > 0) || (o3 < 0 && o4 < 0));
+}
+
+std::vector<InstructionSet> supportedInstructionSets()
+{
+    std::vector<InstructionSet> result;
+    for (auto each : { InstructionSet::Scalar, InstructionSet::SSE2, InstructionSet::AVX2 })
+    {
+        if (isSupported(each))
+            result.push_back(each);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("batch kernels match the single point tests")
+{
+    Random random;
+    for (auto instructionSet : supportedInstructionSets())
+    {
+        auto const& kernels = batchKernels(instructionSet);
+        for (std::size_t count = 0; count <= 19; ++count)
+        {
+            for (int trial = 0; trial < 50; ++trial)
+            {
+                Point a(random.next(), random.next()), b(random.next(), random.next()), c(random.next(), random.next());
+                std::vector<double> x0, y0, x1, y1;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    x0.push_back(random.next());
+                    y0.push_back(random.next());
+                    x1.push_back(random.next());
+                    y1.push_back(random.next());
+                }
+
+                std::size_t inTriangle = count, intersecting = count;
+                for (std::size_t i = count; i-- > 0;)
+                {
+                    if (triangleContains(a, b, c, Point(x0[i], y0[i])))
+                        inTriangle = i;
+                    if (segmentsIntersect(a, b, Point(x0[i], y0[i]), Point(x1[i], y1[i])))
+                        intersecting = i;
+                }
+
+                REQUIRE(kernels.firstInTriangle(a, b, c, x0.data(), y0.data(), count) == inTriangle);
+                REQUIRE(kernels.firstIntersecting(a, b, x0.data(), y0.data(), x1.data(), y1.data(), count) ==
+                        intersecting);
+            }
+        }
+    }
+}
+
+TEST_CASE("batch kernels are exact for nearly collinear points")
+{
+    // Points within a few ulps of the line through a and b, so that most need the exact fallback
+    auto const ulp = std::ldexp(1.0, -53);
+    Point a(0.0, 0.0), b(1.0, 1.0), c(1.0, 0.0);
+    std::vector<double> x0, y0, x1, y1;
+    for (int i = 0; i < 37; ++i)
+    {
+        x0.push_back(0.5 + (i % 5) * ulp);
+        y0.push_back(0.5 + (i % 7) * ulp);
+        x1.push_back(0.5 + (i % 3) * ulp);
+        y1.push_back(0.5 - (i % 2) * ulp);
+    }
+
+    auto const& scalar = batchKernels(InstructionSet::Scalar);
+    for (auto instructionSet : supportedInstructionSets())
+    {
+        auto const& kernels = batchKernels(instructionSet);
+        for (std::size_t first = 0; first < x0.size(); ++first)
+        {
+            auto count = x0.size() - first;
+            REQUIRE(kernels.firstInTriangle(a, b, c, &x0[first], &y0[first], count) ==
+                    scalar.firstInTriangle(a, b, c, &x0[first], &y0[first], count));
+            REQUIRE(kernels.firstIntersecting(a, b, &x0[first], &y0[first], &x1[first], &y1[first], count) ==
+                    scalar.firstIntersecting(a, b, &x0[first], &y0[first], &x1[first], &y1[first], count));
+        }
+    }
+}
+
+TEST_CASE("shoelace sums are the same for all instruction sets")
+{
+    std::vector<double> x, y;
+    for (int i = 0; i < 37; ++i)
+    {
+        // Irregular values, so that rounding depends on the order of the additions
+        x.push_back(1.0 / (i + 3) + i * 1e-3);
+        y.push_back(1.0 / (i * i + 7) - i * 1e5);
+    }
+
+    auto const& scalar = batchKernels(InstructionSet::Scalar);
+    for (auto instructionSet : supportedInstructionSets())
+    {
+        for (std::size_t count = 0; count <= x.size(); ++count)
+            REQUIRE(batchKernels(instructionSet).shoelaceSum(x.data(), y.data(), count) ==
+                    scalar.shoelaceSum(x.data(), y.data(), count));
+    }
+
+    // A unit square, closed by repeating the first point
+    double squareX[] = { 0.0, 1.0, 1.0, 0.0, 0.0 };
+    double squareY[] = { 0.0, 0.0, 1.0, 1.0, 0.0 };
+    REQUIRE(batchKernels().shoelaceSum(squareX, squareY, 5) == 2.0);
+}
+
+TEST_CASE("unsupported instruction sets are rejected")
+{
+    REQUIRE(isSupported(InstructionSet::Scalar));
+    for (auto each : { InstructionSet::SSE2, InstructionSet::AVX2 })
+    {
+        if (!isSupported(each))
+            REQUIRE_THROWS_AS(batchKernels(each), std::invalid_argument);
+    }
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include <decomp/monotone.hpp>
+#include <decomp/predicates.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+#include <set>
+
+using namespace decomp;
+
+namespace
+{
+
+// A comb with many collinear points along its base and on its teeth, and a hole in each tooth
+void makeComb(BasicPointList<std::int32_t>& pointList, IndexList& outer, std::vector<IndexList>& holeList)
+{
+    auto add = [&](std::int32_t x, std::int32_t y) {
+        pointList.emplace_back(x, y);
+        return static_cast<std::uint16_t>(pointList.size() - 1);
+    };
+
+    int const teeth = 12;
+    for (std::int32_t x = 0; x <= 8 * teeth - 4; x += 2)
+        outer.push_back(add(x, 0));
+
+    for (std::int32_t x = 8 * teeth - 8; x >= 0; x -= 8)
+    {
+        for (auto y : { 4, 12, 20 })
+            outer.push_back(add(x + 4, y));
+        for (auto y : { 20, 12, 4 })
+            outer.push_back(add(x, y));
+
+        holeList.push_back({ add(x + 1, 8), add(x + 1, 16), add(x + 3, 16), add(x + 3, 12), add(x + 3, 8) });
+    }
+}
+
+// Check that the triangles are counter-clockwise, and that each edge is either shared by exactly two of them,
+// or an edge of one of the rings
+void checkTriangulation(BasicPointList<std::int32_t> const& pointList,
+                        IndexList const& outer,
+                        std::vector<IndexList> const& holeList,
+                        IndexList const& triangleList)
+{
+    std::set<std::pair<std::uint16_t, std::uint16_t>> edgeSet, boundarySet;
+    auto addRing = [&](IndexList const& ring) {
+        for (std::size_t i = 0; i < ring.size(); ++i)
+            boundarySet.emplace(ring[i], ring[(i + 1) % ring.size()]);
+    };
+    addRing(outer);
+    for (auto const& hole : holeList)
+        addRing(hole);
+
+    auto expected = doubleArea(pointList, outer);
+    for (auto const& hole : holeList)
+        expected += doubleArea(pointList, hole);
+
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < triangleList.size(); i += 3)
+    {
+        IndexList triangle(triangleList.begin() + i, triangleList.begin() + i + 3);
+        auto area = doubleArea(pointList, triangle);
+        REQUIRE(area > 0);
+        total += area;
+        for (int j = 0; j < 3; ++j)
+            REQUIRE(edgeSet.emplace(triangle[j], triangle[(j + 1) % 3]).second);
+    }
+    REQUIRE(total == expected);
+
+    for (auto const& edge : edgeSet)
+    {
+        bool isBoundary = boundarySet.count(edge) != 0;
+        REQUIRE(isBoundary != (edgeSet.count({ edge.second, edge.first }) != 0));
+    }
+    for (auto const& edge : boundarySet)
+        REQUIRE(edgeSet.count(edge) != 0);
+}
+
+} // namespace
+
+TEST_CASE("monotone triangulation of a polygon with holes")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeComb(pointList, outer, holeList);
+
+    // Each hole adds two triangles
+    IndexList triangleList;
+    monotoneTriangulation(IntegerPointView(pointList), outer, holeList, triangleList, newDeleteResource());
+    REQUIRE(triangleList.size() == (pointList.size() - 2 + 2 * holeList.size()) * 3);
+    checkTriangulation(pointList, outer, holeList, triangleList);
+
+    // The same shape rotated by 90 degrees, so that its collinear edges are vertical
+    BasicPointList<std::int32_t> rotatedList;
+    for (auto const& point : pointList)
+        rotatedList.emplace_back(-point.y(), point.x());
+    monotoneTriangulation(IntegerPointView(rotatedList), outer, holeList, triangleList, newDeleteResource());
+    checkTriangulation(rotatedList, outer, holeList, triangleList);
+}
+
+TEST_CASE("monotone triangulation of a star with many split and merge vertices")
+{
+    // Integer coordinates, so that the double results can be checked exactly
+    int const N = 400;
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 6.283185307179586 * i / N;
+        double radius = (i % 2 == 0) ? 10000.0 : 6000.0;
+        pointList.emplace_back(static_cast<std::int32_t>(std::lround(radius * std::cos(angle))),
+                               static_cast<std::int32_t>(std::lround(radius * std::sin(angle))));
+        outer.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    // Empty holes are ignored
+    std::vector<IndexList> holeList(1);
+    for (std::int32_t x = -2000; x < 2000; x += 1000)
+    {
+        auto first = static_cast<std::uint16_t>(pointList.size());
+        pointList.emplace_back(x, 0);
+        pointList.emplace_back(x + 500, 500);
+        pointList.emplace_back(x + 500, -500);
+        holeList.push_back({ first, std::uint16_t(first + 1), std::uint16_t(first + 2) });
+    }
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+
+    auto triangleList = monotoneTriangulation(converted, outer, holeList);
+    checkTriangulation(pointList, outer, holeList, triangleList);
+
+    IndexList viewResult;
+    monotoneTriangulation(PointView(converted), outer, holeList, viewResult, newDeleteResource());
+    REQUIRE(viewResult == triangleList);
+}
+
+TEST_CASE("monotone triangulation rejects degenerate rings")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 0.0, 1.0 }, { 0.2, 0.2 }, { 0.2, 0.4 } };
+    REQUIRE_THROWS_AS(monotoneTriangulation(pointList, IndexList{ 0, 1 }), std::invalid_argument);
+    REQUIRE_THROWS_AS(monotoneTriangulation(pointList, { 0, 1, 2 }, { { 3, 4 } }), std::invalid_argument);
+}
+
+TEST_CASE("decompose with the monotone triangulator")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeComb(pointList, outer, holeList);
+
+    DecomposeOptions options;
+    options.triangulator = Triangulator::Monotone;
+
+    IntegerPointView view(pointList);
+    auto result = decompose(view, outer, holeList, {}, options);
+
+    auto expected = doubleArea(pointList, outer);
+    for (auto const& hole : holeList)
+        expected += doubleArea(pointList, hole);
+
+    std::int64_t total = 0;
+    for (auto const& polygon : result)
+    {
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+        {
+            auto const& a = pointList[polygon[i]];
+            auto const& b = pointList[polygon[(i + 1) % polygon.size()]];
+            auto const& c = pointList[polygon[(i + 2) % polygon.size()]];
+            REQUIRE(orient2d(a, b, c) >= 0);
+        }
+        total += doubleArea(pointList, polygon);
+    }
+    REQUIRE(total == expected);
+
+    Decomposer decomposer;
+    std::vector<IndexList> decomposerResult;
+    decomposer.decompose(view, outer, holeList, {}, decomposerResult, options);
+    REQUIRE(decomposerResult == result);
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+    REQUIRE(decompose(converted, outer, holeList, {}, options) == result);
+}
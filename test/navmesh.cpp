@@ -0,0 +1,163 @@
+#include <catch2/catch.hpp>
+#include <decomp/navmesh.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace decomp;
+
+namespace
+{
+
+// Copy a written navmesh into memory that is aligned like a mapped file
+std::vector<std::uint64_t> toWords(std::string const& bytes)
+{
+    std::vector<std::uint64_t> wordList((bytes.size() + 7) / 8);
+    std::memcpy(wordList.data(), bytes.data(), bytes.size());
+    return wordList;
+}
+
+} // namespace
+
+TEST_CASE("navmesh round trip")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    PolygonAdjacency adjacency;
+    auto polygonList = decompose(pointList, outer, holeList, {}, adjacency);
+
+    std::ostringstream out;
+    writeNavMesh(out, pointList, outer, holeList, polygonList, &adjacency);
+    auto bytes = out.str();
+    REQUIRE(bytes.size() % 8 == 0);
+    auto wordList = toWords(bytes);
+
+    NavMeshView view(wordList.data(), bytes.size());
+    REQUIRE(view.header().version == navMeshVersion);
+
+    auto pointView = view.pointView();
+    REQUIRE(pointView.size() == pointList.size());
+    for (std::size_t i = 0; i < pointList.size(); ++i)
+        REQUIRE(pointView[i] == pointList[i]);
+
+    REQUIRE(view.ringCount() == holeList.size() + 1);
+    REQUIRE(IndexList(view.ring(0), view.ring(0) + view.ringSize(0)) == outer);
+    for (std::size_t hole = 0; hole < holeList.size(); ++hole)
+        REQUIRE(IndexList(view.ring(hole + 1), view.ring(hole + 1) + view.ringSize(hole + 1)) == holeList[hole]);
+
+    REQUIRE(view.polygonCount() == polygonList.size());
+    REQUIRE(view.hasAdjacency());
+    for (std::size_t polygon = 0; polygon < polygonList.size(); ++polygon)
+    {
+        REQUIRE(IndexList(view.polygon(polygon), view.polygon(polygon) + view.polygonSize(polygon)) ==
+                polygonList[polygon]);
+        for (std::size_t side = 0; side < view.polygonSize(polygon); ++side)
+        {
+            REQUIRE(view.neighbor(polygon, side) == adjacency.neighbor(polygon, side));
+            REQUIRE(view.neighborSide(polygon, side) == adjacency.neighborSide(polygon, side));
+        }
+    }
+
+    // The points can be decomposed in place
+    std::vector<IndexList> holeViewList;
+    for (std::size_t hole = 1; hole < view.ringCount(); ++hole)
+        holeViewList.emplace_back(view.ring(hole), view.ring(hole) + view.ringSize(hole));
+    DecomposeOptions options;
+    options.triangulator = Triangulator::Monotone;
+    REQUIRE(decompose(pointView, outer, holeViewList, {}, options) ==
+            decompose(pointList, outer, holeList, {}, options));
+}
+
+TEST_CASE("navmesh without adjacency from a flat list")
+{
+    PointList pointList = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    IndexList32 outer = { 0, 1, 2, 3 };
+
+    FlatPolygonList32 flatList;
+    FlatPolygonSink32 sink(flatList);
+    decompose(pointList, outer, {}, {}, sink);
+
+    std::ostringstream out;
+    writeNavMesh(out, pointList, outer, {}, flatList);
+    auto bytes = out.str();
+    auto wordList = toWords(bytes);
+
+    NavMeshView32 view(wordList.data(), bytes.size());
+    REQUIRE(!view.hasAdjacency());
+    REQUIRE(view.polygonCount() == 1);
+    REQUIRE(std::vector<std::uint32_t>(view.polygonOffsetList(), view.polygonOffsetList() + 2) ==
+            flatList.offsetList);
+    REQUIRE(IndexList32(view.polygonIndexList(), view.polygonIndexList() + 4) == flatList.indexList);
+
+    // The index type needs to match
+    REQUIRE_THROWS_AS(NavMeshView(wordList.data(), bytes.size()), std::runtime_error);
+
+    // Adjacency of other polygons is rejected
+    PolygonAdjacency adjacency;
+    std::ostringstream rejected;
+    REQUIRE_THROWS_AS(writeNavMesh(rejected, pointList, outer, {}, flatList, &adjacency), std::invalid_argument);
+}
+
+TEST_CASE("navmesh rejects damaged data")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    std::ostringstream out;
+    writeNavMesh(out, pointList, outer, holeList, decompose(pointList, outer, holeList));
+    auto bytes = out.str();
+
+    auto truncated = toWords(bytes);
+    REQUIRE_THROWS_AS(NavMeshView(truncated.data(), bytes.size() - 8), std::runtime_error);
+    REQUIRE_THROWS_AS(NavMeshView(truncated.data(), sizeof(NavMeshHeader) - 1), std::runtime_error);
+
+    auto damaged = bytes;
+    damaged[sizeof(NavMeshHeader) + 100] ^= 1;
+    auto damagedWords = toWords(damaged);
+    REQUIRE_THROWS_AS(NavMeshView(damagedWords.data(), damaged.size()), std::runtime_error);
+    NavMeshView unchecked(damagedWords.data(), damaged.size(), false);
+    REQUIRE(unchecked.polygonCount() > 0);
+
+    // A navmesh from a machine with the other byte order
+    auto swapped = toWords(bytes);
+    auto header = reinterpret_cast<NavMeshHeader*>(swapped.data());
+    header->endianTag = 0x04030201;
+    REQUIRE_THROWS_AS(NavMeshView(swapped.data(), bytes.size()), std::runtime_error);
+}
+
+TEST_CASE("navmesh file is loaded in place")
+{
+    PointList pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    PolygonAdjacency adjacency;
+    auto polygonList = decompose(pointList, outer, holeList, {}, adjacency);
+
+    auto const path = "navmesh_test.bin";
+    {
+        std::ofstream file(path, std::ios::binary);
+        writeNavMesh(file, pointList, outer, holeList, polygonList, &adjacency);
+    }
+
+    {
+        NavMeshFile file(path);
+        NavMeshView view(file);
+        REQUIRE(view.polygonCount() == polygonList.size());
+        REQUIRE(view.pointView()[7] == pointList[7]);
+        REQUIRE(view.neighbor(1, 0) == adjacency.neighbor(1, 0));
+    }
+    std::remove(path);
+
+    REQUIRE_THROWS_AS(NavMeshFile("does_not_exist.bin"), std::runtime_error);
+}
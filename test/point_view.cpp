@@ -0,0 +1,112 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <decomp/decomposer.hpp>
+
+using namespace decomp;
+
+namespace
+{
+
+// Star with a few square holes, with coordinates rounded to integers so they are exact in all coordinate types
+void makeStarWithHoles(BasicPointList<std::int32_t>& pointList, IndexList& outer, std::vector<IndexList>& holeList)
+{
+    int const N = 200;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 2.0 * 3.14159265358979323846 * i / N;
+        double radius = (i % 2 == 0) ? 10000.0 : 7000.0;
+        outer.push_back(static_cast<std::uint16_t>(pointList.size()));
+        pointList.emplace_back(static_cast<std::int32_t>(std::lround(radius * std::cos(angle))),
+                               static_cast<std::int32_t>(std::lround(radius * std::sin(angle))));
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        std::int32_t x = -3000 + 2000 * i;
+        IndexList hole;
+        for (auto const& corner : { BasicPoint<std::int32_t>(x, 500), BasicPoint<std::int32_t>(x + 500, 500),
+                                    BasicPoint<std::int32_t>(x + 500, 0), BasicPoint<std::int32_t>(x, 0) })
+        {
+            hole.push_back(static_cast<std::uint16_t>(pointList.size()));
+            pointList.push_back(corner);
+        }
+        holeList.push_back(hole);
+    }
+}
+
+template <class T> BasicPointList<T> convert(BasicPointList<std::int32_t> const& pointList)
+{
+    BasicPointList<T> result;
+    for (auto const& p : pointList)
+        result.emplace_back(static_cast<T>(p.x()), static_cast<T>(p.y()));
+    return result;
+}
+
+} // namespace
+
+TEST_CASE("views read points in all layouts")
+{
+    PointList pointList = { { 1.0, 2.0 }, { 3.0, 4.0 } };
+    std::vector<float> x = { 1.f, 3.f };
+    std::vector<float> y = { 2.f, 4.f };
+    BasicPointList<std::int32_t> fixedPointList = { { 1, 2 }, { 3, 4 } };
+
+    PointView interleaved(pointList);
+    FloatPointView separate(x.data(), y.data(), x.size());
+    FixedPointView fixed(fixedPointList);
+
+    REQUIRE(interleaved.size() == 2);
+    REQUIRE(separate.size() == 2);
+    REQUIRE(fixed.size() == 2);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        REQUIRE(interleaved[i] == pointList[i]);
+        REQUIRE(separate[i] == pointList[i]);
+        REQUIRE(fixed[i] == pointList[i]);
+    }
+}
+
+TEST_CASE("decomposing a view gives the same result as the converted point list")
+{
+    BasicPointList<std::int32_t> fixedPointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStarWithHoles(fixedPointList, outer, holeList);
+
+    auto pointList = convert<double>(fixedPointList);
+    auto floatPointList = convert<float>(fixedPointList);
+    auto expected = decompose(pointList, outer, holeList);
+
+    REQUIRE(decompose(FixedPointView(fixedPointList), outer, holeList) == expected);
+    REQUIRE(decompose(FloatPointView(floatPointList), outer, holeList) == expected);
+    REQUIRE(decompose(PointView(pointList), outer, holeList) == expected);
+
+    // Structure of arrays
+    std::vector<float> x, y;
+    for (auto const& p : floatPointList)
+    {
+        x.push_back(p.x());
+        y.push_back(p.y());
+    }
+    REQUIRE(decompose(FloatPointView(x.data(), y.data(), x.size()), outer, holeList) == expected);
+
+    Decomposer decomposer;
+    std::vector<IndexList> result;
+    decomposer.decompose(FloatPointView(x.data(), y.data(), x.size()), outer, holeList, {}, result);
+    REQUIRE(result == expected);
+}
+
+TEST_CASE("winding and ear clipping work on views")
+{
+    std::vector<std::int32_t> x = { 0, 2, 2, 1, 0 };
+    std::vector<std::int32_t> y = { 0, 0, 2, 1, 2 };
+    FixedPointView pointList(x.data(), y.data(), x.size());
+
+    IndexList polygon = { 0, 1, 2, 3, 4 };
+    REQUIRE(computeWinding(pointList, polygon) == Winding::CounterClockwise);
+    REQUIRE(computeWinding(pointList, IndexList{ 4, 3, 2, 1, 0 }) == Winding::Clockwise);
+
+    IndexList triangleList;
+    earClipping(pointList, polygon, triangleList, newDeleteResource());
+    REQUIRE(triangleList.size() == 9);
+}
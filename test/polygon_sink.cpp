@@ -0,0 +1,155 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+using namespace decomp;
+
+namespace
+{
+
+void checkFlat(std::vector<IndexList> const& expected, FlatPolygonList const& flat)
+{
+    REQUIRE(flat.size() == expected.size());
+    REQUIRE(flat.offsetList.back() == flat.indexList.size());
+    for (std::size_t polygon = 0; polygon < expected.size(); ++polygon)
+    {
+        IndexList vertexList(flat.polygon(polygon), flat.polygon(polygon) + flat.size(polygon));
+        REQUIRE(vertexList == expected[polygon]);
+    }
+}
+
+} // namespace
+
+TEST_CASE("flat output matches the polygon list")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+
+    IntegerPointView view(pointList);
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone })
+    {
+        for (auto tier : { Tier::Fast, Tier::Quality })
+        {
+            DecomposeOptions options;
+            options.triangulator = triangulator;
+            options.tier = tier;
+            auto expected = decompose(view, outer, holeList, {}, options);
+
+            FlatPolygonList flat;
+            FlatPolygonSink sink(flat);
+            decompose(view, outer, holeList, {}, sink, options);
+            checkFlat(expected, flat);
+
+            FlatPolygonList convertedFlat;
+            FlatPolygonSink convertedSink(convertedFlat);
+            decompose(converted, outer, holeList, {}, convertedSink, options);
+            REQUIRE(convertedFlat.indexList == flat.indexList);
+            REQUIRE(convertedFlat.offsetList == flat.offsetList);
+        }
+    }
+}
+
+TEST_CASE("buffer sink writes into caller-provided buffers")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    IntegerPointView view(pointList);
+    auto expected = decompose(view, outer, holeList);
+
+    auto vertexCount = outer.size();
+    for (auto const& hole : holeList)
+        vertexCount += hole.size();
+
+    // Fast merges the fewest edges, and the bounds still need to hold for it
+    std::vector<std::uint16_t> indexBuffer(maxIndexCount(vertexCount, holeList.size()));
+    std::vector<std::uint32_t> offsetBuffer(maxPolygonCount(vertexCount, holeList.size()) + 1);
+    DecomposeOptions fast;
+    fast.tier = Tier::Fast;
+    BufferSink fastSink(indexBuffer.data(), indexBuffer.size(), offsetBuffer.data(), offsetBuffer.size());
+    decompose(view, outer, holeList, {}, fastSink, fast);
+    REQUIRE(fastSink.polygonCount() <= maxPolygonCount(vertexCount, holeList.size()));
+
+    BufferSink sink(indexBuffer.data(), indexBuffer.size(), offsetBuffer.data(), offsetBuffer.size());
+    decompose(view, outer, holeList, {}, sink);
+    REQUIRE(sink.polygonCount() == expected.size());
+    REQUIRE(offsetBuffer[0] == 0);
+    for (std::size_t polygon = 0; polygon < expected.size(); ++polygon)
+    {
+        IndexList vertexList(indexBuffer.begin() + offsetBuffer[polygon],
+                             indexBuffer.begin() + offsetBuffer[polygon + 1]);
+        REQUIRE(vertexList == expected[polygon]);
+    }
+    REQUIRE(offsetBuffer[expected.size()] == sink.indexCount());
+
+    BufferSink smallIndexSink(indexBuffer.data(), 10, offsetBuffer.data(), offsetBuffer.size());
+    REQUIRE_THROWS_AS(decompose(view, outer, holeList, {}, smallIndexSink), std::length_error);
+
+    BufferSink smallOffsetSink(indexBuffer.data(), indexBuffer.size(), offsetBuffer.data(), 2);
+    REQUIRE_THROWS_AS(decompose(view, outer, holeList, {}, smallOffsetSink), std::length_error);
+}
+
+TEST_CASE("iterator sink appends to output iterators")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    IntegerPointView view(pointList);
+    FlatPolygonList expected;
+    FlatPolygonSink expectedSink(expected);
+    decompose(view, outer, holeList, {}, expectedSink);
+
+    IndexList indexList;
+    std::vector<std::uint32_t> offsetList;
+    auto sink = makeIteratorSink<std::uint16_t>(std::back_inserter(indexList), std::back_inserter(offsetList));
+    decompose(view, outer, holeList, {}, sink);
+    REQUIRE(indexList == expected.indexList);
+    REQUIRE(offsetList == expected.offsetList);
+}
+
+TEST_CASE("decomposer writes to a sink without growing its scratch memory")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList);
+
+    IntegerPointView view(pointList);
+    auto expected = decompose(view, outer, holeList);
+
+    Decomposer decomposer;
+    FlatPolygonList flat;
+    PolygonAdjacency adjacency;
+    std::size_t capacity = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        FlatPolygonSink sink(flat);
+        decomposer.decompose(view, outer, holeList, {}, sink, adjacency);
+        checkFlat(expected, flat);
+
+        // The adjacency has the same offsets as the flat list
+        REQUIRE(adjacency.offsetList == flat.offsetList);
+
+        if (i == 0)
+            capacity = decomposer.scratchCapacity();
+        REQUIRE(decomposer.scratchCapacity() == capacity);
+    }
+
+    FlatPolygonList withoutAdjacency;
+    FlatPolygonSink sink(withoutAdjacency);
+    decomposer.decompose(view, outer, holeList, {}, sink);
+    REQUIRE(withoutAdjacency.indexList == flat.indexList);
+}
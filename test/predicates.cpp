@@ -0,0 +1,107 @@
+#include <catch2/catch.hpp>
+#include <decomp/predicates.hpp>
+
+using namespace decomp;
+
+namespace
+{
+
+int sign(double value)
+{
+    return (value > 0.0) - (value < 0.0);
+}
+
+} // namespace
+
+TEST_CASE("orient2d is exact for nearly collinear points")
+{
+    // Points on a grid of single ulps around the line y = x, where the naive determinant gets most signs wrong
+    auto const ulp = std::ldexp(1.0, -53);
+    Point b(12.0, 12.0), c(24.0, 24.0);
+    for (int i = 0; i < 256; ++i)
+    {
+        for (int j = 0; j < 256; ++j)
+        {
+            Point a(0.5 + i * ulp, 0.5 + j * ulp);
+            REQUIRE(sign(orient2d(a, b, c)) == sign(j - i));
+            REQUIRE(sign(orient2d(b, c, a)) == sign(j - i));
+            REQUIRE(sign(orient2d(a, c, b)) == sign(i - j));
+        }
+    }
+}
+
+TEST_CASE("orient2d decides simple cases")
+{
+    Point a(0.0, 0.0), b(1.0, 0.0), c(0.0, 1.0);
+    REQUIRE(orient2d(a, b, c) > 0.0);
+    REQUIRE(orient2d(a, c, b) < 0.0);
+    REQUIRE(orient2d(a, b, Point(3.0, 0.0)) == 0.0);
+    REQUIRE(orient2d(a, a, c) == 0.0);
+}
+
+TEST_CASE("incircle is exact for nearly cocircular points")
+{
+    // Moving d by single ulps across the circle through a, b and c
+    auto const ulp = std::ldexp(1.0, -52);
+    Point a(1.0, 0.0), b(0.0, 1.0), c(-1.0, 0.0);
+    REQUIRE(incircle(a, b, c, Point(0.0, -1.0)) == 0.0);
+    for (int i = 1; i < 64; ++i)
+    {
+        REQUIRE(incircle(a, b, c, Point(0.0, -1.0 + i * ulp)) > 0.0);
+        REQUIRE(incircle(a, b, c, Point(0.0, -1.0 - 2 * i * ulp)) < 0.0);
+    }
+
+    // Differences that are not exact in floating-point
+    Point e(0.1, 0.7), f(-0.3, 0.2), g(0.5, -0.6);
+    REQUIRE(incircle(e, f, g, Point(0.0, 0.0)) > 0.0);
+    REQUIRE(incircle(e, g, f, Point(0.0, 0.0)) < 0.0);
+    REQUIRE(incircle(e, f, g, e) == 0.0);
+}
+
+TEST_CASE("incircle in the integer mode")
+{
+    // Cocircular points with large coordinates, on a circle around the origin
+    std::int32_t const r = 5 * (1 << 26);
+    IntegerPoint a(r, 0), b(3 * (1 << 26), 4 * (1 << 26)), c(-r, 0), d(0, -r);
+    REQUIRE(incircle(a, b, c, d) == 0.0);
+    REQUIRE(incircle(a, b, c, IntegerPoint(0, -r + 1)) > 0.0);
+    REQUIRE(incircle(a, b, c, IntegerPoint(0, -r - 1)) < 0.0);
+}
+
+TEST_CASE("segmentsIntersect")
+{
+    Point a(0.0, 0.0), b(2.0, 2.0);
+
+    SECTION("with crossing segments")
+    {
+        REQUIRE(segmentsIntersect(a, b, Point(0.0, 2.0), Point(2.0, 0.0)));
+    }
+
+    SECTION("with touching segments")
+    {
+        REQUIRE(segmentsIntersect(a, b, Point(2.0, 2.0), Point(3.0, 0.0)));
+        REQUIRE(segmentsIntersect(a, b, Point(1.0, 1.0), Point(3.0, 0.0)));
+    }
+
+    SECTION("with disjoint segments")
+    {
+        REQUIRE(!segmentsIntersect(a, b, Point(0.0, 1.0), Point(-1.0, 2.0)));
+        REQUIRE(!segmentsIntersect(a, b, Point(3.0, 3.0), Point(4.0, 2.0)));
+    }
+
+    SECTION("with collinear segments")
+    {
+        REQUIRE(!segmentsIntersect(a, b, Point(1.0, 1.0), Point(3.0, 3.0)));
+        REQUIRE(!segmentsIntersect(a, b, Point(3.0, 3.0), Point(4.0, 4.0)));
+    }
+
+    SECTION("with a nearly collinear endpoint")
+    {
+        // The endpoint of cd is a single ulp away from ab, on either side
+        auto const ulp = std::ldexp(1.0, -53);
+        Point d(2.0, 0.0);
+        REQUIRE(segmentsIntersect(a, b, Point(0.5, 0.5 - ulp), Point(0.0, 2.0)));
+        REQUIRE(!segmentsIntersect(a, b, Point(0.5, 0.5 + ulp), Point(0.0, 2.0)));
+        REQUIRE(segmentsIntersect(a, b, Point(0.5, 0.5), d));
+    }
+}
@@ -14,3 +14,21 @@ TEST_CASE("Can remap indices and points")
     auto newPoints = remapper.mapped(points);
     REQUIRE(newPoints == PointList{{8.f, 8.f}, {23.f, 23.f}, {42.f, 42.f}});
 }
+
+TEST_CASE("Area and containment do not depend on the direction of the polygon")
+{
+    auto points = PointList{{0.0, 0.0}, {4.0, 0.0}, {4.0, 2.0}, {1.0, 3.0}};
+    IndexList counterClockwise = {0, 1, 2, 3};
+    IndexList clockwise = {3, 2, 1, 0};
+
+    REQUIRE(signedArea(points, counterClockwise) == 9.0);
+    REQUIRE(signedArea(points, clockwise) == -9.0);
+
+    for (auto const& polygon : {counterClockwise, clockwise})
+    {
+        REQUIRE(containsPoint(points, polygon, Point{2.0, 1.0}));
+        REQUIRE(containsPoint(points, polygon, Point{0.7, 1.9}));
+        REQUIRE(!containsPoint(points, polygon, Point{0.5, 1.9}));
+        REQUIRE(!containsPoint(points, polygon, Point{5.0, 1.0}));
+    }
+}
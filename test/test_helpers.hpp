@@ -0,0 +1,105 @@
+#ifndef LIB_DECOMP_TEST_HELPERS
+#define LIB_DECOMP_TEST_HELPERS
+
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <decomp/convex_decomposition.hpp>
+#include <decomp/operations.hpp>
+#include <decomp/predicates.hpp>
+
+// Fixtures and checks shared by the tests
+
+namespace decomp
+{
+
+// A star with the given number of points and a few triangular holes, so that there are many reflex vertices and
+// fans around them
+inline void makeStar(BasicPointList<std::int32_t>& pointList,
+                     IndexList& outer,
+                     std::vector<IndexList>& holeList,
+                     int pointCount = 120)
+{
+    for (int i = 0; i < pointCount; ++i)
+    {
+        double angle = 6.283185307179586 * i / pointCount;
+        double radius = (i % 2 == 0) ? 10000.0 : 6000.0;
+        pointList.emplace_back(static_cast<std::int32_t>(std::lround(radius * std::cos(angle))),
+                               static_cast<std::int32_t>(std::lround(radius * std::sin(angle))));
+        outer.push_back(static_cast<std::uint16_t>(i));
+    }
+
+    for (std::int32_t x = -2000; x < 2000; x += 1000)
+    {
+        auto first = static_cast<std::uint16_t>(pointList.size());
+        pointList.emplace_back(x, 0);
+        pointList.emplace_back(x + 500, 500);
+        pointList.emplace_back(x + 500, -500);
+        holeList.push_back({ first, std::uint16_t(first + 1), std::uint16_t(first + 2) });
+    }
+}
+
+// Same as above, scaled down to a radius of 10
+inline void makeStar(PointList& pointList, IndexList& outer, std::vector<IndexList>& holeList, int pointCount = 120)
+{
+    BasicPointList<std::int32_t> integerList;
+    makeStar(integerList, outer, holeList, pointCount);
+    for (auto const& p : integerList)
+        pointList.emplace_back(p.x() * 0.001, p.y() * 0.001);
+}
+
+// Twice the signed area, exact for coordinates within integerCoordinateLimit and small polygons
+inline std::int64_t doubleArea(BasicPointList<std::int32_t> const& pointList, IndexList const& polygon)
+{
+    std::int64_t result = 0;
+    for (std::size_t i = 0; i < polygon.size(); ++i)
+        result += orient2d(IntegerPoint(0, 0), pointList[polygon[i]], pointList[polygon[(i + 1) % polygon.size()]]);
+    return result;
+}
+
+inline bool isConvex(BasicPointList<std::int32_t> const& pointList, IndexList const& polygon)
+{
+    auto N = polygon.size();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        if (orient2d(pointList[polygon[i]], pointList[polygon[(i + 1) % N]], pointList[polygon[(i + 2) % N]]) < 0)
+            return false;
+    }
+    return true;
+}
+
+// Check that the polygons are convex and cover exactly the area of the polygon with holes
+inline void checkDecomposition(BasicPointList<std::int32_t> const& pointList,
+                               IndexList const& outer,
+                               std::vector<IndexList> const& holeList,
+                               std::vector<IndexList> const& result)
+{
+    auto expected = doubleArea(pointList, outer);
+    for (auto const& hole : holeList)
+        expected += doubleArea(pointList, hole);
+
+    std::int64_t total = 0;
+    for (auto const& polygon : result)
+    {
+        REQUIRE(isConvex(pointList, polygon));
+        total += doubleArea(pointList, polygon);
+    }
+    REQUIRE(total == expected);
+}
+
+// Convex up to rounding, for points that were computed in floating-point
+template <class Index> bool isConvex(PointList const& pointList, BasicIndexList<Index> const& polygon)
+{
+    auto const N = polygon.size();
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        auto u = pointList[polygon[(i + 1) % N]] - pointList[polygon[i]];
+        auto v = pointList[polygon[(i + 2) % N]] - pointList[polygon[(i + 1) % N]];
+        if (u.x() * v.y() - u.y() * v.x() < -1e-9)
+            return false;
+    }
+    return true;
+}
+
+} // namespace decomp
+
+#endif
@@ -0,0 +1,81 @@
+#include <catch2/catch.hpp>
+#include <decomp/decomposer.hpp>
+#include <decomp/predicates.hpp>
+#include "test_helpers.hpp"
+#include <cmath>
+
+using namespace decomp;
+
+TEST_CASE("fifo ear clipping covers the polygon")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList, 200);
+
+    IntegerPointView view(pointList);
+    IndexList simple, triangleList;
+    removeHoles(view, outer, holeList, simple, newDeleteResource());
+    earClipping(view, simple, triangleList, newDeleteResource(), EarOrder::Fifo);
+    REQUIRE(triangleList.size() == (simple.size() - 2) * 3);
+
+    std::int64_t total = 0;
+    for (std::size_t i = 0; i < triangleList.size(); i += 3)
+    {
+        IndexList triangle(triangleList.begin() + i, triangleList.begin() + i + 3);
+        auto area = doubleArea(pointList, triangle);
+        REQUIRE(area >= 0);
+        total += area;
+    }
+    REQUIRE(total == doubleArea(pointList, simple));
+}
+
+TEST_CASE("linear merge keeps fixed edges")
+{
+    // A square split into two triangles along a fixed diagonal
+    PointList pointList = { { 0.0, 0.0 }, { 1.0, 0.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+    IndexList triangleList = { 0, 1, 2, 0, 2, 3 };
+
+    std::vector<IndexList> result;
+    auto mesh = buildHalfEdgeGraph(triangleList, {});
+    hertelMehlhorn(pointList, mesh, result, newDeleteResource(), MergeOrder::Linear);
+    REQUIRE(result.size() == 1);
+    REQUIRE(result.front().size() == 4);
+
+    mesh = buildHalfEdgeGraph(triangleList, { { 0, 2 } });
+    hertelMehlhorn(pointList, mesh, result, newDeleteResource(), MergeOrder::Linear);
+    REQUIRE(result.size() == 2);
+}
+
+TEST_CASE("all tiers decompose into convex polygons")
+{
+    BasicPointList<std::int32_t> pointList;
+    IndexList outer;
+    std::vector<IndexList> holeList;
+    makeStar(pointList, outer, holeList, 200);
+
+    PointList converted;
+    for (auto const& point : pointList)
+        converted.emplace_back(point.x(), point.y());
+
+    IntegerPointView view(pointList);
+    Decomposer decomposer;
+    for (auto triangulator : { Triangulator::EarClipping, Triangulator::Monotone, Triangulator::ConstrainedDelaunay })
+    {
+        for (auto tier : { Tier::Fast, Tier::Balanced, Tier::Quality })
+        {
+            DecomposeOptions options;
+            options.triangulator = triangulator;
+            options.tier = tier;
+
+            auto result = decompose(view, outer, holeList, {}, options);
+            checkDecomposition(pointList, outer, holeList, result);
+
+            std::vector<IndexList> decomposerResult;
+            decomposer.decompose(view, outer, holeList, {}, decomposerResult, options);
+            REQUIRE(decomposerResult == result);
+
+            checkDecomposition(pointList, outer, holeList, decompose(converted, outer, holeList, {}, options));
+        }
+    }
+}
@@ -0,0 +1,178 @@
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <decomp/tiling.hpp>
+#include "test_helpers.hpp"
+#include <set>
+
+using namespace decomp;
+
+namespace
+{
+
+// Checks that all polygons are convex and have an area, and returns their total area
+double checkedArea(TiledDecomposition const& tiling)
+{
+    double total = 0.0;
+    for (auto const& polygon : tiling.polygonList())
+    {
+        REQUIRE(isConvex(tiling.pointList(), polygon));
+        auto area = signedArea(tiling.pointList(), polygon);
+        REQUIRE(area > 0.0);
+        total += area;
+    }
+    return total;
+}
+
+double portalLength(TiledDecomposition const& tiling)
+{
+    double total = 0.0;
+    for (auto const& portal : tiling.portalList())
+        total += std::sqrt(squared(portal.to - portal.from));
+    return total;
+}
+
+PointList squareWithHole()
+{
+    return { { 0.0, 0.0 }, { 10.0, 0.0 }, { 10.0, 10.0 }, { 0.0, 10.0 },
+             { 4.0, 4.0 }, { 4.0, 6.0 },  { 6.0, 6.0 },   { 6.0, 4.0 } };
+}
+
+} // namespace
+
+TEST_CASE("tiling cuts a polygon with a hole along the tile borders")
+{
+    auto pointList = squareWithHole();
+    TiledDecomposition tiling(Point(0.0, 0.0), 5.0, 2, 2);
+    tiling.build(pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } }, 1);
+
+    REQUIRE(checkedArea(tiling) == Approx(96.0));
+
+    // Each tile has its own polygons
+    std::set<std::uint32_t> tileSet(tiling.polygonTileList().begin(), tiling.polygonTileList().end());
+    REQUIRE(tileSet.size() == 4);
+
+    // Points on the borders are merged
+    std::set<std::pair<double, double>> positionSet;
+    for (auto const& p : tiling.pointList())
+        positionSet.emplace(p.x(), p.y());
+    REQUIRE(positionSet.size() == tiling.pointList().size());
+
+    // Both borders are open everywhere but at the hole
+    REQUIRE(portalLength(tiling) == Approx(16.0));
+    for (auto const& portal : tiling.portalList())
+    {
+        REQUIRE(tiling.polygonTileList()[portal.polygon] != tiling.polygonTileList()[portal.neighbor]);
+        auto const& polygon = tiling.polygonList()[portal.polygon];
+        auto const& a = tiling.pointList()[polygon[portal.side]];
+        auto const& b = tiling.pointList()[polygon[(portal.side + 1) % polygon.size()]];
+        REQUIRE((a.x() == 5.0 && b.x() == 5.0 || a.y() == 5.0 && b.y() == 5.0));
+    }
+}
+
+TEST_CASE("tiling handles points and edges on the tile borders")
+{
+    TiledDecomposition tiling(Point(0.0, 0.0), 5.0, 2, 2);
+
+    PointList diamond = { { 5.0, 0.0 }, { 10.0, 5.0 }, { 5.0, 10.0 }, { 0.0, 5.0 } };
+    tiling.build(diamond, { 0, 1, 2, 3 }, {}, 1);
+    REQUIRE(checkedArea(tiling) == Approx(50.0));
+    REQUIRE(portalLength(tiling) == Approx(20.0));
+
+    // The right edge is on a border, so the tiles right of it stay empty
+    PointList strip = { { 0.0, 0.0 }, { 5.0, 0.0 }, { 5.0, 10.0 }, { 0.0, 10.0 } };
+    tiling.build(strip, { 0, 1, 2, 3 }, {}, 1);
+    REQUIRE(checkedArea(tiling) == Approx(50.0));
+    REQUIRE(portalLength(tiling) == Approx(5.0));
+    for (auto tile : tiling.polygonTileList())
+        REQUIRE(tile % 2 == 0);
+
+    // The hole's edges are on the borders
+    auto pointList = squareWithHole();
+    TiledDecomposition fine(Point(0.0, 0.0), 2.0, 5, 5);
+    fine.build(pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } }, 1);
+    REQUIRE(checkedArea(fine) == Approx(96.0));
+    REQUIRE(portalLength(fine) == Approx(72.0));
+
+    // Touching a border from one side
+    PointList notch = { { 1.0, 1.0 }, { 5.0, 2.5 }, { 1.0, 4.0 } };
+    tiling.build(notch, { 0, 1, 2 }, {}, 1);
+    REQUIRE(checkedArea(tiling) == Approx(6.0));
+    REQUIRE(tiling.portalList().empty());
+}
+
+TEST_CASE("tiling fills tiles inside the polygon")
+{
+    PointList pointList = { { 0.0, 0.0 },   { 30.0, 0.0 },  { 30.0, 30.0 }, { 0.0, 30.0 },
+                            { 12.0, 12.0 }, { 12.0, 18.0 }, { 18.0, 18.0 }, { 18.0, 12.0 } };
+    TiledDecomposition tiling(Point(0.0, 0.0), 10.0, 3, 3);
+    tiling.build(pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } }, 1);
+
+    REQUIRE(checkedArea(tiling) == Approx(864.0));
+    REQUIRE(portalLength(tiling) == Approx(120.0));
+}
+
+TEST_CASE("tiling can rebuild a single tile")
+{
+    auto pointList = squareWithHole();
+    TiledDecomposition tiling(Point(0.0, 0.0), 5.0, 2, 2);
+    tiling.build(pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } }, 1);
+    auto const polygonList = tiling.polygonList();
+
+    tiling.rebuildTile(1, 0, pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } });
+    REQUIRE(tiling.polygonList() == polygonList);
+
+    // Without the hole, only the rebuilt tile gets the missing area back
+    tiling.rebuildTile(1, 0, pointList, { 0, 1, 2, 3 }, {});
+    REQUIRE(checkedArea(tiling) == Approx(97.0));
+    REQUIRE(portalLength(tiling) == Approx(16.0));
+}
+
+TEST_CASE("tiling gives the same result on multiple threads")
+{
+    PointList pointList;
+    IndexList32 outer;
+    int const N = 400;
+    for (int i = 0; i < N; ++i)
+    {
+        double angle = 2.0 * 3.14159265358979323846 * i / N;
+        double radius = (i % 2 == 0) ? 100.0 : 70.0;
+        outer.push_back(static_cast<std::uint32_t>(pointList.size()));
+        pointList.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    IndexList32 hole;
+    for (auto const& corner : { Point(-15.0, 15.0), Point(15.0, 15.0), Point(15.0, -15.0), Point(-15.0, -15.0) })
+    {
+        hole.push_back(static_cast<std::uint32_t>(pointList.size()));
+        pointList.push_back(corner);
+    }
+
+    TiledDecomposition sequential(Point(-100.0, -100.0), 25.0, 8, 8);
+    sequential.build(pointList, outer, { hole }, 1);
+    TiledDecomposition parallel(Point(-100.0, -100.0), 25.0, 8, 8);
+    parallel.build(pointList, outer, { hole }, 4);
+
+    REQUIRE(parallel.polygonList() == sequential.polygonList());
+    REQUIRE(parallel.pointList() == sequential.pointList());
+    REQUIRE(parallel.portalList().size() == sequential.portalList().size());
+
+    double expected = signedArea(pointList, outer) + signedArea(pointList, hole);
+    REQUIRE(checkedArea(parallel) == Approx(expected));
+}
+
+TEST_CASE("tiling decomposes all tiles with the given options")
+{
+    auto pointList = squareWithHole();
+    DecomposeOptions options;
+    options.triangulator = Triangulator::Monotone;
+    options.tier = Tier::Fast;
+
+    TiledDecomposition tiling(Point(0.0, 0.0), 5.0, 2, 2, options);
+    tiling.build(pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } }, 1);
+    REQUIRE(checkedArea(tiling) == Approx(96.0));
+    auto const polygonList = tiling.polygonList();
+
+    // A rebuilt tile uses the same options, so it comes out the same
+    tiling.rebuildTile(0, 1, pointList, { 0, 1, 2, 3 }, { { 4, 5, 6, 7 } });
+    REQUIRE(tiling.polygonList() == polygonList);
+}